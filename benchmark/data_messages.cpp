@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <quicr/detail/messages.h>
+#include <quicr/detail/stream_buffer.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using quicr::Bytes;
+
+/**
+ * @brief Chunks of the encoded bytes, split after the first split bytes when split is non-zero
+ *
+ * @details Splitting the header across chunks forces decoding from the stream buffer instead of the
+ *      contiguous fast path, which gives the baseline to compare against.
+ */
+static std::vector<std::shared_ptr<const Bytes>>
+SplitChunks(const Bytes& encoded, std::size_t split)
+{
+    if (split == 0) {
+        return { std::make_shared<const Bytes>(encoded) };
+    }
+
+    return { std::make_shared<const Bytes>(encoded.begin(), encoded.begin() + split),
+             std::make_shared<const Bytes>(encoded.begin() + split, encoded.end()) };
+}
+
+/*
+ * Decode a subgroup object with large header fields, range(0) is where the header is split, zero for contiguous.
+ */
+static void
+Messages_DecodeStreamSubGroupObject(benchmark::State& state)
+{
+    quicr::messages::StreamSubGroupObject object{};
+    object.object_id = 0x3FFF'FFFF;
+    object.serialize_extensions = true;
+    object.extensions = quicr::Extensions{ { 0x2, Bytes{ 0x1, 0x2, 0, 0, 0, 0, 0, 0 } }, { 0x3, Bytes(16, 0x2) } };
+    object.payload.assign(100, 0xA5);
+
+    Bytes encoded;
+    encoded << object;
+
+    const auto chunks = SplitChunks(encoded, static_cast<std::size_t>(state.range(0)));
+
+    for ([[maybe_unused]] const auto& _ : state) {
+        quicr::StreamBuffer<std::uint8_t> buffer;
+        quicr::messages::StreamSubGroupObject out{};
+        out.serialize_extensions = true;
+        out.view_payload = true;
+
+        for (const auto& chunk : chunks) {
+            buffer.Push(chunk);
+        }
+
+        benchmark::DoNotOptimize(buffer >> out);
+        benchmark::DoNotOptimize(out.payload_view.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(encoded.size()));
+}
+
+/*
+ * Decode an object datagram with large header fields, range(0) is where the header is split, zero for contiguous.
+ */
+static void
+Messages_DecodeObjectDatagram(benchmark::State& state)
+{
+    quicr::messages::ObjectDatagram datagram{};
+    datagram.track_alias = 0x3FFF'FFFF'FFFF'FFFF;
+    datagram.group_id = 0x3FFF'FFFF;
+    datagram.object_id = 0x3FFF;
+    datagram.priority = 0xA;
+    datagram.extensions = quicr::Extensions{ { 0x2, Bytes{ 0x1, 0x2, 0, 0, 0, 0, 0, 0 } }, { 0x3, Bytes(16, 0x2) } };
+    datagram.payload.assign(100, 0xA5);
+
+    Bytes encoded;
+    encoded << datagram;
+    encoded.erase(encoded.begin()); // Type is parsed by the caller
+
+    const auto chunks = SplitChunks(encoded, static_cast<std::size_t>(state.range(0)));
+
+    for ([[maybe_unused]] const auto& _ : state) {
+        quicr::StreamBuffer<std::uint8_t> buffer;
+        quicr::messages::ObjectDatagram out{};
+        out.view_payload = true;
+
+        for (const auto& chunk : chunks) {
+            buffer.Push(chunk);
+        }
+
+        benchmark::DoNotOptimize(buffer >> out);
+        benchmark::DoNotOptimize(out.payload_view.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(encoded.size()));
+}
+
+BENCHMARK(Messages_DecodeStreamSubGroupObject)->Arg(0)->Arg(1);
+BENCHMARK(Messages_DecodeObjectDatagram)->Arg(0)->Arg(1);
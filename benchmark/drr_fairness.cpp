@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "transport_picoquic.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <deque>
+#include <numeric>
+#include <vector>
+
+/*
+ * Tracks of the same priority on one connection that always have data to send, joining one after another.
+ * Models picoquic serving streams of the same priority first come first served, each packet is filled from
+ * the first active stream. With a round robin quantum, a stream that used its turn is inactive until the
+ * next packet loop iteration marks it active again, which puts it behind the other streams.
+ *
+ * Counters report the spread of bytes sent per track once all tracks joined, (max - min) / mean, the
+ * share of the track that sent the least compared to the mean, and the share of the packet capacity used.
+ * A quantum smaller than a loop iteration of packets leaves capacity unused when all streams wait for
+ * their turn.
+ */
+
+using DataContext = quicr::PicoQuicTransport::DataContext;
+
+constexpr std::size_t kPacketSize = 1200;
+constexpr std::size_t kPacketsPerLoop = 10;   /// Packets prepared per packet loop iteration
+constexpr std::size_t kJoinLoops = 20;        /// Loop iterations between tracks joining
+constexpr std::size_t kMeasureLoops = 10'000; /// Loop iterations measured after the last track joined
+
+static void
+DrrFairness_SamePriority(benchmark::State& state)
+{
+    const auto tracks = static_cast<std::size_t>(state.range(0));
+    const auto quantum = static_cast<uint32_t>(state.range(1));
+    const auto join_loops = tracks * kJoinLoops;
+
+    std::vector<uint64_t> sent(tracks);
+
+    for (auto _ : state) {
+        std::vector<DataContext> contexts(tracks);
+        for (auto& data_ctx : contexts) {
+            data_ctx.tx_quantum = quantum;
+        }
+
+        std::deque<std::size_t> active;   /// Active streams in the order they are served
+        std::vector<std::size_t> yielded; /// Streams that used their turn, marked active on the next loop
+        std::fill(sent.begin(), sent.end(), 0);
+
+        for (std::size_t loop = 0; loop < join_loops + kMeasureLoops; ++loop) {
+            if (loop % kJoinLoops == 0 && loop < join_loops) {
+                active.push_back(loop / kJoinLoops);
+            }
+
+            for (std::size_t packet = 0; packet < kPacketsPerLoop && !active.empty(); ++packet) {
+                std::size_t remaining = kPacketSize;
+
+                while (remaining != 0 && !active.empty()) {
+                    const auto track = active.front();
+                    auto& data_ctx = contexts[track];
+
+                    const auto len = data_ctx.TxAllowance(remaining);
+                    remaining -= len;
+
+                    if (loop >= join_loops) {
+                        sent[track] += len;
+                    }
+
+                    if (data_ctx.TxConsume(len)) {
+                        active.pop_front();
+                        yielded.push_back(track);
+                    }
+                }
+            }
+
+            active.insert(active.end(), yielded.begin(), yielded.end());
+            yielded.clear();
+        }
+
+        benchmark::DoNotOptimize(sent.data());
+    }
+
+    const auto [min_it, max_it] = std::minmax_element(sent.begin(), sent.end());
+    const auto total = static_cast<double>(std::accumulate(sent.begin(), sent.end(), uint64_t{ 0 }));
+    const auto mean = total / static_cast<double>(tracks);
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>((join_loops + kMeasureLoops) * kPacketsPerLoop));
+    state.counters["spread"] = static_cast<double>(*max_it - *min_it) / mean;
+    state.counters["min_share"] = static_cast<double>(*min_it) / mean;
+    state.counters["utilization"] = total / static_cast<double>(kMeasureLoops * kPacketsPerLoop * kPacketSize);
+}
+
+BENCHMARK(DrrFairness_SamePriority)
+  ->ArgsProduct({ { 4, 50 }, { 0, 1200, 16'384 } })
+  ->ArgNames({ "tracks", "quantum" })
+  ->Unit(benchmark::kMillisecond);
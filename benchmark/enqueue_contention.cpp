@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <quicr/detail/epoch_ptr.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*
+ * Models the connection lookup and locking done by PicoQuicTransport::Enqueue. Each publisher thread
+ * enqueues objects to its own connection and data context, which is the common case for a relay
+ * fanning out to many subscribers.
+ */
+
+constexpr uint64_t kConnections = 64;
+constexpr uint64_t kDataContexts = 16;
+
+struct DataContext
+{
+    uint64_t enqueued_objs{ 0 };
+    std::vector<std::shared_ptr<const std::vector<uint8_t>>> tx_data;
+};
+
+struct Connection
+{
+    std::mutex mutex;
+    std::map<uint64_t, DataContext> data_contexts;
+
+    Connection()
+    {
+        for (uint64_t i = 0; i < kDataContexts; ++i) {
+            data_contexts[i].tx_data.reserve(64);
+        }
+    }
+};
+
+using ConnectionTable = std::map<uint64_t, std::shared_ptr<Connection>>;
+
+static const auto kObject = std::make_shared<const std::vector<uint8_t>>(1000, 0);
+
+static void
+EnqueueObject(Connection& conn, uint64_t data_ctx_id)
+{
+    auto& data_ctx = conn.data_contexts[data_ctx_id];
+    data_ctx.enqueued_objs++;
+    data_ctx.tx_data.push_back(kObject);
+
+    // Keep memory bounded, the packet loop would have sent these
+    if (data_ctx.tx_data.size() >= 64) {
+        data_ctx.tx_data.clear();
+    }
+}
+
+static ConnectionTable
+MakeConnectionTable()
+{
+    ConnectionTable table;
+    for (uint64_t i = 0; i < kConnections; ++i) {
+        table.emplace(i, std::make_shared<Connection>());
+    }
+    return table;
+}
+
+static void
+Enqueue_GlobalMutex(benchmark::State& state)
+{
+    static std::mutex state_mutex;
+    static ConnectionTable conn_table = MakeConnectionTable();
+
+    const uint64_t conn_id = static_cast<uint64_t>(state.thread_index()) % kConnections;
+    uint64_t data_ctx_id = 0;
+
+    for (auto _ : state) {
+        std::lock_guard<std::mutex> lock(state_mutex);
+
+        const auto conn_it = conn_table.find(conn_id);
+        EnqueueObject(*conn_it->second, data_ctx_id++ % kDataContexts);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+static void
+Enqueue_EpochPerConnection(benchmark::State& state)
+{
+    static quicr::EpochPtr<ConnectionTable> conn_table(std::make_unique<ConnectionTable>(MakeConnectionTable()));
+
+    const uint64_t conn_id = static_cast<uint64_t>(state.thread_index()) % kConnections;
+    uint64_t data_ctx_id = 0;
+
+    for (auto _ : state) {
+        const auto table = conn_table.Read();
+
+        const auto conn_it = table->find(conn_id);
+        auto& conn = *conn_it->second;
+        std::lock_guard<std::mutex> lock(conn.mutex);
+
+        EnqueueObject(conn, data_ctx_id++ % kDataContexts);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+BENCHMARK(Enqueue_GlobalMutex)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(Enqueue_EpochPerConnection)->ThreadRange(1, 16)->UseRealTime();
@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <quicr/detail/flat_hash_map.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Looks up random keys in tables of connection sized entries, like the per object lookups of connection
+ * and data context by ID. Keys have the shard index in the upper bits like connection IDs.
+ */
+
+struct Entry
+{
+    uint64_t id{ 0 };
+    std::shared_ptr<int> ctx;
+};
+
+static std::vector<uint64_t>
+MakeKeys(std::size_t count)
+{
+    std::mt19937_64 rng(1);
+    std::vector<uint64_t> keys;
+    keys.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i) {
+        keys.push_back((i % 4) << 56 | (rng() & 0xFFFF'FFFF'FFFF));
+    }
+
+    return keys;
+}
+
+template<typename Map>
+static void
+Lookup(benchmark::State& state)
+{
+    const auto keys = MakeKeys(static_cast<std::size_t>(state.range(0)));
+
+    Map map;
+    for (const auto key : keys) {
+        map.emplace(key, Entry{ key, nullptr });
+    }
+
+    // Random lookup order so that the table does not stay in cache at large sizes
+    auto lookups = keys;
+    std::shuffle(lookups.begin(), lookups.end(), std::mt19937_64(2));
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        auto it = map.find(lookups[i]);
+        benchmark::DoNotOptimize(it->second.id);
+
+        if (++i == lookups.size()) {
+            i = 0;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+template<typename Map>
+static void
+InsertErase(benchmark::State& state)
+{
+    const auto keys = MakeKeys(static_cast<std::size_t>(state.range(0)));
+
+    Map map;
+    for (const auto key : keys) {
+        map.emplace(key, Entry{ key, nullptr });
+    }
+
+    // Churn one entry at a time, like connections and streams opening and closing
+    std::size_t i = 0;
+    for (auto _ : state) {
+        map.erase(keys[i]);
+        map.emplace(keys[i], Entry{ keys[i], nullptr });
+
+        if (++i == keys.size()) {
+            i = 0;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(Lookup<std::map<uint64_t, Entry>>)->Arg(10)->Arg(1000)->Arg(100'000);
+BENCHMARK(Lookup<std::unordered_map<uint64_t, Entry>>)->Arg(10)->Arg(1000)->Arg(100'000);
+BENCHMARK(Lookup<quicr::FlatHashMap<uint64_t, Entry>>)->Arg(10)->Arg(1000)->Arg(100'000);
+BENCHMARK(Lookup<quicr::FlatHashMap<uint64_t, Entry, true>>)->Arg(10)->Arg(1000)->Arg(100'000);
+
+BENCHMARK(InsertErase<std::map<uint64_t, Entry>>)->Arg(10)->Arg(1000)->Arg(100'000);
+BENCHMARK(InsertErase<quicr::FlatHashMap<uint64_t, Entry>>)->Arg(10)->Arg(1000)->Arg(100'000);
+BENCHMARK(InsertErase<quicr::FlatHashMap<uint64_t, Entry, true>>)->Arg(10)->Arg(1000)->Arg(100'000);
@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <quicr/detail/loop_wakeup.h>
+#include <quicr/detail/task_queue.h>
+
+#include <benchmark/benchmark.h>
+
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <thread>
+#include <utility>
+
+/*
+ * Models the packet loop waiting on its UDP socket while another thread queues work for it, like Enqueue
+ * queueing MarkStreamActive. The polling loop wakes up every 500us to run queued work, the event loop
+ * blocks until the wakeup is signaled or the idle max delay passes.
+ */
+
+constexpr int64_t kPollDelayUs = 500;
+constexpr int64_t kIdleMaxDelayUs = 50'000;
+
+class PacketLoop
+{
+  public:
+    explicit PacketLoop(bool event_wakeup)
+      : event_wakeup_(event_wakeup)
+      , fd_(socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP))
+      , thread_([this] { Run(); })
+    {
+    }
+
+    ~PacketLoop()
+    {
+        stop_ = true;
+        wakeup_.Signal();
+        thread_.join();
+        close(fd_);
+    }
+
+    template<typename F>
+    void Queue(F&& fn)
+    {
+        queue_.Push(std::forward<F>(fn));
+        if (event_wakeup_) {
+            wakeup_.Signal();
+        }
+    }
+
+    uint64_t Wakeups() const noexcept { return wakeups_; }
+    double CpuSeconds() const noexcept { return cpu_seconds_; }
+
+  private:
+    void Run()
+    {
+        while (!stop_) {
+            queue_.RunAll();
+
+            int64_t delay_us = kPollDelayUs;
+            if (event_wakeup_) {
+                delay_us = kIdleMaxDelayUs;
+                wakeup_.Arm();
+                if (!queue_.Empty()) {
+                    delay_us = 0;
+                }
+            }
+
+            // Waits the same way as the socket packet loop, select is available on all platforms
+            fd_set read_fds;
+            FD_ZERO(&read_fds);
+            FD_SET(fd_, &read_fds);
+            if (event_wakeup_) {
+                FD_SET(wakeup_.Fd(), &read_fds);
+            }
+
+            timeval timeout{ .tv_sec = 0, .tv_usec = static_cast<suseconds_t>(delay_us) };
+            select(std::max(fd_, wakeup_.Fd()) + 1, &read_fds, nullptr, nullptr, &timeout);
+            wakeup_.Disarm();
+            wakeups_++;
+
+            timespec ts;
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+            cpu_seconds_ = static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1e9;
+        }
+    }
+
+    const bool event_wakeup_;
+    const int fd_;
+    quicr::TaskQueue<> queue_;
+    quicr::LoopWakeup wakeup_;
+    std::atomic<bool> stop_{ false };
+    std::atomic<uint64_t> wakeups_{ 0 };
+    std::atomic<double> cpu_seconds_{ 0 };
+    std::thread thread_;
+};
+
+static void
+PacketLoop_EnqueueLatency(benchmark::State& state)
+{
+    PacketLoop loop(state.range(0) != 0);
+
+    for (auto _ : state) {
+        std::atomic<bool> ran{ false };
+        const auto start = std::chrono::steady_clock::now();
+
+        loop.Queue([&ran] { ran.store(true, std::memory_order_release); });
+
+        while (!ran.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+        }
+
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        state.SetIterationTime(std::chrono::duration<double>(elapsed).count());
+    }
+}
+
+static void
+PacketLoop_Idle(benchmark::State& state)
+{
+    constexpr auto kIdleTime = std::chrono::milliseconds(200);
+
+    PacketLoop loop(state.range(0) != 0);
+    uint64_t wakeups = 0;
+    double cpu_seconds = 0;
+
+    for (auto _ : state) {
+        const auto start_wakeups = loop.Wakeups();
+        const auto start_cpu = loop.CpuSeconds();
+
+        std::this_thread::sleep_for(kIdleTime);
+
+        wakeups += loop.Wakeups() - start_wakeups;
+        cpu_seconds += loop.CpuSeconds() - start_cpu;
+    }
+
+    const double idle_seconds = std::chrono::duration<double>(kIdleTime).count() * state.iterations();
+    state.counters["wakeups_per_s"] = wakeups / idle_seconds;
+    state.counters["idle_cpu_pct"] = 100 * cpu_seconds / idle_seconds;
+}
+
+BENCHMARK(PacketLoop_EnqueueLatency)->Arg(0)->Arg(1)->ArgName("event_wakeup")->UseManualTime();
+BENCHMARK(PacketLoop_Idle)->Arg(0)->Arg(1)->ArgName("event_wakeup")->Iterations(5)->UseRealTime();
@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <quicr/detail/priority_queue.h>
+#include <quicr/detail/quic_transport.h>
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/*
+ * Mixed priority traffic through the transmit queue of a data context. Each burst pushes objects
+ * spread over the given number of priorities, then drains them the way SendStreamBytes does,
+ * checking Empty() and Size() on each pass.
+ */
+
+static auto service = std::make_shared<quicr::ThreadedTickService>();
+static const auto kObject = std::make_shared<const std::vector<uint8_t>>(1000, 0);
+
+constexpr std::size_t kBurstObjects = 64;
+
+static void
+PriorityQueue_MixedPriority(benchmark::State& state)
+{
+    const auto priorities = static_cast<std::size_t>(state.range(0));
+    quicr::PriorityQueue<quicr::ConnData> pq(2000, 1, service, 64);
+    quicr::TimeQueueElement<quicr::ConnData> elem;
+
+    // Priorities spread over the full range, like a mix of control, audio and video tracks
+    std::array<uint8_t, kBurstObjects> burst_priorities;
+    for (std::size_t i = 0; i < kBurstObjects; ++i) {
+        burst_priorities[i] = static_cast<uint8_t>((i % priorities) * (32 / priorities));
+    }
+
+    int64_t items_count = 0;
+    for (auto _ : state) {
+        for (const auto priority : burst_priorities) {
+            quicr::ConnData data{ 1, 1, priority, quicr::StreamAction::kNoAction, kObject, 0, nullptr };
+            pq.Push(std::move(data), 1000, priority);
+        }
+
+        while (!pq.Empty()) {
+            benchmark::DoNotOptimize(pq.Size());
+            pq.PopFront(elem);
+            benchmark::DoNotOptimize(elem);
+        }
+
+        items_count += kBurstObjects;
+    }
+
+    state.SetItemsProcessed(items_count);
+}
+
+/*
+ * Enqueue and send of one object, copying it through Push() and Front() like the datagram path did,
+ * or constructing it in place and reading it by reference or moving it out.
+ */
+static void
+PriorityQueue_CopyPath(benchmark::State& state)
+{
+    quicr::PriorityQueue<quicr::ConnData> pq(2000, 1, service, 64);
+    quicr::TimeQueueElement<quicr::ConnData> elem;
+
+    for (auto _ : state) {
+        quicr::ConnData data{ 1, 1, 0, quicr::StreamAction::kNoAction, kObject, 0, kObject };
+        pq.Push(data, 1000, 0);
+
+        pq.Front(elem);
+        benchmark::DoNotOptimize(elem.value.data->data());
+        pq.Pop();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void
+PriorityQueue_MovePath(benchmark::State& state)
+{
+    quicr::PriorityQueue<quicr::ConnData> pq(2000, 1, service, 64);
+    quicr::ConnData out;
+    uint32_t expired_count = 0;
+    const bool peek = state.range(0) != 0;
+
+    for (auto _ : state) {
+        auto data = kObject;
+        auto payload = kObject;
+        pq.Emplace(1000, 0, 0, 1, 1, 0, quicr::StreamAction::kNoAction, std::move(data), 0, std::move(payload));
+
+        if (peek) {
+            benchmark::DoNotOptimize(pq.PeekRef(expired_count)->data->data());
+            pq.Pop();
+        } else {
+            pq.TryPopInto(out, expired_count);
+            benchmark::DoNotOptimize(out.data->data());
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(PriorityQueue_CopyPath);
+BENCHMARK(PriorityQueue_MovePath)->Arg(0)->Arg(1)->ArgName("peek");
+BENCHMARK(PriorityQueue_MixedPriority)->Arg(1)->Arg(4)->Arg(32)->ArgName("priorities");
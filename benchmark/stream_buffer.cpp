@@ -1,12 +1,18 @@
 // SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
 // SPDX-License-Identifier: BSD-2-Clause
 
+#include <quicr/detail/messages.h>
 #include <quicr/detail/stream_buffer.h>
 
 #include <benchmark/benchmark.h>
 
 #include <cstdint>
 #include <limits>
+#include <memory>
+#include <vector>
+
+constexpr std::size_t kStreamChunkSize = 1200;  /// Bytes per chunk received from the stream
+constexpr std::size_t kStreamBytes = 1'000'000; /// Bytes of objects on the stream
 
 static void
 StreamBuffer_Construct(benchmark::State& state)
@@ -63,6 +69,114 @@ StreamBuffer_Front(benchmark::State& state)
     }
 }
 
+/**
+ * @brief Stream of subgroup objects of the payload size, split into the chunks received from the stream
+ */
+static std::vector<std::shared_ptr<const std::vector<uint8_t>>>
+MakeObjectStream(std::size_t payload_size)
+{
+    std::vector<uint8_t> stream;
+
+    quicr::messages::StreamSubGroupObject object{};
+    object.serialize_extensions = false;
+    object.payload.assign(payload_size, 0xA5);
+
+    for (std::size_t i = 0; stream.size() < kStreamBytes; ++i) {
+        object.object_id = i;
+        stream << object;
+    }
+
+    std::vector<std::shared_ptr<const std::vector<uint8_t>>> chunks;
+    for (std::size_t offset = 0; offset < stream.size(); offset += kStreamChunkSize) {
+        const auto end = std::min(offset + kStreamChunkSize, stream.size());
+        chunks.push_back(std::make_shared<const std::vector<uint8_t>>(stream.begin() + offset, stream.begin() + end));
+    }
+
+    return chunks;
+}
+
+/*
+ * Parse subgroup objects as SubscribeTrackHandler::StreamDataRecv() does, each received chunk is pushed and
+ * parsed until no complete object is left.
+ */
+static void
+StreamBuffer_ParseObjects(benchmark::State& state)
+{
+    const auto chunks = MakeObjectStream(static_cast<std::size_t>(state.range(0)));
+    std::size_t objects = 0;
+
+    for ([[maybe_unused]] const auto& _ : state) {
+        quicr::StreamBuffer<std::uint8_t> buffer;
+        quicr::messages::StreamSubGroupObject object{};
+        object.serialize_extensions = false;
+
+        for (const auto& chunk : chunks) {
+            buffer.Push(chunk);
+
+            while (buffer >> object) {
+                benchmark::DoNotOptimize(object.payload.data());
+                object = {};
+                object.serialize_extensions = false;
+                ++objects;
+            }
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(chunks.size() * kStreamChunkSize));
+    state.SetItemsProcessed(static_cast<int64_t>(objects));
+}
+
+/*
+ * Parse subgroup objects with the payload returned as a view of the received chunks instead of a copy.
+ */
+static void
+StreamBuffer_ParseObjectViews(benchmark::State& state)
+{
+    const auto chunks = MakeObjectStream(static_cast<std::size_t>(state.range(0)));
+    std::size_t objects = 0;
+
+    for ([[maybe_unused]] const auto& _ : state) {
+        quicr::StreamBuffer<std::uint8_t> buffer;
+        std::size_t fields = 0; /// Fields of the object parsed
+        uint64_t payload_len = 0;
+
+        for (const auto& chunk : chunks) {
+            buffer.Push(chunk);
+
+            while (true) {
+                if (fields == 0) {
+                    if (!buffer.DecodeUintV()) {
+                        break;
+                    }
+                    fields++;
+                }
+
+                if (fields == 1) {
+                    const auto len = buffer.DecodeUintV();
+                    if (!len) {
+                        break;
+                    }
+                    payload_len = *len;
+                    fields++;
+                }
+
+                auto payload = buffer.FrontView(payload_len);
+                if (!payload) {
+                    break;
+                }
+
+                benchmark::DoNotOptimize(payload->data());
+                buffer.Pop(payload_len);
+                fields = 0;
+                ++objects;
+            }
+        }
+    }
+
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(chunks.size() * kStreamChunkSize));
+    state.SetItemsProcessed(static_cast<int64_t>(objects));
+}
+
 static void
 SafeStreamBuffer_Construct(benchmark::State& state)
 {
@@ -123,6 +237,8 @@ BENCHMARK(StreamBuffer_Push);
 BENCHMARK(StreamBuffer_PushBytes);
 BENCHMARK(StreamBuffer_PushLengthBytes);
 BENCHMARK(StreamBuffer_Front);
+BENCHMARK(StreamBuffer_ParseObjects)->RangeMultiplier(4)->Range(1024, 100'000);
+BENCHMARK(StreamBuffer_ParseObjectViews)->RangeMultiplier(4)->Range(1024, 100'000);
 BENCHMARK(SafeStreamBuffer_Construct);
 BENCHMARK(SafeStreamBuffer_Push);
 BENCHMARK(SafeStreamBuffer_PushBytes);
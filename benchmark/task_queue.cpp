@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <quicr/detail/safe_queue.h>
+#include <quicr/detail/task_queue.h>
+
+#include <benchmark/benchmark.h>
+
+#include <functional>
+#include <thread>
+#include <vector>
+
+constexpr size_t kTasksPerRun = 100'000;
+
+/*
+ * Each run starts state.range(0) producer threads that push kTasksPerRun tasks in total, while the
+ * benchmark thread runs them as the single consumer, like the picoquic thread does with the runner queue.
+ */
+
+static void
+TaskQueue_MultiProducer(benchmark::State& state)
+{
+    const auto producers = static_cast<size_t>(state.range(0));
+    quicr::TaskQueue<> queue;
+
+    for (auto _ : state) {
+        size_t ran = 0;
+        std::vector<std::thread> threads;
+
+        for (size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&queue, &ran, count = kTasksPerRun / producers] {
+                for (size_t i = 0; i < count; ++i) {
+                    while (!queue.Push([&ran] { ++ran; })) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        const size_t total = kTasksPerRun / producers * producers;
+        while (ran < total) {
+            if (!queue.RunOne()) {
+                std::this_thread::yield();
+            }
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        benchmark::DoNotOptimize(ran);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kTasksPerRun));
+}
+
+static void
+SafeQueue_MultiProducer(benchmark::State& state)
+{
+    const auto producers = static_cast<size_t>(state.range(0));
+    quicr::SafeQueue<std::function<void()>> queue(kTasksPerRun);
+
+    for (auto _ : state) {
+        size_t ran = 0;
+        std::vector<std::thread> threads;
+
+        for (size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&queue, &ran, count = kTasksPerRun / producers] {
+                for (size_t i = 0; i < count; ++i) {
+                    queue.Push([&ran] { ++ran; });
+                }
+            });
+        }
+
+        const size_t total = kTasksPerRun / producers * producers;
+        while (ran < total) {
+            if (auto task = queue.Pop()) {
+                (*task)();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        benchmark::DoNotOptimize(ran);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kTasksPerRun));
+}
+
+BENCHMARK(TaskQueue_MultiProducer)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK(SafeQueue_MultiProducer)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
@@ -59,3 +59,62 @@ TimeQueue_PopFront(benchmark::State& state)
 BENCHMARK(TimeQueue_Push)->Iterations(kIterations);
 BENCHMARK(TimeQueue_Pop)->Iterations(kIterations);
 BENCHMARK(TimeQueue_PopFront)->Iterations(kIterations);
+
+/*
+ * Per group stream pattern. Each new group starts a new stream and clears the queue of the previous
+ * group, which can still have objects when the new group arrives. Uses the default transport config of
+ * 2000ms duration with 1ms interval.
+ */
+static void
+TimeQueue_GroupCycle(benchmark::State& state)
+{
+    const auto objects_per_group = state.range(0);
+    quicr::TimeQueue<int, std::chrono::milliseconds> tq(2000, 1, service);
+    quicr::TimeQueueElement<int> elem;
+    int64_t items_count = 0;
+
+    for (auto _ : state) {
+        for (int64_t i = 0; i < objects_per_group; ++i) {
+            tq.Push(static_cast<int>(i), 1000);
+        }
+
+        for (int64_t i = 0; i < objects_per_group; ++i) {
+            tq.PopFront(elem);
+            benchmark::DoNotOptimize(elem);
+        }
+
+        tq.Clear();
+        items_count += objects_per_group;
+    }
+
+    state.SetItemsProcessed(items_count);
+}
+
+static void
+TimeQueue_GroupClearPending(benchmark::State& state)
+{
+    const auto objects_per_group = state.range(0);
+    quicr::TimeQueue<int, std::chrono::milliseconds> tq(2000, 1, service);
+    quicr::TimeQueueElement<int> elem;
+    int64_t items_count = 0;
+
+    for (auto _ : state) {
+        for (int64_t i = 0; i < objects_per_group; ++i) {
+            tq.Push(static_cast<int>(i), 1000);
+        }
+
+        // Half the group is sent before the next group clears the rest
+        for (int64_t i = 0; i < objects_per_group / 2; ++i) {
+            tq.PopFront(elem);
+            benchmark::DoNotOptimize(elem);
+        }
+
+        tq.Clear();
+        items_count += objects_per_group;
+    }
+
+    state.SetItemsProcessed(items_count);
+}
+
+BENCHMARK(TimeQueue_GroupCycle)->Arg(1)->Arg(10)->Arg(100);
+BENCHMARK(TimeQueue_GroupClearPending)->Arg(1)->Arg(10)->Arg(100);
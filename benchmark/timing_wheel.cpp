@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <quicr/detail/priority_queue.h>
+#include <quicr/detail/quic_transport.h>
+
+#include <benchmark/benchmark.h>
+
+#include "manual_tick_service.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+/*
+ * Many publishing tracks on one connection. Each track has its own transmit queue and all queues store
+ * their objects in the timing wheel of the connection.
+ */
+
+using quicr::test::ManualTickService;
+
+static const auto kObject = std::make_shared<const std::vector<uint8_t>>(1000, 0);
+
+static std::vector<std::unique_ptr<quicr::PriorityQueue<quicr::ConnData>>>
+MakeTracks(const std::shared_ptr<quicr::TimingWheel<quicr::ConnData>>& wheel, std::size_t tracks)
+{
+    std::vector<std::unique_ptr<quicr::PriorityQueue<quicr::ConnData>>> queues;
+    queues.reserve(tracks);
+
+    for (std::size_t i = 0; i < tracks; ++i) {
+        queues.push_back(std::make_unique<quicr::PriorityQueue<quicr::ConnData>>(wheel));
+    }
+
+    return queues;
+}
+
+static void
+TimingWheel_Tracks(benchmark::State& state)
+{
+    const auto tracks = static_cast<std::size_t>(state.range(0));
+    auto service = std::make_shared<ManualTickService>();
+    auto wheel = std::make_shared<quicr::TimingWheel<quicr::ConnData>>(2000, 1, service, 1000);
+    auto queues = MakeTracks(wheel, tracks);
+
+    quicr::TimeQueueElement<quicr::ConnData> elem;
+    std::size_t track = 0;
+
+    // Each track has a few objects queued, objects are sent round robin
+    for (auto& queue : queues) {
+        for (int i = 0; i < 4; ++i) {
+            queue->Push({ 1, track, 2, quicr::StreamAction::kNoAction, kObject, 0, nullptr }, 1000, 2);
+        }
+    }
+
+    for (auto _ : state) {
+        auto& queue = *queues[track];
+
+        queue.PopFront(elem);
+        queue.Push({ 1, track, 2, quicr::StreamAction::kNoAction, kObject, 0, nullptr }, 1000, 2);
+
+        if (++track == tracks) {
+            track = 0;
+            service->ms++;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["queue_bytes_per_track"] = sizeof(quicr::PriorityQueue<quicr::ConnData>);
+}
+
+static void
+TimingWheel_Expire(benchmark::State& state)
+{
+    const auto tracks = static_cast<std::size_t>(state.range(0));
+    auto service = std::make_shared<ManualTickService>();
+    auto wheel = std::make_shared<quicr::TimingWheel<quicr::ConnData>>(2000, 1, service, 1000);
+    auto queues = MakeTracks(wheel, tracks);
+
+    std::size_t track = 0;
+
+    // Tracks that are not sending, objects are only removed when they expire
+    for (auto _ : state) {
+        queues[track]->Push({ 1, track, 2, quicr::StreamAction::kNoAction, kObject, 0, nullptr }, 100, 2);
+
+        if (++track == tracks) {
+            track = 0;
+        }
+        service->ms++;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["queued"] = static_cast<double>(wheel->Size());
+}
+
+BENCHMARK(TimingWheel_Tracks)->Arg(100)->Arg(10'000)->ArgName("tracks");
+BENCHMARK(TimingWheel_Expire)->Arg(100)->Arg(10'000)->ArgName("tracks");
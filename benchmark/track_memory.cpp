@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "transport_picoquic.h"
+
+#include <quicr/detail/flat_hash_map.h>
+#include <quicr/publish_track_handler.h>
+#include <quicr/subscribe_track_handler.h>
+
+#include <benchmark/benchmark.h>
+
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+ * Memory held by idle tracks on one connection. Creates the state the transports keep per track, the same
+ * way Transport::PublishTrack(), Transport::SubscribeTrack() and PicoQuicTransport::CreateDataContext() do,
+ * and reports the heap and inline bytes per track.
+ *
+ * A publish track has a track handler, a data context with its transmit queue in the timing wheel of the
+ * connection and entries in the publish track maps of the connection. A subscribe track has a track handler
+ * and entries in the subscribe track maps. Tracks are spread over a few namespaces.
+ */
+
+using ConnectionContext = quicr::PicoQuicTransport::ConnectionContext;
+using DataContext = quicr::PicoQuicTransport::DataContext;
+
+constexpr std::size_t kNamespaces = 16;
+
+/// Publish and subscribe track maps of Transport::ConnectionContext
+struct TrackMaps
+{
+    quicr::FlatHashMap<quicr::messages::RequestID, std::shared_ptr<quicr::SubscribeTrackHandler>> tracks_by_request_id;
+    quicr::FlatHashMap<quicr::messages::TrackAlias, std::shared_ptr<quicr::SubscribeTrackHandler>> sub_by_track_alias;
+
+    std::map<quicr::TrackNamespaceHash, std::map<quicr::TrackNameHash, std::shared_ptr<quicr::PublishTrackHandler>>>
+      pub_tracks_by_name;
+    quicr::FlatHashMap<quicr::messages::TrackAlias, std::shared_ptr<quicr::PublishTrackHandler>>
+      pub_tracks_by_track_alias;
+    quicr::FlatHashMap<quicr::DataContextId, std::shared_ptr<quicr::PublishTrackHandler>> pub_tracks_by_data_ctx_id;
+};
+
+/// Bytes allocated on the heap and in use
+static std::size_t
+HeapBytesInUse()
+{
+#if defined(__APPLE__)
+    malloc_statistics_t stats;
+    malloc_zone_statistics(nullptr, &stats);
+    return stats.size_in_use;
+#elif defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+static quicr::FullTrackName
+MakeTrackName(std::size_t track)
+{
+    using namespace std::string_literals;
+
+    const auto name = "track-"s + std::to_string(track);
+    return { quicr::TrackNamespace{ "example"s, "meeting"s, "ns-"s + std::to_string(track % kNamespaces) },
+             { name.begin(), name.end() },
+             std::nullopt };
+}
+
+static void
+AddPublishTrack(ConnectionContext& conn_ctx, TrackMaps& maps, std::size_t track)
+{
+    auto handler = quicr::PublishTrackHandler::Create(MakeTrackName(track), quicr::TrackMode::kStream, 2, 1000);
+    const quicr::TrackHash th(handler->GetFullTrackName());
+
+    const auto data_ctx_it = conn_ctx.active_data_contexts.emplace(conn_ctx.next_data_ctx_id).first;
+    data_ctx_it->second.data_ctx_id = conn_ctx.next_data_ctx_id++;
+    data_ctx_it->second.priority = 2;
+    data_ctx_it->second.tx_data = std::make_unique<quicr::PriorityQueue<quicr::ConnData>>(conn_ctx.tx_wheel);
+
+    maps.pub_tracks_by_name[th.track_namespace_hash][th.track_name_hash] = handler;
+    maps.pub_tracks_by_track_alias[th.track_fullname_hash] = handler;
+    maps.pub_tracks_by_data_ctx_id[data_ctx_it->second.data_ctx_id] = std::move(handler);
+}
+
+static void
+AddSubscribeTrack(TrackMaps& maps, std::size_t track)
+{
+    auto handler = quicr::SubscribeTrackHandler::Create(MakeTrackName(track), 2);
+
+    maps.sub_by_track_alias[track] = handler;
+    maps.tracks_by_request_id[track] = std::move(handler);
+}
+
+static void
+TrackMemory_IdleTracks(benchmark::State& state)
+{
+    const auto tracks = static_cast<std::size_t>(state.range(0));
+    const bool publish = state.range(1) != 0;
+    auto service = std::make_shared<quicr::ThreadedTickService>();
+
+    std::size_t heap_bytes = 0;
+
+    for (auto _ : state) {
+        auto conn_ctx = std::make_unique<ConnectionContext>();
+        conn_ctx->tx_wheel = std::make_shared<quicr::TimingWheel<quicr::ConnData>>(2000, 1, service, 1000);
+        auto maps = std::make_unique<TrackMaps>();
+
+        const auto heap_start = HeapBytesInUse();
+
+        for (std::size_t track = 0; track < tracks; ++track) {
+            if (publish) {
+                AddPublishTrack(*conn_ctx, *maps, track);
+            } else {
+                AddSubscribeTrack(*maps, track);
+            }
+        }
+
+        heap_bytes = HeapBytesInUse() - heap_start;
+        benchmark::DoNotOptimize(maps);
+    }
+
+    if (HeapBytesInUse() == 0) {
+        state.SkipWithError("Heap usage is not available on this platform");
+        return;
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(tracks));
+    state.counters["bytes_per_track"] = static_cast<double>(heap_bytes) / static_cast<double>(tracks);
+
+    if (publish) {
+        state.counters["data_ctx_bytes"] = sizeof(DataContext);
+        state.counters["handler_bytes"] = sizeof(quicr::PublishTrackHandler);
+    } else {
+        state.counters["handler_bytes"] = sizeof(quicr::SubscribeTrackHandler);
+    }
+}
+
+BENCHMARK(TrackMemory_IdleTracks)
+  ->Args({ 1000, 1 })
+  ->Args({ 10'000, 1 })
+  ->Args({ 1000, 0 })
+  ->Args({ 10'000, 0 })
+  ->ArgNames({ "tracks", "publish" })
+  ->Unit(benchmark::kMillisecond);
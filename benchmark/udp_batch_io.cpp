@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <quicr/detail/udp_batch_socket.h>
+
+#include <benchmark/benchmark.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <ctime>
+#include <vector>
+
+/*
+ * Sends bursts of QUIC sized packets over loopback and receives them on a second socket. Counters report
+ * the packets moved per syscall and the CPU seconds needed per gigabit, which is the number of cores
+ * needed to sustain 1 Gbps.
+ */
+
+constexpr std::size_t kPacketSize = 1200;
+constexpr std::size_t kBurstPackets = 256;
+
+static double
+ProcessCpuSeconds()
+{
+    timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1e9;
+}
+
+static sockaddr_in
+LoopbackAddr(int fd)
+{
+    sockaddr_in addr{};
+    socklen_t addr_len = sizeof(addr);
+    getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &addr_len);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return addr;
+}
+
+static bool
+WaitReadable(int fd)
+{
+    pollfd pfd{ fd, POLLIN, 0 };
+    return poll(&pfd, 1, 100) > 0;
+}
+
+static void
+SetCounters(benchmark::State& state,
+            uint64_t packets,
+            uint64_t tx_syscalls,
+            uint64_t rx_syscalls,
+            uint64_t dropped,
+            double cpu_seconds)
+{
+    const double gbits = static_cast<double>(packets * kPacketSize * 8) / 1e9;
+
+    state.SetItemsProcessed(static_cast<int64_t>(packets));
+    state.SetBytesProcessed(static_cast<int64_t>(packets * kPacketSize));
+    state.counters["tx_pkts_per_syscall"] = static_cast<double>(packets) / static_cast<double>(tx_syscalls);
+    state.counters["rx_pkts_per_syscall"] = static_cast<double>(packets) / static_cast<double>(rx_syscalls);
+    state.counters["cpu_s_per_Gbit"] = gbits > 0 ? cpu_seconds / gbits : 0;
+    state.counters["dropped"] = static_cast<double>(dropped);
+}
+
+static void
+UdpIo_SendTo(benchmark::State& state)
+{
+    const int tx_fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    const int rx_fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+    int buffer_size = 2'000'000;
+    setsockopt(rx_fd, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+
+    sockaddr_in bind_addr{};
+    bind_addr.sin_family = AF_INET;
+    bind_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    bind(rx_fd, reinterpret_cast<sockaddr*>(&bind_addr), sizeof(bind_addr));
+    const auto peer_addr = LoopbackAddr(rx_fd);
+
+    std::vector<uint8_t> packet(kPacketSize, 0xAB);
+    std::vector<uint8_t> recv_buffer(2048);
+    uint64_t packets = 0, tx_syscalls = 0, rx_syscalls = 0, dropped = 0;
+
+    const auto cpu_start = ProcessCpuSeconds();
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < kBurstPackets; ++i) {
+            sendto(
+              tx_fd, packet.data(), packet.size(), 0, reinterpret_cast<const sockaddr*>(&peer_addr), sizeof(peer_addr));
+            tx_syscalls++;
+        }
+
+        std::size_t received = 0;
+        while (received < kBurstPackets) {
+            rx_syscalls++;
+            if (recvfrom(rx_fd, recv_buffer.data(), recv_buffer.size(), MSG_DONTWAIT, nullptr, nullptr) > 0) {
+                received++;
+            } else if (!WaitReadable(rx_fd)) {
+                break;
+            }
+        }
+
+        packets += received;
+        dropped += kBurstPackets - received;
+    }
+
+    SetCounters(state, packets, tx_syscalls, rx_syscalls, dropped, ProcessCpuSeconds() - cpu_start);
+
+    close(tx_fd);
+    close(rx_fd);
+}
+
+static void
+UdpIo_Batch(benchmark::State& state)
+{
+    if (!quicr::UdpBatchSocket::Supported()) {
+        state.SkipWithError("Batched UDP I/O is not supported on this platform");
+        return;
+    }
+
+    const bool use_offload = state.range(0) != 0;
+
+    quicr::UdpBatchSocket tx_socket(kPacketSize, use_offload);
+    quicr::UdpBatchSocket rx_socket(kPacketSize, use_offload);
+    tx_socket.Open(AF_INET, 0, false);
+    rx_socket.Open(AF_INET, 0, false);
+
+    const auto peer_addr = LoopbackAddr(rx_socket.Fd());
+    const std::size_t segments = tx_socket.GsoEnabled() ? quicr::UdpBatchSocket::kMaxGsoSegments : 1;
+    uint64_t packets = 0, dropped = 0;
+
+    const auto cpu_start = ProcessCpuSeconds();
+
+    for (auto _ : state) {
+        for (std::size_t sent = 0; sent < kBurstPackets; sent += segments) {
+            auto buffer = tx_socket.SendBuffer();
+            std::fill_n(buffer.begin(), kPacketSize * segments, 0xAB);
+            tx_socket.QueueSend(
+              kPacketSize * segments, kPacketSize, reinterpret_cast<const sockaddr*>(&peer_addr), nullptr, 0);
+        }
+        tx_socket.Flush();
+
+        std::size_t received = 0;
+        while (received < kBurstPackets) {
+            const auto rx_packets = rx_socket.Receive();
+            if (!rx_packets.empty()) {
+                received += rx_packets.size();
+            } else if (!WaitReadable(rx_socket.Fd())) {
+                break;
+            }
+        }
+
+        packets += received;
+        dropped += kBurstPackets - received;
+    }
+
+    SetCounters(state,
+                packets,
+                tx_socket.GetStats().tx_syscalls,
+                rx_socket.GetStats().rx_syscalls,
+                dropped,
+                ProcessCpuSeconds() - cpu_start);
+    state.counters["gso"] = tx_socket.GsoEnabled();
+    state.counters["gro"] = rx_socket.GroEnabled();
+}
+
+BENCHMARK(UdpIo_SendTo)->UseRealTime();
+BENCHMARK(UdpIo_Batch)->Arg(0)->Arg(1)->ArgName("offload")->UseRealTime();
@@ -2,10 +2,12 @@
 // SPDX-License-Identifier: BSD-2-Clause
 
 #include <quicr/detail/uintvar.h>
+#include <quicr/detail/uintvar_batch.h>
 
 #include <benchmark/benchmark.h>
 
 #include <cstdint>
+#include <vector>
 
 static void
 UIntVar_FromUint64(benchmark::State& state)
@@ -51,7 +53,137 @@ UIntVar_FromBytes(benchmark::State& state)
     }
 }
 
+/**
+ * @brief Header like values, mostly single byte ids and lengths with some larger group and track alias values
+ */
+static std::vector<uint64_t>
+MakeHeaderValues()
+{
+    std::vector<uint64_t> values;
+    for (uint64_t i = 0; values.size() < 1024; ++i) {
+        values.push_back(i % 64);
+        values.push_back((i * 7) % 64);
+        if (i % 4 == 0) {
+            values.push_back(0x1000 + i);
+        }
+        if (i % 16 == 0) {
+            values.push_back(0x12345678 + i);
+        }
+    }
+    values.resize(1024);
+    return values;
+}
+
+static std::vector<uint8_t>
+EncodeHeaderValues(const std::vector<uint64_t>& values)
+{
+    std::vector<uint8_t> bytes;
+    for (const auto value : values) {
+        const auto var_int = quicr::UintVar(value);
+        bytes.insert(bytes.end(), var_int.begin(), var_int.end());
+    }
+    return bytes;
+}
+
+/*
+ * Decode one value at a time with UintVar, as done by the message parsers.
+ */
+static void
+UIntVar_DecodePerValue(benchmark::State& state)
+{
+    const auto values = MakeHeaderValues();
+    const auto bytes = EncodeHeaderValues(values);
+    std::vector<uint64_t> decoded(values.size());
+
+    for ([[maybe_unused]] const auto& _ : state) {
+        std::size_t pos = 0;
+        for (auto& value : decoded) {
+            const auto var_int = quicr::UintVar(std::span{ bytes }.subspan(pos));
+            value = uint64_t(var_int);
+            pos += var_int.Size();
+        }
+        benchmark::DoNotOptimize(decoded.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+}
+
+/*
+ * Decode all values with the batch kernel of range(0), a quicr::UintVarKernel.
+ */
+static void
+UIntVar_DecodeBatch(benchmark::State& state)
+{
+    const auto kernel = static_cast<quicr::UintVarKernel>(state.range(0));
+    if (!quicr::UintVarKernelSupported(kernel)) {
+        state.SkipWithError("Kernel not supported");
+        return;
+    }
+
+    const auto values = MakeHeaderValues();
+    const auto bytes = EncodeHeaderValues(values);
+    std::vector<uint64_t> decoded(values.size());
+
+    for ([[maybe_unused]] const auto& _ : state) {
+        benchmark::DoNotOptimize(quicr::DecodeUintVars(kernel, bytes, decoded));
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+}
+
+/*
+ * Encode one value at a time with UintVar, as done by the message serializers.
+ */
+static void
+UIntVar_EncodePerValue(benchmark::State& state)
+{
+    const auto values = MakeHeaderValues();
+    std::vector<uint8_t> bytes;
+    bytes.reserve(values.size() * sizeof(uint64_t));
+
+    for ([[maybe_unused]] const auto& _ : state) {
+        bytes.clear();
+        for (const auto value : values) {
+            const auto var_int = quicr::UintVar(value);
+            bytes.insert(bytes.end(), var_int.begin(), var_int.end());
+        }
+        benchmark::DoNotOptimize(bytes.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+}
+
+/*
+ * Encode all values with the batch kernel of range(0), a quicr::UintVarKernel.
+ */
+static void
+UIntVar_EncodeBatch(benchmark::State& state)
+{
+    const auto kernel = static_cast<quicr::UintVarKernel>(state.range(0));
+    if (!quicr::UintVarKernelSupported(kernel)) {
+        state.SkipWithError("Kernel not supported");
+        return;
+    }
+
+    const auto values = MakeHeaderValues();
+    std::vector<uint8_t> bytes(values.size() * sizeof(uint64_t));
+
+    for ([[maybe_unused]] const auto& _ : state) {
+        benchmark::DoNotOptimize(quicr::EncodeUintVars(kernel, values, bytes));
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(values.size()));
+}
+
 BENCHMARK(UIntVar_FromUint64);
 BENCHMARK(UIntVar_ToUint64);
 BENCHMARK(UIntVar_ToBytes);
 BENCHMARK(UIntVar_FromBytes);
+BENCHMARK(UIntVar_DecodePerValue);
+BENCHMARK(UIntVar_DecodeBatch)->DenseRange(0, 3)->ArgName("kernel");
+BENCHMARK(UIntVar_EncodePerValue);
+BENCHMARK(UIntVar_EncodeBatch)->DenseRange(0, 3)->ArgName("kernel");
@@ -717,6 +717,7 @@ InitConfig(cxxopts::ParseResult& cli_opts, bool& enable_pub, bool& enable_sub, b
     config.transport_config.tls_cert_filename = "";
     config.transport_config.tls_key_filename = "";
     config.transport_config.quic_qlog_path = qlog_path;
+    config.transport_config.use_batch_io = cli_opts["batch_io"].as<bool>();
 
     return config;
 }
@@ -740,6 +741,7 @@ main(int argc, char* argv[])
         ("r,url", "Relay URL", cxxopts::value<std::string>()->default_value("moq://localhost:1234"))
         ("e,endpoint_id", "This client endpoint ID", cxxopts::value<std::string>()->default_value("moq-client"))
         ("q,qlog", "Enable qlog using path", cxxopts::value<std::string>())
+        ("batch_io", "Use batched UDP I/O with GSO/GRO (Linux only)")
         ("s,ssl_keylog", "Enable SSL Keylog for transport debugging");
 
     options.add_options("Publisher")
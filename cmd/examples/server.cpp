@@ -20,11 +20,14 @@ using FullTrackNameHash = uint64_t;
 
 /**
  * @brief Defines an object received from an announcer that lives in the cache.
+ *
+ * @details The data is compacted on insert so that the cache holds only the object bytes and not the
+ *      receive buffer they arrived in.
  */
 struct CacheObject
 {
     quicr::ObjectHeaders headers;
-    quicr::Bytes data;
+    quicr::SharedSpan<uint8_t> data;
 };
 
 /**
@@ -146,7 +149,7 @@ class MySubscribeTrackHandler : public quicr::SubscribeTrackHandler
     {
     }
 
-    void ObjectReceived(const quicr::ObjectHeaders& object_headers, quicr::BytesSpan data) override
+    void ObjectReceived(const quicr::ObjectHeaders& object_headers, const quicr::SharedSpan<uint8_t>& data) override
     {
         if (data.size() > 255) {
             SPDLOG_CRITICAL("Example server is for example only, received data > 255 bytes is not allowed!");
@@ -181,7 +184,8 @@ class MySubscribeTrackHandler : public quicr::SubscribeTrackHandler
 
         auto& cache_entry = qserver_vars::cache.at(*track_alias);
 
-        CacheObject object{ object_headers, { data.begin(), data.end() } };
+        // A view of the received data keeps its whole pooled receive buffer alive, cache a compact copy instead
+        CacheObject object{ object_headers, data.Compact() };
 
         if (auto group = cache_entry.Get(object_headers.group_id)) {
             group->insert(std::move(object));
@@ -897,6 +901,8 @@ InitConfig(cxxopts::ParseResult& cli_opts)
     config.transport_config.time_queue_max_duration = 50000;
     config.transport_config.quic_qlog_path = qlog_path;
     config.transport_config.max_connections = 1000;
+    config.transport_config.server_threads = cli_opts["threads"].as<uint16_t>();
+    config.transport_config.use_batch_io = cli_opts["batch_io"].as<bool>();
 
     return config;
 }
@@ -918,6 +924,8 @@ main(int argc, char* argv[])
         "c,cert", "Certificate file", cxxopts::value<std::string>()->default_value("./server-cert.pem"))(
         "k,key", "Certificate key file", cxxopts::value<std::string>()->default_value("./server-key.pem"))(
         "q,qlog", "Enable qlog using path", cxxopts::value<std::string>())(
+        "t,threads", "Number of packet loop threads", cxxopts::value<uint16_t>()->default_value("1"))(
+        "batch_io", "Use batched UDP I/O with GSO/GRO (Linux only)")(
         "s,ssl_keylog", "Enable SSL Keylog for transport debugging"); // end of options
 
     auto result = options.parse(argc, argv);
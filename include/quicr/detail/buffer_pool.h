@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace quicr {
+
+    /**
+     * @brief Pool of fixed size reference counted buffers
+     *
+     * @details Buffers are handed out as shared pointers that the pool also holds. A buffer is free again
+     *      once the pool holds the only reference, which happens when the last user drops it. Reusing a
+     *      buffer does not allocate since the vector and the shared pointer control block are kept.
+     *
+     *      Buffers are acquired round-robin, which matches the order that received data is consumed in.
+     *      Acquire is only safe to be called by one thread, but buffers can be released by any thread.
+     */
+    class BufferPool
+    {
+      public:
+        using BufferType = std::shared_ptr<const std::vector<uint8_t>>;
+
+        /**
+         * @brief Construct the buffer pool
+         *
+         * @param size          Number of buffers in the pool. Zero disables pooling.
+         * @param buffer_size   Capacity of each buffer in bytes. Larger data is not pooled.
+         */
+        BufferPool(std::size_t size, std::size_t buffer_size)
+          : buffers_(size)
+          , buffer_size_(buffer_size)
+        {
+        }
+
+        /**
+         * @brief Acquire a buffer with a copy of the bytes
+         *
+         * @param bytes         Bytes to copy into the buffer
+         *
+         * @returns Pair of the buffer and true if the buffer came from the pool, false if it was allocated
+         */
+        std::pair<BufferType, bool> Acquire(std::span<const uint8_t> bytes)
+        {
+            if (bytes.size() <= buffer_size_) {
+                for (std::size_t probe = 0; probe < std::min(kMaxProbes, buffers_.size()); ++probe) {
+                    auto& buffer = buffers_[next_];
+                    next_ = (next_ + 1) % buffers_.size();
+
+                    if (!buffer) { // First use of the slot
+                        buffer = std::make_shared<std::vector<uint8_t>>();
+                        buffer->reserve(buffer_size_);
+                        buffer->assign(bytes.begin(), bytes.end());
+                        return { buffer, false };
+                    }
+
+                    if (buffer.use_count() == 1) {
+                        // Synchronize with the release of the last user before writing to the buffer
+                        std::atomic_thread_fence(std::memory_order_acquire);
+
+                        buffer->assign(bytes.begin(), bytes.end());
+                        return { buffer, true };
+                    }
+                }
+            }
+
+            return { std::make_shared<const std::vector<uint8_t>>(bytes.begin(), bytes.end()), false };
+        }
+
+        /**
+         * @brief Number of buffers in the pool
+         */
+        std::size_t Size() const noexcept { return buffers_.size(); }
+
+      private:
+        static constexpr std::size_t kMaxProbes = 8; /// Max buffers checked for a free one before allocating
+
+        std::vector<std::shared_ptr<std::vector<uint8_t>>> buffers_;
+        std::size_t buffer_size_;
+        std::size_t next_{ 0 };
+    };
+
+} // namespace quicr
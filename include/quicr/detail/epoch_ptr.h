@@ -0,0 +1,180 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace quicr {
+
+    /**
+     * @brief Epoch protected pointer to a read mostly value
+     *
+     * @details Readers access the current value without locking. Writers update a copy of the value and
+     *      publish it in place of the current one (read-copy-update). Replaced values are retired and
+     *      freed by Reclaim() once no reader can still be using them.
+     *
+     *      Readers register in one of two epoch counters. Reclaim() advances the epoch only after the
+     *      readers of the previous epoch are done, which leaves at most two epochs with active readers.
+     *      Values retired before the current epoch are then no longer visible to any reader.
+     *
+     * @tparam T        Value type, must be copy constructible
+     */
+    template<typename T>
+    class EpochPtr
+    {
+      public:
+        /**
+         * @brief Read access to the value that was current when the guard was created
+         *
+         * @details The value remains valid until the guard is destroyed. Guards should be short lived
+         *      since they hold back reclaiming of retired values.
+         */
+        class ReadGuard
+        {
+          public:
+            ReadGuard(const ReadGuard&) = delete;
+            ReadGuard& operator=(const ReadGuard&) = delete;
+
+            ~ReadGuard() { readers_->fetch_sub(1, std::memory_order_release); }
+
+            const T* operator->() const noexcept { return value_; }
+            const T& operator*() const noexcept { return *value_; }
+
+          private:
+            friend class EpochPtr;
+
+            ReadGuard(const T* value, std::atomic<uint64_t>* readers)
+              : value_(value)
+              , readers_(readers)
+            {
+            }
+
+            const T* value_;
+            std::atomic<uint64_t>* readers_;
+        };
+
+        EpochPtr()
+          : EpochPtr(std::make_unique<T>())
+        {
+        }
+
+        explicit EpochPtr(std::unique_ptr<T> value)
+          : value_(value.release())
+        {
+        }
+
+        EpochPtr(const EpochPtr&) = delete;
+        EpochPtr& operator=(const EpochPtr&) = delete;
+
+        /**
+         * @details Destroying the pointer while there are readers is undefined
+         */
+        ~EpochPtr() { delete value_.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Get read access to the current value
+         *
+         * @details Safe to be called by many threads at the same time. Does not lock.
+         */
+        ReadGuard Read() const
+        {
+            while (true) {
+                const auto epoch = epoch_.load(std::memory_order_seq_cst);
+                auto& readers = readers_[epoch & 1];
+
+                readers.fetch_add(1, std::memory_order_seq_cst);
+
+                // Epoch advanced before the reader registered, register again in the new epoch
+                if (epoch_.load(std::memory_order_seq_cst) == epoch) {
+                    return ReadGuard(value_.load(std::memory_order_seq_cst), &readers);
+                }
+
+                readers.fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        /**
+         * @brief Update the value
+         *
+         * @details Copies the current value, calls the update function with the copy and then publishes the
+         *      copy as the current value. The replaced value is retired. Writers are serialized.
+         *
+         * @param update_fn     Function called with a reference to the copy of the value to update
+         */
+        template<typename F>
+        void Update(F&& update_fn)
+        {
+            std::lock_guard<std::mutex> _(writer_mutex_);
+
+            auto* current = value_.load(std::memory_order_relaxed);
+            auto value = std::make_unique<T>(*current);
+
+            std::forward<F>(update_fn)(*value);
+
+            value_.store(value.release(), std::memory_order_seq_cst);
+            retired_.emplace_back(epoch_.load(std::memory_order_relaxed), std::unique_ptr<T>(current));
+        }
+
+        /**
+         * @brief Free retired values that are no longer visible to readers
+         *
+         * @details Each call can advance the epoch by one, so a retired value is freed by the second call
+         *      after it was retired if no reader holds a guard for that long.
+         *
+         * @return Number of retired values that were freed
+         */
+        std::size_t Reclaim()
+        {
+            std::lock_guard<std::mutex> _(writer_mutex_);
+
+            if (retired_.empty()) {
+                return 0;
+            }
+
+            const auto epoch = epoch_.load(std::memory_order_seq_cst);
+
+            // Readers of the previous epoch share the counter with the next epoch
+            if (readers_[(epoch + 1) & 1].load(std::memory_order_seq_cst) != 0) {
+                return 0;
+            }
+
+            std::size_t freed = 0;
+            for (auto it = retired_.begin(); it != retired_.end();) {
+                if (it->first < epoch) {
+                    it = retired_.erase(it);
+                    freed++;
+                } else {
+                    ++it;
+                }
+            }
+
+            epoch_.store(epoch + 1, std::memory_order_seq_cst);
+
+            return freed;
+        }
+
+        /**
+         * @brief Number of retired values waiting to be freed
+         */
+        std::size_t RetiredSize() const
+        {
+            std::lock_guard<std::mutex> _(writer_mutex_);
+            return retired_.size();
+        }
+
+      private:
+        std::atomic<T*> value_;
+        alignas(64) std::atomic<uint64_t> epoch_{ 0 };
+        alignas(64) mutable std::atomic<uint64_t> readers_[2]{ 0, 0 };
+
+        mutable std::mutex writer_mutex_; /// Serializes updates and reclaiming
+        std::vector<std::pair<uint64_t, std::unique_ptr<T>>> retired_;
+    };
+
+} // namespace quicr
@@ -0,0 +1,325 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace quicr {
+
+    /**
+     * @brief Open addressing hash map for lookups by ID
+     *
+     * @details Entries are stored in one array that is probed linearly, which makes a lookup one or two
+     *      cache line reads instead of the pointer chasing of std::map. Erased entries leave a tombstone so
+     *      that erasing does not move other entries. Tombstones are dropped when the table is rehashed.
+     *
+     *      Inserting can rehash, which invalidates iterators and, unless PointerStable is set, references
+     *      to values. With PointerStable each entry is allocated on its own so references stay valid until
+     *      the entry is erased, like std::map, at the cost of an extra pointer read per lookup.
+     *
+     *      Iteration order is unspecified.
+     *
+     * @tparam Key              Key type, hashed with Hash and then mixed so that sequential or aligned IDs spread
+     * @tparam T                Value type
+     * @tparam PointerStable    Keep references to values valid across inserts
+     * @tparam Hash             Hash function for the key
+     */
+    template<typename Key, typename T, bool PointerStable = false, typename Hash = std::hash<Key>>
+    class FlatHashMap
+    {
+      public:
+        using key_type = Key;
+        using mapped_type = T;
+        using value_type = std::pair<const Key, T>;
+        using size_type = std::size_t;
+
+      private:
+        using Slot = std::conditional_t<PointerStable, std::unique_ptr<value_type>, std::optional<value_type>>;
+
+        enum class Control : uint8_t
+        {
+            kEmpty = 0,
+            kFull,
+            kDeleted,
+        };
+
+        template<bool Const>
+        class Iterator
+        {
+            using MapType = std::conditional_t<Const, const FlatHashMap, FlatHashMap>;
+
+          public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = FlatHashMap::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+            using reference = std::conditional_t<Const, const value_type&, value_type&>;
+
+            Iterator() = default;
+            Iterator(MapType* map, std::size_t index)
+              : map_(map)
+              , index_(index)
+            {
+                SkipFree();
+            }
+
+            /// Iterators convert to const iterators
+            operator Iterator<true>() const { return { map_, index_ }; }
+
+            reference operator*() const { return *map_->slots_[index_]; }
+            pointer operator->() const { return &*map_->slots_[index_]; }
+
+            Iterator& operator++()
+            {
+                ++index_;
+                SkipFree();
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                auto it = *this;
+                ++*this;
+                return it;
+            }
+
+            bool operator==(const Iterator& other) const noexcept { return index_ == other.index_; }
+
+          private:
+            friend class FlatHashMap;
+
+            void SkipFree()
+            {
+                while (index_ < map_->control_.size() && map_->control_[index_] != Control::kFull) {
+                    ++index_;
+                }
+            }
+
+            MapType* map_{ nullptr };
+            std::size_t index_{ 0 };
+        };
+
+      public:
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        FlatHashMap() = default;
+        FlatHashMap(const FlatHashMap&) = default;
+        FlatHashMap(FlatHashMap&&) noexcept = default;
+        FlatHashMap& operator=(FlatHashMap&&) noexcept = default;
+
+        /// Slots hold const keys, so copy assignment copy constructs instead of assigning slots
+        FlatHashMap& operator=(const FlatHashMap& other)
+        {
+            if (this != &other) {
+                *this = FlatHashMap(other);
+            }
+            return *this;
+        }
+
+        iterator begin() noexcept { return { this, 0 }; }
+        iterator end() noexcept { return { this, control_.size() }; }
+        const_iterator begin() const noexcept { return { this, 0 }; }
+        const_iterator end() const noexcept { return { this, control_.size() }; }
+
+        std::size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+
+        iterator find(const Key& key) { return { this, FindIndex(key) }; }
+        const_iterator find(const Key& key) const { return { this, FindIndex(key) }; }
+
+        bool contains(const Key& key) const { return FindIndex(key) != control_.size(); }
+        std::size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+        T& at(const Key& key)
+        {
+            const auto index = FindIndex(key);
+            if (index == control_.size()) {
+                throw std::out_of_range("FlatHashMap key not found");
+            }
+            return slots_[index]->second;
+        }
+
+        T& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+        /**
+         * @brief Insert a value constructed from args if the key is not present
+         *
+         * @returns Pair of the iterator to the entry for the key and true if it was inserted
+         */
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+        {
+            if (const auto index = FindIndex(key); index != control_.size()) {
+                return { { this, index }, false };
+            }
+
+            // Keep at least 1/8 of the slots empty so that probing stops
+            if ((size_ + deleted_ + 1) * 8 > control_.size() * 7) {
+                Rehash(size_ + 1);
+            }
+
+            auto index = Probe(key);
+            while (control_[index] == Control::kFull) {
+                index = (index + 1) & mask_;
+            }
+
+            if (control_[index] == Control::kDeleted) {
+                --deleted_;
+            }
+
+            if constexpr (PointerStable) {
+                slots_[index] = std::make_unique<value_type>(std::piecewise_construct,
+                                                             std::forward_as_tuple(key),
+                                                             std::forward_as_tuple(std::forward<Args>(args)...));
+            } else {
+                slots_[index].emplace(std::piecewise_construct,
+                                      std::forward_as_tuple(key),
+                                      std::forward_as_tuple(std::forward<Args>(args)...));
+            }
+
+            control_[index] = Control::kFull;
+            ++size_;
+
+            return { { this, index }, true };
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> emplace(const Key& key, Args&&... args)
+        {
+            return try_emplace(key, std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Erase the entry at the iterator
+         *
+         * @details Does not invalidate other iterators
+         *
+         * @returns Iterator to the next entry
+         */
+        iterator erase(const_iterator it)
+        {
+            const auto index = it.index_;
+
+            slots_[index].reset();
+            --size_;
+
+            // No probe chain continues past an empty slot, so the tombstone is not needed
+            if (control_[(index + 1) & mask_] == Control::kEmpty) {
+                control_[index] = Control::kEmpty;
+            } else {
+                control_[index] = Control::kDeleted;
+                ++deleted_;
+            }
+
+            return { this, index + 1 };
+        }
+
+        iterator erase(iterator it) { return erase(const_iterator(it)); }
+
+        std::size_t erase(const Key& key)
+        {
+            const auto index = FindIndex(key);
+            if (index == control_.size()) {
+                return 0;
+            }
+
+            erase(const_iterator{ this, index });
+            return 1;
+        }
+
+        void clear()
+        {
+            for (std::size_t i = 0; i < control_.size(); ++i) {
+                slots_[i].reset();
+                control_[i] = Control::kEmpty;
+            }
+
+            size_ = 0;
+            deleted_ = 0;
+        }
+
+        /**
+         * @brief Reserve room for count entries without rehashing
+         */
+        void reserve(std::size_t count)
+        {
+            if (count * 8 > control_.size() * 7) {
+                Rehash(count);
+            }
+        }
+
+      private:
+        /// Slot to start probing at. Multiplicative hashing spreads sequential and pointer aligned IDs.
+        std::size_t Probe(const Key& key) const noexcept
+        {
+            const auto hash = static_cast<uint64_t>(Hash{}(key)) * 0x9E3779B97F4A7C15ull;
+            return static_cast<std::size_t>(hash >> shift_) & mask_;
+        }
+
+        std::size_t FindIndex(const Key& key) const
+        {
+            if (size_ == 0) {
+                return control_.size();
+            }
+
+            for (auto index = Probe(key); control_[index] != Control::kEmpty; index = (index + 1) & mask_) {
+                if (control_[index] == Control::kFull && slots_[index]->first == key) {
+                    return index;
+                }
+            }
+
+            return control_.size();
+        }
+
+        void Rehash(std::size_t count)
+        {
+            const std::size_t capacity = std::max<std::size_t>(8, std::bit_ceil(count + count / 4 + 1));
+
+            auto old_control = std::exchange(control_, std::vector<Control>(capacity, Control::kEmpty));
+            auto old_slots = std::exchange(slots_, std::vector<Slot>(capacity));
+
+            mask_ = capacity - 1;
+            shift_ = 64 - std::countr_zero(capacity);
+            deleted_ = 0;
+
+            for (std::size_t i = 0; i < old_control.size(); ++i) {
+                if (old_control[i] != Control::kFull) {
+                    continue;
+                }
+
+                auto index = Probe(old_slots[i]->first);
+                while (control_[index] == Control::kFull) {
+                    index = (index + 1) & mask_;
+                }
+
+                if constexpr (PointerStable) {
+                    slots_[index] = std::move(old_slots[i]);
+                } else {
+                    slots_[index].emplace(std::move(*old_slots[i]));
+                }
+                control_[index] = Control::kFull;
+            }
+        }
+
+        std::vector<Control> control_;
+        std::vector<Slot> slots_;
+        std::size_t size_{ 0 };
+        std::size_t deleted_{ 0 };
+        std::size_t mask_{ 0 };
+        int shift_{ 64 };
+    };
+
+} // namespace quicr
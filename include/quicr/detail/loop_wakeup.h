@@ -0,0 +1,109 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <fcntl.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#endif
+
+namespace quicr {
+
+    /**
+     * @brief Wakes up an event loop that is blocked waiting on file descriptors
+     *
+     * @details The loop includes Fd() in the descriptors it waits on. Other threads call Signal() after
+     *      queueing work for the loop, which makes Fd() readable. Uses an eventfd on Linux and a pipe on
+     *      other platforms. Not available on ESP platforms, where Fd() is -1.
+     *
+     *      To avoid a syscall for every signal, the loop arms the wakeup before it blocks and disarms it
+     *      after. Signal() only writes when the wakeup is armed. The loop must check for queued work after
+     *      arming and not block if there is any, since work queued before arming does not signal.
+     */
+    class LoopWakeup
+    {
+      public:
+        LoopWakeup()
+        {
+#if defined(__linux__)
+            read_fd_ = write_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#elif !defined(ESP_PLATFORM)
+            int fds[2];
+            if (pipe(fds) == 0) {
+                read_fd_ = fds[0];
+                write_fd_ = fds[1];
+                fcntl(read_fd_, F_SETFL, fcntl(read_fd_, F_GETFL) | O_NONBLOCK);
+                fcntl(write_fd_, F_SETFL, fcntl(write_fd_, F_GETFL) | O_NONBLOCK);
+            }
+#endif
+        }
+
+        ~LoopWakeup()
+        {
+            if (read_fd_ >= 0) {
+                close(read_fd_);
+            }
+            if (write_fd_ >= 0 && write_fd_ != read_fd_) {
+                close(write_fd_);
+            }
+        }
+
+        LoopWakeup(const LoopWakeup&) = delete;
+        LoopWakeup& operator=(const LoopWakeup&) = delete;
+
+        /**
+         * @brief File descriptor that is readable when signaled, -1 if it could not be created
+         */
+        int Fd() const noexcept { return read_fd_; }
+
+        /**
+         * @brief Arm the wakeup, called by the loop before it blocks
+         */
+        void Arm() noexcept
+        {
+            armed_.store(true, std::memory_order_relaxed);
+
+            // Order arming before the loop checks for queued work
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        /**
+         * @brief Disarm the wakeup and clear a pending signal, called by the loop after it wakes up
+         */
+        void Disarm() noexcept
+        {
+            armed_.store(false, std::memory_order_relaxed);
+
+            uint64_t value;
+            while (read(read_fd_, &value, sizeof(value)) > 0) {
+            }
+        }
+
+        /**
+         * @brief Wake up the loop if it is blocked or about to block
+         *
+         * @details Safe to be called by many threads. Call after queueing work for the loop.
+         */
+        void Signal() noexcept
+        {
+            // Order the queued work before checking if the loop is armed
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+
+            if (armed_.load(std::memory_order_relaxed) && armed_.exchange(false, std::memory_order_relaxed)) {
+                const uint64_t value = 1;
+                [[maybe_unused]] const auto written = write(write_fd_, &value, sizeof(value));
+            }
+        }
+
+      private:
+        int read_fd_{ -1 };
+        int write_fd_{ -1 };
+        std::atomic<bool> armed_{ false };
+    };
+
+} // namespace quicr
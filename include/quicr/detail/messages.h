@@ -147,11 +147,15 @@ namespace quicr::messages {
         ObjectId object_id;
         ObjectPriority publisher_priority;
         std::optional<Extensions> extensions;
-        uint64_t payload_len{ 0 };
+        uint64_t payload_len{ 0 }; /// Serializes only the header when non-zero and the payload is empty
         ObjectStatus object_status;
         Bytes payload;
+        bool view_payload{ false };       /// Parse into payload_view instead of copying into payload
+        SharedSpan<uint8_t> payload_view; /// Payload aliasing the data of the parsed stream buffer
         template<class StreamBufferType>
         friend bool operator>>(StreamBufferType& buffer, FetchObject& msg);
+        template<class StreamBufferType>
+        friend void DecodeContiguous(StreamBufferType& buffer, FetchObject& msg);
 
       private:
         uint64_t num_extensions{ 0 };
@@ -177,9 +181,13 @@ namespace quicr::messages {
         uint64_t payload_len{ 0 };
         ObjectStatus object_status;
         Bytes payload;
+        bool view_payload{ false };       /// Parse into payload_view instead of copying into payload
+        SharedSpan<uint8_t> payload_view; /// Payload aliasing the data of the parsed stream buffer
 
         template<class StreamBufferType>
         friend bool operator>>(StreamBufferType& buffer, ObjectDatagram& msg);
+        template<class StreamBufferType>
+        friend void DecodeContiguous(StreamBufferType& buffer, ObjectDatagram& msg);
 
       private:
         uint64_t num_extensions{ 0 };
@@ -230,13 +238,17 @@ namespace quicr::messages {
     struct StreamSubGroupObject
     {
         ObjectId object_id;
-        uint64_t payload_len{ 0 };
+        uint64_t payload_len{ 0 }; /// Serializes only the header when non-zero and the payload is empty
         ObjectStatus object_status;
         bool serialize_extensions;
         std::optional<Extensions> extensions;
         Bytes payload;
+        bool view_payload{ false };       /// Parse into payload_view instead of copying into payload
+        SharedSpan<uint8_t> payload_view; /// Payload aliasing the data of the parsed stream buffer
         template<class StreamBufferType>
         friend bool operator>>(StreamBufferType& buffer, StreamSubGroupObject& msg);
+        template<class StreamBufferType>
+        friend void DecodeContiguous(StreamBufferType& buffer, StreamSubGroupObject& msg);
 
       private:
         uint64_t num_extensions{ 0 };
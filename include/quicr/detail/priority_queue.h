@@ -3,24 +3,29 @@
 
 #pragma once
 
-#include <algorithm>
-#include <array>
-#include <chrono>
-#include <forward_list>
-#include <numeric>
-#include <optional>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
 
 #include "time_queue.h"
+#include "timing_wheel.h"
 
 namespace quicr {
     /**
-     * @brief Priority queue that uses time_queue for each priority
+     * @brief Priority queue of objects stored in a timing wheel
      *
      * @details Order is maintained for objects pushed by priority.
      *          During each `front()`/`pop()` the queue will always
      *          pop the lower priority objects first. Lower priority
      *          objects will be serviced first in the order they were
-     *          added to the queue.
+     *          added to the queue. A priority is only skipped when its
+     *          front object is waiting for its pop delay.
+     *
+     *          Objects are stored and expired by a timing wheel that
+     *          can be shared by many queues, such as all the queues of
+     *          a connection. The queue itself only holds links to its
+     *          objects in the wheel.
      *
      * @tparam DataType   The element type to be stored.
      * @tparam PMAX       Max priorities to allow - Range becomes 0 - PMAX
@@ -28,9 +33,6 @@ namespace quicr {
     template<typename DataType, uint8_t PMAX = 32>
     class PriorityQueue
     {
-        using TimeType = std::chrono::milliseconds;
-        using TimeQueueType = TimeQueue<DataType, TimeType>;
-
         struct Exception : public std::runtime_error
         {
             using std::runtime_error::runtime_error;
@@ -42,7 +44,9 @@ namespace quicr {
         };
 
       public:
-        ~PriorityQueue() {}
+        using WheelType = TimingWheel<DataType, PMAX>;
+
+        ~PriorityQueue() { wheel_->Clear(queue_); }
 
         /**
          * Construct a priority queue
@@ -54,7 +58,7 @@ namespace quicr {
         }
 
         /**
-         * Construct a priority queue
+         * Construct a priority queue with its own timing wheel
          *
          * @param duration              Max duration of time for the queue
          * @param interval              Interval per bucket, Default is 1
@@ -65,18 +69,26 @@ namespace quicr {
                       size_t interval,
                       const std::shared_ptr<TickService>& tick_service,
                       size_t initial_queue_size)
-          : tick_service_(tick_service)
+          : PriorityQueue(std::make_shared<WheelType>(duration, interval, tick_service, initial_queue_size))
         {
+        }
 
-            if (tick_service == nullptr) {
-                throw std::invalid_argument("Tick service cannot be null");
+        /**
+         * Construct a priority queue that stores its objects in a shared timing wheel
+         *
+         * @param wheel     Timing wheel to store objects in
+         */
+        explicit PriorityQueue(std::shared_ptr<WheelType> wheel)
+          : wheel_(std::move(wheel))
+        {
+            if (wheel_ == nullptr) {
+                throw std::invalid_argument("Timing wheel cannot be null");
             }
-
-            initial_queue_size_ = initial_queue_size;
-            duration_ms_ = duration;
-            interval_ms_ = interval;
         }
 
+        PriorityQueue(const PriorityQueue&) = delete;
+        PriorityQueue& operator=(const PriorityQueue&) = delete;
+
         /**
          * @brief Pushes a new value onto the queue with a time to live and priority
          *
@@ -87,10 +99,8 @@ namespace quicr {
          */
         void Push(DataType& value, uint32_t ttl, uint8_t priority = 0, uint32_t delay_ttl = 0)
         {
-            std::lock_guard<std::mutex> _(mutex_);
-
-            auto& queue = GetQueueByPriority(priority);
-            queue->Push(value, ttl, delay_ttl);
+            CheckPriority(priority);
+            wheel_->Push(queue_, value, ttl, priority, delay_ttl);
         }
 
         /**
@@ -103,123 +113,137 @@ namespace quicr {
          */
         void Push(DataType&& value, uint32_t ttl, uint8_t priority = 0, uint32_t delay_ttl = 0)
         {
-            std::lock_guard<std::mutex> _(mutex_);
-
-            auto& queue = GetQueueByPriority(priority);
-            queue->Push(std::move(value), ttl, delay_ttl);
+            CheckPriority(priority);
+            wheel_->Push(queue_, std::move(value), ttl, priority, delay_ttl);
         }
 
         /**
-         * @brief Get the first object from queue
+         * @brief Pushes a new value constructed from args onto the queue with a time to live and priority
          *
-         * @param elem[out]          Time queue element storage. Will be updated.
+         * @details The value is constructed in the timing wheel entry, so no temporary is copied or moved.
          *
-         * @return TimeQueueElement<DataType> value from time queue
+         * @param ttl       The time to live of the value in milliseconds.
+         * @param priority  The priority of the value (range is 0 - PMAX)
+         * @param delay_ttl Delay POP by this ttl value in milliseconds
+         * @param args      Arguments to construct the value with
          */
-        void Front(TimeQueueElement<DataType>& elem)
+        template<typename... Args>
+        void Emplace(uint32_t ttl, uint8_t priority, uint32_t delay_ttl, Args&&... args)
         {
-            std::lock_guard<std::mutex> _(mutex_);
+            CheckPriority(priority);
+            wheel_->Emplace(queue_, ttl, priority, delay_ttl, std::forward<Args>(args)...);
+        }
 
-            for (auto& tqueue : queue_) {
-                if (!tqueue || tqueue->Empty())
-                    continue;
+        /**
+         * @brief Get a copy of the first object from queue
+         *
+         * @details The returned object is remembered so that the next Pop() removes this object, even
+         *          if an object with a lower priority value was pushed in between.
+         *
+         * @param elem[out]          Time queue element storage. Will be updated.
+         */
+        void Front(TimeQueueElement<DataType>& elem) { wheel_->Front(queue_, elem); }
 
-                tqueue->Front(elem);
-            }
-        }
+        /**
+         * @brief Get a pointer to the first object from queue without copying it
+         *
+         * @details Like Front(), the next Pop() removes this object. The pointer is valid until the
+         *          next access of this queue; the object is not expired before then.
+         *
+         * @param expired_count[out]    Number of objects expired since the last front access
+         *
+         * @returns Pointer to the first object, nullptr if there is none
+         */
+        DataType* PeekRef(uint32_t& expired_count) { return wheel_->PeekRef(queue_, expired_count); }
 
         /**
          * @brief Get and remove the first object from queue
          *
+         * @details The object is moved into the element instead of copied.
+         *
          * @param elem[out]          Time queue element storage. Will be updated.
+         */
+        void PopFront(TimeQueueElement<DataType>& elem) { wheel_->PopFront(queue_, elem); }
+
+        /**
+         * @brief Move the first object out of the queue and remove it
+         *
+         * @param value[out]            Assigned the first object if there is one
+         * @param expired_count[out]    Number of objects expired since the last front access
          *
-         * @return TimeQueueElement<DataType> from time queue
+         * @returns True if an object was popped into value
          */
-        void PopFront(TimeQueueElement<DataType>& elem)
+        bool TryPopInto(DataType& value, uint32_t& expired_count)
         {
-            std::lock_guard<std::mutex> _(mutex_);
-
-            for (auto& tqueue : queue_) {
-                if (!tqueue || tqueue->Empty())
-                    continue;
-
-                tqueue->PopFront(elem);
-            }
+            return wheel_->TryPopInto(queue_, value, expired_count);
         }
 
         /**
-         * @brief Pop/remove the first object from queue
+         * @brief Move the first object out of the queue and remove it if it matches a predicate
+         *
+         * @param value[out]            Assigned the first object if there is one and it matches
+         * @param expired_count[out]    Number of objects expired since the last front access
+         * @param pred                  Predicate called with the first object, returns true to pop it
+         *
+         * @returns True if an object was popped into value
          */
-        void Pop()
+        template<typename Pred>
+        bool TryPopInto(DataType& value, uint32_t& expired_count, Pred&& pred)
         {
-            std::lock_guard<std::mutex> _(mutex_);
-
-            for (auto& tqueue : queue_) {
-                if (tqueue && !tqueue->Empty())
-                    return tqueue->Pop();
-            }
+            return wheel_->TryPopInto(queue_, value, expired_count, std::forward<Pred>(pred));
         }
 
         /**
-         * @brief Clear queue
+         * @brief Pop/remove the first object from queue
+         *
+         * @details Removes the object returned by the last Front(), otherwise the front object of
+         *          the first priority that has objects.
          */
-        void Clear()
-        {
-            std::lock_guard<std::mutex> _(mutex_);
+        void Pop() { wheel_->Pop(queue_); }
 
-            for (auto& tqueue : queue_) {
-                if (tqueue)
-                    tqueue->Clear();
-            }
-        }
+        /**
+         * @brief Clear queue
+         */
+        void Clear() { wheel_->Clear(queue_); }
 
-        // TODO: Consider changing empty/size to look at timeQueue sizes - maybe support blocking pops
-        size_t Size() const
+        /**
+         * @brief Remove the objects that match a predicate
+         *
+         * @details The object returned by the last Front() or PeekRef() is not removed.
+         *
+         * @param pred      Predicate called with each object, returns true to remove the object
+         *
+         * @returns Number of objects removed
+         */
+        template<typename Pred>
+        size_t EraseIf(Pred&& pred)
         {
-            return std::accumulate(queue_.begin(), queue_.end(), 0, [](auto sum, auto& tqueue) {
-                return tqueue ? sum + tqueue->Size() : sum;
-            });
+            return wheel_->EraseIf(queue_, std::forward<Pred>(pred));
         }
 
-        bool Empty() const
-        {
-            for (auto& tqueue : queue_) {
-                if (tqueue && !tqueue->Empty()) {
-                    return false;
-                }
-            }
+        /**
+         * @brief Number of objects in all priorities
+         */
+        size_t Size() const noexcept { return queue_.Size(); }
 
-            return true;
-        }
+        bool Empty() const noexcept { return queue_.Empty(); }
 
-      private:
         /**
-         * @brief Get queue by priority
-         *
-         * @param priority  The priority queue value (range is 0 - PMAX)
+         * @brief Sum of the Size() of the objects in all priorities
          *
-         * @return Unique pointer to queue for the given priority
+         * @details Zero if DataType has no Size() method
          */
-        std::unique_ptr<TimeQueueType>& GetQueueByPriority(const uint8_t priority)
+        size_t Bytes() const noexcept { return queue_.Bytes(); }
+
+      private:
+        void CheckPriority(uint8_t priority) const
         {
             if (priority >= PMAX) {
                 throw InvalidPriorityException("Priority not within range");
             }
-
-            if (!queue_[priority]) {
-                queue_[priority] =
-                  std::make_unique<TimeQueueType>(duration_ms_, interval_ms_, tick_service_, initial_queue_size_);
-            }
-
-            return queue_[priority];
         }
 
-        std::mutex mutex_;
-        size_t initial_queue_size_;
-        size_t duration_ms_;
-        size_t interval_ms_;
-
-        std::array<std::unique_ptr<TimeQueueType>, PMAX> queue_;
-        std::shared_ptr<TickService> tick_service_;
+        std::shared_ptr<WheelType> wheel_;
+        typename WheelType::Queue queue_;
     };
 }; // end of namespace quicr
@@ -89,7 +89,7 @@ namespace quicr {
     {
         std::string tls_cert_filename;               /// QUIC TLS certificate to use
         std::string tls_key_filename;                /// QUIC TLS private key to use
-        uint32_t time_queue_init_queue_size{ 1000 }; /// Initial queue size to reserve upfront
+        uint32_t time_queue_init_queue_size{ 1000 }; /// Initial TX objects to reserve upfront per connection
         uint32_t time_queue_max_duration{ 2000 };    /// Max duration for the time queue in milliseconds
         uint32_t time_queue_bucket_interval{ 1 };    /// The bucket interval in milliseconds
         uint32_t time_queue_rx_size{ 1000 };         /// Receive queue size
@@ -107,6 +107,38 @@ namespace quicr {
         uint8_t quic_priority_limit{ 0 };      /// Lowest priority that will not be bypassed from pacing/CC in picoquic
         std::size_t max_connections{ 1 };
         bool ssl_keylog{ false }; ///< Enable SSL key logging for QUIC connections
+
+        /// Number of server packet loop threads. Connections are sharded across the loops, each with its own
+        /// picoquic context and SO_REUSEPORT socket. Client mode always uses a single loop.
+        uint16_t server_threads{ 1 };
+
+        /// Number of threads that run application callbacks. Callbacks are assigned to a thread by connection,
+        /// which keeps them in order per connection while different connections run in parallel.
+        uint16_t notify_threads{ 1 };
+
+        /// Number of pooled receive buffers per packet loop. Received stream and datagram data is copied into
+        /// a reused buffer instead of a new allocation. Zero disables the pool.
+        uint32_t rx_buffer_pool_size{ 4096 };
+
+        /// Use the batched UDP I/O packet loop, which sends and receives with recvmmsg/sendmmsg and UDP GSO/GRO
+        /// when the kernel supports them. Only supported on Linux, other platforms use the single socket packet
+        /// loop that is also used when this is false.
+        bool use_batch_io{ false };
+
+        /// TX queue budget of each data context in bytes, zero is unlimited. Reliable objects that would take the
+        /// queue over budget are not queued and Enqueue returns TransportError::kQueueFull.
+        uint64_t tx_queue_max_bytes{ 0 };
+
+        /// TX queue budget of each data context in objects, zero is unlimited
+        uint32_t tx_queue_max_objects{ 0 };
+
+        /// Drop pending datagram objects of older groups of a track when a newer group starts. Stream tracks
+        /// always drop the TX queue when a new group starts.
+        bool tx_drop_stale_groups{ false };
+
+        /// Bytes a stream sends per turn before it yields to the other streams of the same priority on the
+        /// connection (deficit round robin). Zero sends streams of the same priority first come first served.
+        uint32_t tx_drr_quantum{ 0 };
     };
 
     /// Stream action that should be done by send/receive processing
@@ -128,6 +160,15 @@ namespace quicr {
         std::shared_ptr<const std::vector<uint8_t>> data;
 
         uint64_t tick_microseconds; // Tick value in microseconds
+
+        /// Optional payload segment sent after data, allows sending a serialized header and the payload without
+        /// combining them into one buffer
+        std::shared_ptr<const std::vector<uint8_t>> payload;
+
+        /**
+         * @brief Total size in bytes of the data and payload segments
+         */
+        std::size_t Size() const noexcept { return (data ? data->size() : 0) + (payload ? payload->size() : 0); }
     };
 
     /// Stream receive data context
@@ -239,6 +280,34 @@ namespace quicr {
             {
             }
 
+            /**
+             * @brief callback notification that the TX queue of a data context is over its budget
+             *
+             * @details Called once after Enqueue returned TransportError::kQueueFull for the data context, and
+             *      again only after OnDataContextDrained. Both are called in order with the other callbacks of
+             *      the connection.
+             *
+             * @param conn_id                       Transport context identifier mapped to the connection
+             * @param data_ctx_id                   Data context ID of the queue
+             */
+            virtual void OnDataContextBackpressure([[maybe_unused]] const TransportConnId& conn_id,
+                                                   [[maybe_unused]] const DataContextId& data_ctx_id)
+            {
+            }
+
+            /**
+             * @brief callback notification that the TX queue of a data context has drained
+             *
+             * @details Called once after OnDataContextBackpressure, when the queue is below half of its budget.
+             *
+             * @param conn_id                       Transport context identifier mapped to the connection
+             * @param data_ctx_id                   Data context ID of the drained queue
+             */
+            virtual void OnDataContextDrained([[maybe_unused]] const TransportConnId& conn_id,
+                                              [[maybe_unused]] const DataContextId& data_ctx_id)
+            {
+            }
+
             /**
              * @brief callback notification on data context metrics sampled
              *
@@ -380,6 +449,51 @@ namespace quicr {
          */
         virtual void SetDataCtxPriority(TransportConnId conn_id, DataContextId data_ctx_id, uint8_t priority) = 0;
 
+        /**
+         * @brief Set the TX queue budget for the data context
+         *
+         * @details Overrides TransportConfig::tx_queue_max_bytes and tx_queue_max_objects for the data context.
+         *      The budget is applied by the transport thread, objects enqueued right after the call may still be
+         *      checked against the previous budget.
+         *
+         * @param conn_id                 Connection ID of the data context ID
+         * @param data_ctx_id             Local data context ID
+         * @param max_bytes               Max bytes of queued objects, zero is unlimited
+         * @param max_objects             Max number of queued objects, zero is unlimited
+         */
+        virtual void SetDataCtxTxBudget(TransportConnId conn_id,
+                                        DataContextId data_ctx_id,
+                                        uint64_t max_bytes,
+                                        uint32_t max_objects) = 0;
+
+        /**
+         * @brief Set the round robin quantum for the data context
+         *
+         * @details Overrides TransportConfig::tx_drr_quantum for the data context. Streams of the same
+         *      priority take turns sending, each turn is up to quantum bytes.
+         *
+         * @param conn_id                 Connection ID of the data context ID
+         * @param data_ctx_id             Local data context ID
+         * @param quantum                 Bytes sent per turn, zero leaves the order to the QUIC stack
+         */
+        virtual void SetDataCtxQuantum(TransportConnId conn_id, DataContextId data_ctx_id, uint32_t quantum) = 0;
+
+        /**
+         * @brief Set the rate limit of the data context
+         *
+         * @details Objects are sent at up to rate_bps, with bursts of up to burst_bytes after the data context
+         *      was idle. The rate is enforced when objects are taken from the TX queue.
+         *
+         * @param conn_id                 Connection ID of the data context ID
+         * @param data_ctx_id             Local data context ID
+         * @param rate_bps                Rate in bits per second, zero is unlimited
+         * @param burst_bytes             Token bucket size in bytes, zero is 100 milliseconds of the rate
+         */
+        virtual void SetDataCtxRateLimit(TransportConnId conn_id,
+                                         DataContextId data_ctx_id,
+                                         uint64_t rate_bps,
+                                         uint32_t burst_bytes) = 0;
+
         /**
          * @brief Set the remote data context id
          * @details sets the remote data context id for data objects transmitted
@@ -401,6 +515,10 @@ namespace quicr {
             bool new_stream{ false };     /// Indicates that a new stream should be created to replace existing one
             bool clear_tx_queue{ false }; /// Indicates that the TX queue should be cleared before adding new object
             bool use_reset{ false };      /// Indicates new stream created will close the previous using reset/abrupt
+
+            /// Indicates the object starts a new group. Pending datagrams of the data context at the same or a
+            /// lower priority are from older groups and are dropped.
+            bool new_group{ false };
         };
 
         /**
@@ -417,7 +535,8 @@ namespace quicr {
          * @param[in] delay_ms          Delay the pop by millisecond value
          * @param[in] flags             Flags for stream and queue handling on enqueue of object
          *
-         * @returns TransportError is returned indicating status of the operation
+         * @returns TransportError is returned indicating status of the operation. kQueueFull if the object was not
+         *          queued because the TX queue of the data context is over budget.
          */
         virtual TransportError Enqueue(const TransportConnId& context_id,
                                        const DataContextId& data_ctx_id,
@@ -425,7 +544,37 @@ namespace quicr {
                                        uint8_t priority = 1,
                                        uint32_t ttl_ms = 350,
                                        uint32_t delay_ms = 0,
-                                       EnqueueFlags flags = { true, false, false, false }) = 0;
+                                       EnqueueFlags flags = { true, false, false, false, false }) = 0;
+
+        /**
+         * Object to enqueue in a batch
+         */
+        struct EnqueueObject
+        {
+            std::shared_ptr<const std::vector<uint8_t>> bytes;      /// Data to send/write
+            uint8_t priority{ 1 };                                  /// Priority of the object, range should be 0 - 255
+            uint32_t ttl_ms{ 350 };                                 /// The age the object should exist in queue in ms
+            EnqueueFlags flags{ true, false, false, false, false }; /// Flags for stream and queue handling of object
+            std::shared_ptr<const std::vector<uint8_t>> payload;    /// Optional payload to send/write after bytes
+        };
+
+        /**
+         * @brief Enqueue a batch of application data objects within the transport
+         *
+         * @details Same as Enqueue() for each object in order, but the connection and data context are
+         *      looked up and locked once for the batch and the stream or datagram is activated once.
+         *      Bytes of the objects are moved into the transport queue. The TX queue budget is checked for the
+         *      whole batch, so either all or none of the reliable objects are queued.
+         *
+         * @param[in] context_id        Identifying the connection
+         * @param[in] data_ctx_id       Data context ID to send the objects on
+         * @param[in] objects           Objects to send/write
+         *
+         * @returns TransportError is returned indicating status of the operation
+         */
+        virtual TransportError EnqueueBatch(const TransportConnId& context_id,
+                                            const DataContextId& data_ctx_id,
+                                            std::span<EnqueueObject> objects) = 0;
 
         /**
          * @brief Dequeue datagram application data from transport buffer
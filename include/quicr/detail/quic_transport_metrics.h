@@ -78,12 +78,18 @@ namespace quicr {
         uint64_t rx_dgrams{ 0 };       ///< count of datagrams received
         uint64_t rx_dgrams_bytes{ 0 }; ///< Number of receive datagram bytes
 
+        uint64_t rx_buffer_pool_hits{ 0 };   ///< count of received data copied into a reused pool buffer
+        uint64_t rx_buffer_pool_misses{ 0 }; ///< count of received data that needed a buffer allocation
+
         uint64_t tx_dgram_cb{ 0 };       ///< count of picoquic callback for datagram can be sent
         uint64_t tx_dgram_ack{ 0 };      ///< count of picoquic callback for acked datagrams
         uint64_t tx_dgram_lost{ 0 };     ///< count of picoquic callback for lost datagrams
         uint64_t tx_dgram_spurious{ 0 }; ///< count of picoquic callback for late/delayed dgram acks
         uint64_t tx_dgram_drops{ 0 };    ///< count of drops due to data context missing
 
+        uint64_t notify_worker{ 0 }; ///< Index of the callback notifier worker that serves the connection
+        MinMaxAvg notify_queue_size; ///< Callback notifier worker queue depth in period
+
         auto operator<=>(const QuicConnectionMetrics&) const = default;
 
         /**
@@ -97,6 +103,7 @@ namespace quicr {
             tx_in_transit_bytes.Clear();
             rtt_us.Clear();
             srtt_us.Clear();
+            notify_queue_size.Clear();
         }
     };
 
@@ -110,13 +117,19 @@ namespace quicr {
         uint64_t tx_buffer_drops{ 0 };   /// Count of write buffer drops of data due to RESET request
         uint64_t tx_queue_discards{ 0 }; /// count of objects discarded due to TTL expiry or clear
         uint64_t tx_queue_expired{ 0 };  /// count of objects expired before pop/front
+        uint64_t tx_queue_full{ 0 };     /// count of objects not queued due to the TX queue budget
+        uint64_t tx_group_drops{ 0 };    /// count of objects dropped because a newer group was queued
 
         uint64_t tx_delayed_callback{ 0 };      /// Count of times transmit callbacks were delayed
         uint64_t prev_tx_delayed_callback{ 0 }; /// Previous transmit delayed callback value, set each interval
         uint64_t tx_reset_wait{ 0 };            /// count of times data context performed a reset and wait
+        uint64_t tx_drr_yields{ 0 };            /// count of times the stream used its round robin turn and yielded
+        uint64_t tx_rate_limited{ 0 };          /// count of times the stream waited for rate limit tokens
+        uint64_t tx_rate_tokens{ 0 };           /// Rate limit tokens in bytes when sampled
         MinMaxAvg tx_queue_size;                /// TX queue size in period
         MinMaxAvg tx_callback_ms;               /// Callback time in milliseconds in period
         MinMaxAvg tx_object_duration_us;        /// TX object time in queue duration in microseconds
+        MinMaxAvg tx_objects_per_callback;      /// Objects written per stream callback in period
 
         uint64_t tx_dgrams{ 0 };       /// count of datagrams sent
         uint64_t tx_dgrams_bytes{ 0 }; /// count of datagrams sent bytes
@@ -135,6 +148,7 @@ namespace quicr {
             tx_queue_size.Clear();
             tx_callback_ms.Clear();
             tx_object_duration_us.Clear();
+            tx_objects_per_callback.Clear();
         }
     };
 
@@ -9,9 +9,11 @@
 
 #include <algorithm>
 #include <any>
-#include <deque>
+#include <array>
+#include <memory>
 #include <mutex>
 #include <optional>
+#include <vector>
 
 namespace quicr {
     struct NullMutex
@@ -21,12 +23,74 @@ namespace quicr {
         constexpr bool try_lock() { return true; }
     };
 
+    /**
+     * @brief Contiguous view of bytes in a chunk of a stream buffer
+     *
+     * @details Holds a reference to the chunk so that the view stays valid after the stream buffer moved past
+     *      the bytes or was cleared. The whole chunk stays alive as long as the view, such as a pooled receive
+     *      buffer for a view of a few bytes. Views that are kept for a long time should be compacted.
+     */
+    template<typename T, class Allocator = std::allocator<T>>
+    class SharedSpan
+    {
+      public:
+        using ChunkType = std::shared_ptr<const std::vector<T, Allocator>>;
+
+        SharedSpan() = default;
+
+        SharedSpan(ChunkType chunk, std::size_t offset, std::size_t length) noexcept
+          : chunk_(std::move(chunk))
+          , span_(chunk_->data() + offset, length)
+        {
+        }
+
+        /**
+         * @brief Chunk that holds the bytes of the view
+         */
+        const ChunkType& Chunk() const noexcept { return chunk_; }
+
+        /**
+         * @brief View of a copy of the bytes in a chunk of their own
+         * @details Returns the view as is when it already covers its whole chunk.
+         */
+        SharedSpan Compact() const
+        {
+            if (!chunk_ || chunk_->size() == span_.size()) {
+                return *this;
+            }
+
+            return { std::make_shared<const std::vector<T, Allocator>>(span_.begin(), span_.end()), 0, span_.size() };
+        }
+
+        std::span<const T> Span() const noexcept { return span_; }
+        operator std::span<const T>() const noexcept { return span_; }
+
+        // NOLINTBEGIN(readability-identifier-naming)
+        const T* data() const noexcept { return span_.data(); }
+        std::size_t size() const noexcept { return span_.size(); }
+        bool empty() const noexcept { return span_.empty(); }
+        auto begin() const noexcept { return span_.begin(); }
+        auto end() const noexcept { return span_.end(); }
+        // NOLINTEND(readability-identifier-naming)
+
+      private:
+        ChunkType chunk_;
+        std::span<const T> span_;
+    };
+
+    /**
+     * @brief Buffer of received stream data
+     *
+     * @details The buffer is a list of refcounted chunks. Received chunks are pushed without copying and
+     *      decoding reads across chunk boundaries with a cursor. Views of the front bytes alias the chunk
+     *      when the bytes are contiguous in it.
+     */
     template<typename T, class Mutex = NullMutex, class Allocator = std::allocator<T>>
     class StreamBuffer
     {
-        using BufferT = std::deque<T, Allocator>;
-
       public:
+        using ChunkType = typename SharedSpan<T, Allocator>::ChunkType;
+
         StreamBuffer() = default;
 
         /**
@@ -95,7 +159,9 @@ namespace quicr {
         void Clear()
         {
             ResetAny();
-            buffer_.clear();
+
+            std::lock_guard _(rw_lock_);
+            ClearInternal();
         }
 
         void ResetAny()
@@ -118,9 +184,9 @@ namespace quicr {
 
         bool AnyHasValueB() { return parsed_dataB_.has_value(); }
 
-        bool Empty() const noexcept { return buffer_.empty(); }
+        bool Empty() const noexcept { return size_ == 0; }
 
-        size_t Size() noexcept { return buffer_.size(); }
+        size_t Size() noexcept { return size_; }
 
         /**
          * @brief Get the first data byte in stream buffer
@@ -128,12 +194,13 @@ namespace quicr {
          */
         std::optional<T> Front() noexcept
         {
-            if (buffer_.empty()) {
+            if (Empty()) {
                 return std::nullopt;
             }
 
             std::lock_guard _(rw_lock_);
-            return buffer_.front();
+            const auto& front = segments_[first_];
+            return (*front.chunk)[front.offset];
         }
 
         /**
@@ -145,7 +212,7 @@ namespace quicr {
          */
         std::vector<T> Front(std::uint32_t length) noexcept
         {
-            if (buffer_.empty()) {
+            if (Empty()) {
                 return std::vector<T>();
             }
 
@@ -154,19 +221,59 @@ namespace quicr {
             return FrontInternal(length);
         }
 
+        /**
+         * @brief View of the first length number of data bytes
+         *
+         * @details The view aliases the chunk holding the bytes when they are contiguous in one chunk,
+         *      otherwise the bytes are copied into a new chunk.
+         *
+         * @param length            Number of data bytes
+         *
+         * @returns view of the data bytes or nullopt if less than length bytes are available
+         */
+        std::optional<SharedSpan<T, Allocator>> FrontView(std::uint32_t length)
+        {
+            if (!Available(length)) {
+                return std::nullopt;
+            }
+
+            std::lock_guard _(rw_lock_);
+
+            return FrontViewInternal(length);
+        }
+
+        /**
+         * @brief Data bytes at the front of the stream buffer that are contiguous in one chunk
+         *
+         * @details Allows decoding from the span without copying. The span is valid until the bytes are
+         *      popped or more data is pushed.
+         *
+         * @returns span of data bytes, empty if no data
+         */
+        std::span<const T> FrontContiguous() noexcept
+        {
+            if (Empty()) {
+                return {};
+            }
+
+            std::lock_guard _(rw_lock_);
+            const auto& front = segments_[first_];
+            return std::span{ *front.chunk }.subspan(front.offset);
+        }
+
         void Pop()
         {
-            if (buffer_.empty()) {
+            if (Empty()) {
                 return;
             }
 
             std::lock_guard _(rw_lock_);
-            buffer_.pop_front();
+            PopInternal(1);
         }
 
         void Pop(std::uint32_t length)
         {
-            if (length == 0 || buffer_.empty()) {
+            if (length == 0 || Empty()) {
                 return;
             }
 
@@ -181,18 +288,18 @@ namespace quicr {
          *
          * @return True if data length is available, false if not.
          */
-        bool Available(std::uint32_t length) const noexcept { return buffer_.size() >= length; }
+        bool Available(std::uint32_t length) const noexcept { return size_ >= length; }
 
         void Push(const T& value)
         {
             std::lock_guard _(rw_lock_);
-            buffer_.push_back(value);
+            PushInternal(std::span{ &value, 1 });
         }
 
         void Push(T&& value)
         {
             std::lock_guard _(rw_lock_);
-            buffer_.push_back(std::move(value));
+            PushInternal(std::span<const T>{ &value, 1 });
         }
 
         void Push(std::span<const T> value)
@@ -201,6 +308,25 @@ namespace quicr {
             PushInternal(std::move(value));
         }
 
+        /**
+         * @brief Push a received chunk without copying it
+         *
+         * @details The stream buffer holds a reference to the chunk until all of its bytes are popped
+         *
+         * @param chunk         Chunk of received data
+         */
+        void Push(ChunkType chunk)
+        {
+            if (chunk == nullptr || chunk->empty()) {
+                return;
+            }
+
+            std::lock_guard _(rw_lock_);
+            size_ += chunk->size();
+            segments_.push_back({ std::move(chunk), 0 });
+            tail_.reset();
+        }
+
         void PushLengthBytes(std::span<const T> value)
         {
             std::lock_guard _(rw_lock_);
@@ -239,26 +365,23 @@ namespace quicr {
          */
         std::optional<UintVar> ReadUintV(bool pop = true)
         {
-            if (buffer_.empty()) {
+            if (Empty()) {
                 return std::nullopt;
             }
 
             std::lock_guard _(rw_lock_);
 
-            const auto& uv_msb = buffer_.front();
-            uint64_t uv_len = UintVar::Size(uv_msb);
-
-            if (Available(uv_len)) {
-
-                auto val = UintVar(FrontInternal(uv_len));
-                if (pop) {
-                    PopInternal(uv_len);
-                }
+            std::array<T, sizeof(uint64_t)> bytes;
+            const auto uv_bytes = ReadUintVInternal(bytes);
+            if (uv_bytes.empty()) {
+                return std::nullopt;
+            }
 
-                return val;
+            if (pop) {
+                PopInternal(uv_bytes.size());
             }
 
-            return std::nullopt;
+            return UintVar(uv_bytes);
         }
 
         /**
@@ -273,57 +396,200 @@ namespace quicr {
          */
         std::optional<std::vector<uint8_t>> DecodeBytes()
         {
-            if (buffer_.empty()) {
+            if (Empty()) {
                 return std::nullopt;
             }
 
             std::lock_guard _(rw_lock_);
 
-            const auto& uv_msb = buffer_.front();
-            uint64_t uv_len = UintVar::Size(uv_msb);
+            std::array<T, sizeof(uint64_t)> bytes;
+            const auto uv_bytes = ReadUintVInternal(bytes);
+            if (uv_bytes.empty()) {
+                return std::nullopt;
+            }
+
+            const auto len = uint64_t(UintVar(uv_bytes));
+            if (size_ < uv_bytes.size() + len) {
+                return std::nullopt;
+            }
+
+            PopInternal(uv_bytes.size());
+            auto v = FrontInternal(len);
+            PopInternal(len);
+
+            return v;
+        }
+
+      private:
+        /// Popped segments are erased from the segment list once there are this many and they are half of it
+        static constexpr std::size_t kCompactSegments = 16;
 
-            if (Available(uv_len)) {
-                auto len = UintVar(FrontInternal(uv_len));
-                if (buffer_.size() >= uv_len + uint64_t(len)) {
+        /// Pushed bytes start a new segment once the last segment is this size, bounds the copy when it grows
+        static constexpr std::size_t kMaxTailSize = 64 * 1024;
 
-                    PopInternal(uv_len);
-                    auto v = FrontInternal(uint64_t(len));
-                    PopInternal(uint64_t(len));
+        struct Segment
+        {
+            ChunkType chunk;
+            std::size_t offset{ 0 }; /// Offset of the first byte in the chunk that is not popped
+        };
 
-                    return v;
+        /**
+         * @brief Reads bytes from the front of the buffer across segments without popping them
+         */
+        class Cursor
+        {
+          public:
+            Cursor(const StreamBuffer& buffer) noexcept
+              : segments_(buffer.segments_)
+              , segment_(buffer.first_)
+              , offset_(segment_ < segments_.size() ? segments_[segment_].offset : 0)
+            {
+            }
+
+            /**
+             * @brief Copy the next bytes and move past them
+             *
+             * @param out       Bytes to copy into, all of out is copied
+             *
+             * @return True if the bytes were copied, false if not enough bytes are available
+             */
+            bool Read(std::span<T> out) noexcept
+            {
+                std::size_t copied = 0;
+
+                while (copied < out.size()) {
+                    if (segment_ == segments_.size()) {
+                        return false;
+                    }
+
+                    const auto& chunk = *segments_[segment_].chunk;
+                    const auto len = std::min(out.size() - copied, chunk.size() - offset_);
+                    std::copy_n(chunk.data() + offset_, len, out.data() + copied);
+
+                    copied += len;
+                    offset_ += len;
+
+                    if (offset_ == chunk.size()) {
+                        ++segment_;
+                        offset_ = 0; // Only the first segment has popped bytes
+                    }
                 }
+
+                return true;
             }
 
-            return std::nullopt;
+          private:
+            const std::vector<Segment>& segments_;
+            std::size_t segment_;
+            std::size_t offset_;
+        };
+
+        /**
+         * @brief Read the uintV at the front of the buffer
+         *
+         * @param bytes         Storage for the encoded uintV
+         *
+         * @return Encoded uintV bytes in bytes, empty if not enough bytes are available
+         */
+        inline std::span<const T> ReadUintVInternal(std::array<T, sizeof(uint64_t)>& bytes) noexcept
+        {
+            const auto& front = segments_[first_];
+            const std::span<T> uv_bytes{ bytes.data(), UintVar::Size((*front.chunk)[front.offset]) };
+
+            if (!Cursor(*this).Read(uv_bytes)) {
+                return {};
+            }
+
+            return uv_bytes;
         }
 
-      private:
         inline std::vector<T> FrontInternal(std::uint32_t length) noexcept
         {
-            std::vector<T> result(length);
-            if (buffer_.size() < length)
+            if (size_ < length)
                 return {};
 
-            std::copy_n(buffer_.begin(), length, result.begin());
+            std::vector<T> result(length);
+            Cursor(*this).Read(result);
             return result;
         }
 
-        inline void PopInternal(std::uint32_t length)
+        inline SharedSpan<T, Allocator> FrontViewInternal(std::uint32_t length)
         {
-            if (length >= buffer_.size()) {
-                buffer_.clear();
-            } else {
-                buffer_.erase(buffer_.begin(), buffer_.begin() + length);
+            if (length == 0) {
+                return {};
+            }
+
+            const auto& front = segments_[first_];
+            if (front.chunk->size() - front.offset >= length) {
+                return { front.chunk, front.offset, length };
+            }
+
+            auto chunk = std::make_shared<std::vector<T, Allocator>>(length);
+            Cursor(*this).Read(*chunk);
+            return { std::move(chunk), 0, length };
+        }
+
+        inline void PopInternal(std::size_t length)
+        {
+            if (length >= size_) {
+                ClearInternal();
+                return;
+            }
+
+            size_ -= length;
+
+            while (length != 0) {
+                auto& front = segments_[first_];
+                const auto remaining = front.chunk->size() - front.offset;
+
+                if (length < remaining) {
+                    front.offset += length;
+                    break;
+                }
+
+                length -= remaining;
+                front.chunk.reset();
+                ++first_;
+            }
+
+            if (first_ >= kCompactSegments && first_ * 2 >= segments_.size()) {
+                segments_.erase(segments_.begin(), segments_.begin() + first_);
+                first_ = 0;
             }
         }
 
         inline void PushInternal(std::span<const T> value)
         {
-            buffer_.insert(buffer_.end(), value.begin(), value.end());
+            if (value.empty()) {
+                return;
+            }
+
+            // Bytes are appended to the last segment only if nothing else references it, views alias its data
+            if (tail_ == nullptr || tail_.use_count() > 2 || tail_->size() >= kMaxTailSize) {
+                tail_ = std::make_shared<std::vector<T, Allocator>>();
+                segments_.push_back({ tail_, 0 });
+            }
+
+            tail_->insert(tail_->end(), value.begin(), value.end());
+            size_ += value.size();
+        }
+
+        inline void ClearInternal() noexcept
+        {
+            segments_.clear();
+            tail_.reset();
+            first_ = 0;
+            size_ = 0;
         }
 
       private:
-        BufferT buffer_;
+        std::vector<Segment> segments_; /// Chunks of the stream, segments before first_ are popped
+        std::size_t first_{ 0 };        /// Index of the first segment that is not popped
+        std::size_t size_{ 0 };         /// Number of bytes not popped
+
+        /// Last segment when it was copied into by the buffer, pushed bytes are appended to it
+        std::shared_ptr<std::vector<T, Allocator>> tail_;
+
         Mutex rw_lock_;
         std::any parsed_data_;                     /// Working buffer for parsed data
         std::any parsed_dataB_;                    /// Second Working buffer for parsed data
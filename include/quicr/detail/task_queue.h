@@ -0,0 +1,348 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace quicr {
+
+    /**
+     * @brief Bounded multi-producer single-consumer queue of tasks
+     *
+     * @details Tasks are callables that are stored in place in fixed size records of a ring. Pushing a task
+     *      does not allocate or lock. Producers reserve a record using a sequence number per record and
+     *      the single consumer runs the tasks in order without locking.
+     *
+     *      Unlike SafeQueue, a full queue rejects the new task instead of dropping the oldest one. Tasks that
+     *      must not be lost are pushed with PushOrOverflow(), which falls back to a locked overflow queue
+     *      while the ring is full.
+     *
+     *      A task that throws is removed from the queue before the exception is passed to the consumer.
+     *
+     * @tparam TaskSize     Max size in bytes of a task callable. Larger callables fail to compile.
+     */
+    template<std::size_t TaskSize = 96>
+    class TaskQueue
+    {
+        struct alignas(64) Record
+        {
+            std::atomic<uint64_t> sequence{ 0 };         /// Ring position the record is ready for
+            void (*op)(void* task, bool run){ nullptr }; /// Runs (optional) and destroys the stored task
+            alignas(std::max_align_t) std::byte task[TaskSize];
+        };
+
+      public:
+        /**
+         * @brief Construct the task queue
+         *
+         * @param capacity      Number of tasks the queue can hold, rounded up to a power of two
+         */
+        explicit TaskQueue(std::size_t capacity = 2048)
+        {
+            capacity_ = 1;
+            while (capacity_ < capacity) {
+                capacity_ <<= 1;
+            }
+
+            mask_ = capacity_ - 1;
+            records_ = std::make_unique<Record[]>(capacity_);
+
+            for (std::size_t i = 0; i < capacity_; i++) {
+                records_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        TaskQueue(const TaskQueue&) = delete;
+        TaskQueue& operator=(const TaskQueue&) = delete;
+
+        ~TaskQueue()
+        {
+            StopWaiting();
+            Clear();
+        }
+
+        /**
+         * @brief Push a task to the end of the queue
+         *
+         * @details Safe to be called by many threads at the same time.
+         *
+         * @param task          Callable with no arguments to run by the consumer
+         *
+         * @return True if pushed, false if the queue is full or has overflow tasks pending
+         */
+        template<typename F>
+        bool Push(F&& task)
+        {
+            using TaskType = std::decay_t<F>;
+            static_assert(sizeof(TaskType) <= TaskSize, "Task is too large for the task queue record");
+            static_assert(alignof(TaskType) <= alignof(std::max_align_t), "Task alignment is not supported");
+
+            // Overflow tasks run after the ring, so new tasks wait behind them to keep tasks in order
+            if (overflow_size_.load(std::memory_order_acquire) != 0) {
+                return false;
+            }
+
+            uint64_t pos = push_pos_.load(std::memory_order_relaxed);
+            Record* record;
+
+            while (true) {
+                record = &records_[pos & mask_];
+                const uint64_t seq = record->sequence.load(std::memory_order_acquire);
+                const auto diff = static_cast<int64_t>(seq - pos);
+
+                if (diff == 0) {
+                    if (push_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false; // Full
+                } else {
+                    pos = push_pos_.load(std::memory_order_relaxed);
+                }
+            }
+
+            new (record->task) TaskType(std::forward<F>(task));
+            record->op = [](void* ptr, bool run) {
+                auto* t = std::launder(reinterpret_cast<TaskType*>(ptr));
+                if (run) {
+                    try {
+                        (*t)();
+                    } catch (...) {
+                        t->~TaskType();
+                        throw;
+                    }
+                }
+                t->~TaskType();
+            };
+
+            record->sequence.store(pos + 1, std::memory_order_release);
+
+            WakeConsumer();
+
+            return true;
+        }
+
+        /**
+         * @brief Push a task to the end of the queue, using the overflow queue if the ring is full
+         *
+         * @details The task is never rejected. Overflow tasks are allocated and pushed under a lock, so this
+         *      is only slower than Push() while the ring is full or overflow tasks are pending.
+         *
+         * @param task          Callable with no arguments to run by the consumer
+         *
+         * @return True if pushed to the ring, false if pushed to the overflow queue
+         */
+        template<typename F>
+        bool PushOrOverflow(F&& task)
+        {
+            // A rejected push does not move from the task
+            if (Push(std::forward<F>(task))) {
+                return true;
+            }
+
+            {
+                std::lock_guard<std::mutex> _(overflow_mutex_);
+                overflow_.emplace_back(std::forward<F>(task));
+                overflow_size_.fetch_add(1, std::memory_order_release);
+            }
+
+            WakeConsumer();
+
+            return false;
+        }
+
+        /**
+         * @brief Run the task at the front of the queue
+         *
+         * @details Must only be called by the single consumer thread.
+         *
+         * @return True if a task was run, false if the queue is empty
+         */
+        bool RunOne() { return PopInternal(true); }
+
+        /**
+         * @brief Run all tasks in the queue, including tasks pushed while running
+         *
+         * @return Number of tasks that were run
+         */
+        std::size_t RunAll()
+        {
+            std::size_t count = 0;
+            while (PopInternal(true)) {
+                count++;
+            }
+
+            return count;
+        }
+
+        /**
+         * @brief Block waiting for a task, then run it
+         *
+         * @details Due to StopWaiting, it's possible that no task was run when unblocked.
+         *
+         * @return True if a task was run, false if not
+         */
+        bool BlockRun()
+        {
+            while (!stop_waiting_.load(std::memory_order_acquire)) {
+                if (PopInternal(true)) {
+                    return true;
+                }
+
+                const auto signal = signal_.load(std::memory_order_acquire);
+                waiting_.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                if (PopInternal(true)) {
+                    waiting_.store(false, std::memory_order_relaxed);
+                    return true;
+                }
+
+                if (!stop_waiting_.load(std::memory_order_acquire)) {
+                    signal_.wait(signal, std::memory_order_acquire);
+                }
+
+                waiting_.store(false, std::memory_order_relaxed);
+            }
+
+            return false;
+        }
+
+        /**
+         * @brief Put the queue in a state such that the consumer will not wait
+         */
+        void StopWaiting()
+        {
+            stop_waiting_.store(true, std::memory_order_release);
+            signal_.fetch_add(1, std::memory_order_release);
+            signal_.notify_all();
+        }
+
+        /**
+         * @brief Destroy all pending tasks without running them
+         *
+         * @details Must only be called by the consumer thread or when there are no other users.
+         */
+        void Clear()
+        {
+            while (PopInternal(false)) {
+            }
+        }
+
+        /**
+         * @brief Approximate number of tasks in the queue, including overflow tasks
+         */
+        std::size_t Size() const
+        {
+            const auto push_pos = push_pos_.load(std::memory_order_relaxed);
+            const auto pop_pos = pop_pos_.load(std::memory_order_relaxed);
+            return (push_pos > pop_pos ? push_pos - pop_pos : 0) + OverflowSize();
+        }
+
+        /**
+         * @brief Number of tasks in the overflow queue
+         */
+        std::size_t OverflowSize() const noexcept { return overflow_size_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Check if queue is empty
+         */
+        bool Empty() const { return Size() == 0; }
+
+        /**
+         * @brief Max number of tasks the queue can hold
+         */
+        std::size_t Capacity() const noexcept { return capacity_; }
+
+      private:
+        void WakeConsumer()
+        {
+            // Wake the consumer if it is waiting in BlockRun
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiting_.load(std::memory_order_relaxed)) {
+                signal_.fetch_add(1, std::memory_order_release);
+                signal_.notify_one();
+            }
+        }
+
+        bool PopInternal(bool run)
+        {
+            const uint64_t pos = pop_pos_.load(std::memory_order_relaxed);
+            Record& record = records_[pos & mask_];
+
+            if (record.sequence.load(std::memory_order_acquire) != pos + 1) {
+                // Overflow tasks were pushed after all tasks in the ring, so the ring must be empty to run them
+                if (push_pos_.load(std::memory_order_acquire) != pos) {
+                    return false; // Producer has not finished writing
+                }
+
+                return overflow_size_.load(std::memory_order_acquire) != 0 && PopOverflow(run);
+            }
+
+            // Task is run in place, the record is released to producers after it's destroyed
+            const auto release = [&] {
+                record.op = nullptr;
+                record.sequence.store(pos + capacity_, std::memory_order_release);
+                pop_pos_.store(pos + 1, std::memory_order_relaxed);
+            };
+
+            try {
+                record.op(record.task, run);
+            } catch (...) {
+                release();
+                throw;
+            }
+
+            release();
+
+            return true;
+        }
+
+        bool PopOverflow(bool run)
+        {
+            std::function<void()> task;
+            {
+                std::lock_guard<std::mutex> _(overflow_mutex_);
+                if (overflow_.empty()) {
+                    return false;
+                }
+
+                task = std::move(overflow_.front());
+                overflow_.pop_front();
+                overflow_size_.fetch_sub(1, std::memory_order_release);
+            }
+
+            if (run) {
+                task();
+            }
+
+            return true;
+        }
+
+        std::unique_ptr<Record[]> records_;
+        std::size_t capacity_{ 0 };
+        std::size_t mask_{ 0 };
+
+        alignas(64) std::atomic<uint64_t> push_pos_{ 0 };
+        alignas(64) std::atomic<uint64_t> pop_pos_{ 0 };
+
+        std::mutex overflow_mutex_;
+        std::deque<std::function<void()>> overflow_; /// Tasks pushed while the ring was full
+        std::atomic<std::size_t> overflow_size_{ 0 };
+
+        std::atomic<bool> waiting_{ false };
+        std::atomic<bool> stop_waiting_{ false };
+        std::atomic<uint32_t> signal_{ 0 };
+    };
+
+} // namespace quicr
@@ -5,14 +5,12 @@
  *  time_queue.h
  *
  *  Description:
- *      A time based queue, where the length of the queue is a duration,
- *      divided into buckets based on a given time interval. As time
- *      progresses, buckets in the past are cleared, and the main queue
- *      is updated so that the front only returns a valid object that
- *      has not expired. To improve performance, buckets are only cleared
- *      on push or pop operations. Thus, buckets in the past can be
- *      cleared in bulk based on how many we should have advanced since
- *      the last time we updated.
+ *      A time based queue, where the length of the queue is a duration.
+ *      Values are kept in push order in a ring of records that hold the
+ *      value with its expiry and pop wait ticks. Expired values are
+ *      dropped from the front as time progresses. Clearing only touches
+ *      the values still in the queue, so it does not depend on the
+ *      duration of the queue.
  *
  *  Portability Issues:
  *      None.
@@ -20,10 +18,14 @@
 
 #pragma once
 
-#include <atomic>
+#include <algorithm>
+#include <bit>
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "tick_service.h"
@@ -51,7 +53,7 @@ namespace quicr {
     template<typename T, typename Duration_t>
     class TimeQueue
     {
-        static constexpr uint32_t kMaxBuckets = 1000; /// Maximum number of buckets allowed
+        static constexpr std::size_t kMinCapacity = 16; /// Ring capacity allocated on first push when not reserved
 
         /*=======================================================================*/
         // Time queue type assertions
@@ -72,27 +74,15 @@ namespace quicr {
         /*=======================================================================*/
 
         using TickType = TickService::TickType;
-        using BucketType = std::vector<T>;
-        using IndexType = std::uint32_t;
 
-        struct QueueValueType
+        /// Queued value with its ticks, stored in push order in the ring
+        struct Record
         {
-            QueueValueType(BucketType& bucket, IndexType value_index, TickType expiry_tick, TickType wait_for_tick)
-              : bucket{ bucket }
-              , value_index{ value_index }
-              , expiry_tick(expiry_tick)
-              , wait_for_tick(wait_for_tick)
-            {
-            }
-
-            BucketType& bucket;
-            IndexType value_index;
-            TickType expiry_tick;
-            TickType wait_for_tick;
+            T value{};
+            TickType expiry_tick{ 0 };
+            TickType wait_for_tick{ 0 };
         };
 
-        using QueueType = std::vector<QueueValueType>;
-
       public:
         /**
          * @brief Construct a time_queue with defaults or supplied parameters
@@ -106,20 +96,15 @@ namespace quicr {
          */
         TimeQueue(size_t duration, size_t interval, std::shared_ptr<TickService> tick_service)
           : duration_{ duration }
-          , interval_{ (duration / interval > kMaxBuckets ? duration / kMaxBuckets : interval) }
-          , total_buckets_{ duration_ / interval_ }
           , tick_service_(std::move(tick_service))
         {
-            if (duration == 0 || duration % interval != 0 || duration == interval) {
+            if (duration == 0 || interval == 0 || duration % interval != 0 || duration == interval) {
                 throw std::invalid_argument("Invalid time_queue constructor args");
             }
 
             if (!tick_service_) {
                 throw std::invalid_argument("Tick service cannot be null");
             }
-
-            buckets_.resize(total_buckets_);
-            queue_.reserve(total_buckets_);
         }
 
         /**
@@ -140,7 +125,7 @@ namespace quicr {
                   size_t initial_queue_size)
           : TimeQueue(duration, interval, std::move(tick_service))
         {
-            queue_.reserve(initial_queue_size);
+            Reserve(initial_queue_size);
         }
 
         TimeQueue() = delete;
@@ -160,7 +145,7 @@ namespace quicr {
          *
          * @throws std::invalid_argument If ttl is greater than duration.
          */
-        void Push(const T& value, size_t ttl, size_t delay_ttl = 0) { InternalPush(value, ttl, delay_ttl); }
+        void Push(const T& value, size_t ttl, size_t delay_ttl = 0) { InternalPush(ttl, delay_ttl, value); }
 
         /**
          * @brief Pushes a new value onto the queue with a time-to-live.
@@ -172,20 +157,37 @@ namespace quicr {
          *
          * @throws std::invalid_argument If ttl is greater than duration.
          */
-        void Push(T&& value, size_t ttl, size_t delay_ttl = 0) { InternalPush(std::move(value), ttl, delay_ttl); }
+        void Push(T&& value, size_t ttl, size_t delay_ttl = 0) { InternalPush(ttl, delay_ttl, std::move(value)); }
+
+        /**
+         * @brief Pushes a new value constructed from args onto the queue with a time-to-live.
+         *
+         * @details The value is constructed in the ring record, so no temporary is copied or moved.
+         *
+         * @param ttl           Time to live for an object using the unit of Duration_t
+         * @param delay_ttl     Pop wait Time to live for an object using the unit of Duration_t
+         * @param args          Arguments to construct the value with
+         *
+         * @throws std::invalid_argument If ttl is greater than duration.
+         */
+        template<typename... Args>
+        void Emplace(size_t ttl, size_t delay_ttl, Args&&... args)
+        {
+            InternalPush(ttl, delay_ttl, std::forward<Args>(args)...);
+        }
 
         /**
          * @brief Pop (increment) front
          *
          * @details This method should be called after front when the object is processed. This
-         *      will move the queue forward. If at the end of the queue, it'll be cleared and reset.
+         *      will move the queue forward and release the front value.
          */
         void Pop() noexcept
         {
-            if (queue_.empty() || ++queue_index_ < queue_.size())
+            if (Empty())
                 return;
 
-            Clear();
+            ReleaseFront();
         }
 
         /**
@@ -196,130 +198,186 @@ namespace quicr {
         [[nodiscard]] TimeQueueElement<T> PopFront()
         {
             TimeQueueElement<T> obj{};
-            Front(obj);
-            if (obj.has_value) {
-                Pop();
-            }
-
-            return std::move(obj);
+            PopFront(obj);
+            return obj;
         }
 
         /**
          * @brief Pops (removes) the front of the queue using provided storage
          *
+         * @details The front value is moved into the element instead of copied.
+         *
          * @param elem[out]          Time queue element storage. Will be updated.
          */
-        void PopFront(TimeQueueElement<T>& elem)
+        void PopFront(TimeQueueElement<T>& elem) { elem.has_value = TryPopInto(elem.value, elem.expired_count); }
+
+        /**
+         * @brief Move the front value out of the queue and pop it
+         *
+         * @param value[out]            Assigned the front value if there is one
+         * @param expired_count[out]    Number of values expired since the last front access
+         *
+         * @returns True if a value was popped into value
+         */
+        bool TryPopInto(T& value, uint32_t& expired_count)
         {
-            Front(elem);
-            if (elem.has_value) {
-                Pop();
+            auto* record = FrontRecord(expired_count);
+            if (record == nullptr) {
+                return false;
             }
+
+            value = std::move(record->value);
+            ReleaseFront();
+            return true;
         }
 
         /**
          * @brief Returns the most valid front of the queue without popping.
          *
-         * @param elem[out]          Time queue element storage. Will be updated.
+         * @details Expired values at the front are removed. The expired count includes values that expired
+         *      since the last front access.
          *
-         * @returns Element of the front value
+         * @param elem[out]          Time queue element storage. Will be updated.
          */
         void Front(TimeQueueElement<T>& elem)
         {
-            const TickType ticks = Advance();
+            const auto* record = FrontRecord(elem.expired_count);
 
-            elem.has_value = false;
-            elem.expired_count = 0;
+            elem.has_value = record != nullptr;
+            if (elem.has_value) {
+                elem.value = record->value;
+            }
+        }
 
-            if (queue_.empty())
-                return;
+        /**
+         * @brief Returns a pointer to the most valid front of the queue without copying it
+         *
+         * @details Same as Front(), but the value stays in the queue. The pointer is valid until the next
+         *      push, pop or clear.
+         *
+         * @param expired_count[out]    Number of values expired since the last front access
+         *
+         * @returns Pointer to the front value, nullptr if there is none
+         */
+        T* PeekRef(uint32_t& expired_count)
+        {
+            auto* record = FrontRecord(expired_count);
+            return record != nullptr ? &record->value : nullptr;
+        }
 
-            while (queue_index_ < queue_.size()) {
-                auto& [bucket, value_index, expiry_tick, pop_wait_ttl] = queue_.at(queue_index_);
+        size_t Size() const noexcept { return tail_ - head_; }
+        bool Empty() const noexcept { return head_ == tail_; }
 
-                if (value_index >= bucket.size() || ticks > expiry_tick) {
-                    elem.expired_count++;
-                    queue_index_++;
-                    continue;
+        /**
+         * @brief Clear/reset the queue to no objects
+         *
+         * @details Only the values in the queue are released, so the cost is paid for by the pushes of those
+         *      values and does not depend on the duration of the queue.
+         */
+        void Clear() noexcept
+        {
+            if constexpr (std::is_trivially_destructible_v<T>) {
+                head_ = tail_;
+            } else {
+                while (!Empty()) {
+                    ReleaseFront();
                 }
+            }
+        }
 
-                if (pop_wait_ttl > ticks) {
-                    return;
-                }
+      protected:
+        /**
+         * @brief Update the current tick value
+         *
+         * @returns Current tick value at time of advance
+         */
+        TickType Advance()
+        {
+            current_ticks_ = tick_service_->Milliseconds();
+            return current_ticks_;
+        }
 
-                elem.has_value = true;
-                elem.value = bucket.at(value_index);
-                return;
+        /**
+         * @brief Release the front value and move the front forward
+         */
+        void ReleaseFront() noexcept
+        {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                ring_[head_ & mask_].value = T{};
             }
 
-            Clear();
+            ++head_;
         }
 
-        size_t Size() const noexcept { return queue_.size() - queue_index_; }
-        bool Empty() const noexcept { return queue_.empty() || queue_index_ >= queue_.size(); }
-
         /**
-         * @brief Clear/reset the queue to no objects
+         * @brief Grow the ring to hold at least count values, keeping the queued values in order
          */
-        void Clear() noexcept
+        void Reserve(size_t count)
         {
-            if (queue_.empty())
+            if (count <= ring_.size()) {
                 return;
+            }
 
-            queue_.clear();
+            const auto capacity = std::bit_ceil(count);
+            std::vector<Record> ring(capacity);
 
-            for (auto& bucket : buckets_) {
-                bucket.clear();
+            for (size_t i = 0; i < Size(); ++i) {
+                ring[i] = std::move(ring_[(head_ + i) & mask_]);
             }
 
-            queue_index_ = bucket_index_ = 0;
+            tail_ = Size();
+            head_ = 0;
+            ring_ = std::move(ring);
+            mask_ = capacity - 1;
         }
 
-      protected:
         /**
-         * @brief Based on current time, adjust and move the bucket index with time
-         *        (sliding window)
+         * @brief Front record that can be popped, removing expired values before it
          *
-         * @returns Current tick value at time of advance
+         * @param expired_count[out]    Number of values expired since the last front access
+         *
+         * @returns Front record, nullptr if the queue is empty or the front is waiting on its pop delay
          */
-        TickType Advance()
+        Record* FrontRecord(uint32_t& expired_count)
         {
-            const TickType new_ticks = tick_service_->Milliseconds();
-            TickType delta = current_ticks_ ? new_ticks - current_ticks_ : 0;
-            current_ticks_ = new_ticks;
+            const TickType ticks = Advance();
 
-            if (delta == 0)
-                return current_ticks_;
+            expired_count = std::exchange(expired_count_, 0);
 
-            delta /= interval_; // relative delta based on interval
+            while (!Empty()) {
+                auto& record = ring_[head_ & mask_];
 
-            if (delta >= static_cast<TickType>(total_buckets_)) {
-                Clear();
-                return current_ticks_;
-            }
+                if (ticks > record.expiry_tick) {
+                    expired_count++;
+                    ReleaseFront();
+                    continue;
+                }
 
-            bucket_index_ = (bucket_index_ + delta) % total_buckets_;
-            if (!buckets_[bucket_index_].empty())
-                buckets_[bucket_index_].clear();
+                if (record.wait_for_tick > ticks) {
+                    return nullptr;
+                }
 
-            return current_ticks_;
+                return &record;
+            }
+
+            return nullptr;
         }
 
         /**
-         * @brief Pushes new element onto the queue and adds it to future bucket.
+         * @brief Pushes new element onto the back of the ring.
          *
-         * @details Internal definition of push. Pushes value into specified
-         *          bucket, and then emplaces the location info into the queue.
+         * @details Internal definition of push. Expired values at the front are removed first so that they
+         *          are released even when the queue is not popped.
          *
-         * @param value         The value to push onto the queue.
          * @param ttl           Time to live for an object using the unit of Duration_t
          * @param delay_ttl     Pop wait Time to live for an object using the unit of Duration_t
          *                      This will cause pop to be delayed by this TTL value
+         * @param args          Value to push, or arguments to construct it with
          *
          * @throws std::invalid_argument If ttl is greater than duration.
          */
-        template<typename Value>
-        inline void InternalPush(Value value, size_t ttl, size_t delay_ttl)
+        template<typename... Args>
+        inline void InternalPush(size_t ttl, size_t delay_ttl, Args&&... args)
         {
             if (ttl > duration_) {
                 throw std::invalid_argument("TTL is greater than max duration");
@@ -329,45 +387,50 @@ namespace quicr {
                 ttl = duration_;
             }
 
-            auto relative_ttl = ttl / interval_;
-
             const TickType ticks = Advance();
 
-            const TickType expiry_tick = ticks + ttl;
-
-            const IndexType future_index = (bucket_index_ + relative_ttl - 1) % total_buckets_;
+            while (!Empty() && ticks > ring_[head_ & mask_].expiry_tick) {
+                expired_count_++;
+                ReleaseFront();
+            }
 
-            BucketType& bucket = buckets_[future_index];
+            if (Size() == ring_.size()) {
+                Reserve(std::max(kMinCapacity, ring_.size() * 2));
+            }
 
-            bucket.push_back(value);
-            queue_.emplace_back(bucket, bucket.size() - 1, expiry_tick, ticks + delay_ttl);
+            auto& record = ring_[tail_ & mask_];
+            if constexpr (std::is_constructible_v<T, Args&&...>) {
+                record.value = T(std::forward<Args>(args)...);
+            } else {
+                record.value = T{ std::forward<Args>(args)... };
+            }
+            record.expiry_tick = ticks + ttl;
+            record.wait_for_tick = ticks + delay_ttl;
+            ++tail_;
         }
 
       protected:
         /// The duration in ticks of the entire queue.
         const size_t duration_;
 
-        /// The interval at which buckets are cleared in ticks.
-        const size_t interval_;
+        /// Ring of queued values in push order. Capacity is a power of two.
+        std::vector<Record> ring_;
+
+        /// Mask of ring capacity to map positions to ring indexes.
+        size_t mask_{ 0 };
 
-        /// The total amount of buckets. Value is calculated by duration / interval.
-        const size_t total_buckets_;
+        /// Position of the front value. Positions only increase, the ring index is position & mask.
+        size_t head_{ 0 };
 
-        /// The index in time of the current bucket.
-        IndexType bucket_index_{ 0 };
+        /// Position after the back value.
+        size_t tail_{ 0 };
 
-        /// The index of the first valid item in the queue.
-        IndexType queue_index_{ 0 };
+        /// Number of values expired on push, reported on the next front access.
+        uint32_t expired_count_{ 0 };
 
         /// Last calculated tick value.
         TickType current_ticks_{ 0 };
 
-        /// The memory storage for all elements to be managed.
-        std::vector<BucketType> buckets_;
-
-        /// The FIFO ordered queue of values as they were inserted.
-        QueueType queue_;
-
         /// Tick service for calculating new tick and jumps in time.
         std::shared_ptr<TickService> tick_service_;
     };
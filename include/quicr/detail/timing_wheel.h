@@ -0,0 +1,617 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "tick_service.h"
+#include "time_queue.h"
+
+namespace quicr {
+
+    /**
+     * @brief Hierarchical timing wheel that expires the queued objects of many queues
+     *
+     * @details One wheel is shared by all the transmit queues of a connection. Objects of all queues are
+     *      stored in one entry table owned by the wheel. Each queue only keeps the head and tail of an
+     *      intrusive FIFO per priority, so a queue costs a few hundred bytes no matter the duration. The FIFOs
+     *      are allocated on the first push, so a queue that never had objects costs less than a hundred bytes.
+     *
+     *      The wheel has three levels of 256 slots. Level 0 slots are one interval each. Entries further
+     *      in the future are in level 1 or 2 and are moved down a level when the lower level wraps. Advancing
+     *      the wheel only visits slots for the elapsed intervals and expires the entries in them, and is
+     *      skipped when the wheel is empty.
+     *
+     *      Entries are allocated in chunks that never move, so a reference to the front object stays valid
+     *      while other threads push. The entry returned by the last front access of a queue is pinned and
+     *      not expired by the wheel until the queue is accessed again.
+     *
+     *      All methods are thread safe. Queue sizes can be read without the lock.
+     *
+     * @tparam T        The element type to be stored.
+     * @tparam PMAX     Max priorities to allow - Range becomes 0 - PMAX
+     */
+    template<typename T, uint8_t PMAX = 32>
+    class TimingWheel
+    {
+        static_assert(PMAX <= 64, "Priorities must fit in the 64 bit active priority mask");
+
+        using TickType = TickService::TickType;
+        using Index = uint32_t;
+
+        static constexpr Index kNone = std::numeric_limits<Index>::max();
+        static constexpr std::size_t kSlotBits = 8;
+        static constexpr std::size_t kSlots = 1 << kSlotBits; /// Slots per level
+        static constexpr std::size_t kSlotMask = kSlots - 1;
+        static constexpr std::size_t kLevels = 3;
+        static constexpr std::size_t kChunkBits = 8;
+        static constexpr std::size_t kChunkSize = 1 << kChunkBits; /// Entries allocated at a time
+
+        /// Intrusive FIFO of entries for one priority of a queue
+        struct Fifo
+        {
+            Index head{ kNone };
+            Index tail{ kNone };
+        };
+
+      public:
+        /**
+         * @brief Queue of objects stored in the wheel
+         *
+         * @details Owned by the user of the wheel, must not move while it has objects.
+         */
+        class Queue
+        {
+          public:
+            size_t Size() const noexcept { return size_.load(std::memory_order_relaxed); }
+            bool Empty() const noexcept { return Size() == 0; }
+
+            /// Sum of the Size() of the objects in the queue, zero if the objects have no Size() method
+            size_t Bytes() const noexcept { return bytes_.load(std::memory_order_relaxed); }
+
+          private:
+            friend class TimingWheel;
+
+            std::unique_ptr<std::array<Fifo, PMAX>> fifos_; /// FIFO per priority, allocated on first push
+            uint64_t active_mask_{ 0 };                     /// Bit per priority that has objects
+            uint32_t expired_count_{ 0 };                   /// Objects expired by the wheel, reported on next front
+            Index front_{ kNone };                          /// Entry of the last front, not expired until popped
+            std::atomic<size_t> size_{ 0 };                 /// Objects in all priorities, read without the lock
+            std::atomic<size_t> bytes_{ 0 };                /// Object bytes in all priorities, read without the lock
+        };
+
+        /**
+         * @brief Construct a timing wheel
+         *
+         * @param duration              Max time to live of objects in milliseconds
+         * @param interval              Interval of each level 0 slot in milliseconds
+         * @param tick_service          Shared pointer to tick_service service
+         * @param initial_queue_size    Number of objects to reserve for all queues
+         *
+         * @throws std::invalid_argument If the duration or interval do not meet requirements or the tick_service is
+         *                               null.
+         */
+        TimingWheel(size_t duration,
+                    size_t interval,
+                    std::shared_ptr<TickService> tick_service,
+                    size_t initial_queue_size = 0)
+          : duration_(duration)
+          , interval_(interval)
+          , tick_service_(std::move(tick_service))
+        {
+            if (duration == 0 || interval == 0 || duration / interval >= kSlots * kSlots) {
+                throw std::invalid_argument("Invalid timing wheel duration or interval");
+            }
+
+            if (!tick_service_) {
+                throw std::invalid_argument("Tick service cannot be null");
+            }
+
+            current_tick_ = tick_service_->Milliseconds() / interval_;
+            slots_.fill(kNone);
+
+            while (capacity_ < initial_queue_size) {
+                AddChunk();
+            }
+        }
+
+        TimingWheel(const TimingWheel&) = delete;
+        TimingWheel& operator=(const TimingWheel&) = delete;
+
+        /**
+         * @brief Push a new object to the back of a queue
+         *
+         * @param queue     Queue to push to
+         * @param value     The value to push onto the queue
+         * @param ttl       Time to live of the value in milliseconds. Zero is the wheel duration.
+         * @param priority  The priority of the value (range is 0 - PMAX)
+         * @param delay_ttl Delay pop by this ttl value in milliseconds
+         *
+         * @throws std::invalid_argument If ttl is greater than duration or the priority is not within range.
+         */
+        template<typename Value>
+        void Push(Queue& queue, Value&& value, size_t ttl, uint8_t priority, size_t delay_ttl)
+        {
+            Emplace(queue, ttl, priority, delay_ttl, std::forward<Value>(value));
+        }
+
+        /**
+         * @brief Push a new object constructed from args to the back of a queue
+         *
+         * @param queue     Queue to push to
+         * @param ttl       Time to live of the value in milliseconds. Zero is the wheel duration.
+         * @param priority  The priority of the value (range is 0 - PMAX)
+         * @param delay_ttl Delay pop by this ttl value in milliseconds
+         * @param args      Arguments to construct the value with, braced initialization is used
+         *
+         * @throws std::invalid_argument If ttl is greater than duration or the priority is not within range.
+         */
+        template<typename... Args>
+        void Emplace(Queue& queue, size_t ttl, uint8_t priority, size_t delay_ttl, Args&&... args)
+        {
+            if (ttl > duration_) {
+                throw std::invalid_argument("TTL is greater than max duration");
+            }
+
+            if (priority >= PMAX) {
+                throw std::invalid_argument("Priority not within range");
+            }
+
+            if (ttl == 0) {
+                ttl = duration_;
+            }
+
+            std::lock_guard<std::mutex> _(mutex_);
+
+            const TickType ticks = Advance();
+
+            const Index index = AllocateEntry();
+            auto& entry = At(index);
+            if constexpr (std::is_constructible_v<T, Args&&...>) {
+                entry.value = T(std::forward<Args>(args)...);
+            } else {
+                entry.value = T{ std::forward<Args>(args)... };
+            }
+            entry.expire_tick = (ticks + ttl) / interval_ + 1;
+            entry.wait_for_tick = ticks + delay_ttl;
+            entry.queue = &queue;
+            entry.priority = priority;
+
+            if constexpr (requires(const T& value) { value.Size(); }) {
+                entry.bytes = static_cast<uint32_t>(entry.value.Size());
+                queue.bytes_.store(queue.Bytes() + entry.bytes, std::memory_order_relaxed);
+            }
+
+            if (!queue.fifos_) {
+                queue.fifos_ = std::make_unique<std::array<Fifo, PMAX>>();
+            }
+
+            auto& fifo = (*queue.fifos_)[priority];
+            entry.fifo_prev = fifo.tail;
+            entry.fifo_next = kNone;
+            if (fifo.tail != kNone) {
+                At(fifo.tail).fifo_next = index;
+            } else {
+                fifo.head = index;
+            }
+            fifo.tail = index;
+
+            Schedule(index);
+
+            queue.active_mask_ |= uint64_t{ 1 } << priority;
+            queue.size_.store(queue.Size() + 1, std::memory_order_relaxed);
+            ++size_;
+        }
+
+        /**
+         * @brief Get a copy of the first object of a queue
+         *
+         * @details The first object is the front of the lowest priority value whose front is not waiting
+         *      on its pop delay. The object is remembered so that the next Pop() removes this object.
+         *
+         * @param queue         Queue to get the front of
+         * @param elem[out]     Time queue element storage. Expired count is the number of objects of the
+         *                      queue that expired since the last front.
+         */
+        void Front(Queue& queue, TimeQueueElement<T>& elem)
+        {
+            std::lock_guard<std::mutex> _(mutex_);
+
+            queue.front_ = FrontIndex(queue, elem.expired_count);
+            elem.has_value = queue.front_ != kNone;
+            if (elem.has_value) {
+                elem.value = At(queue.front_).value;
+            }
+        }
+
+        /**
+         * @brief Get a pointer to the first object of a queue
+         *
+         * @details The object is not copied. The pointer is valid until the queue is accessed again, and the
+         *      object is not expired until then. Pop() removes this object.
+         *
+         * @param queue                 Queue to get the front of
+         * @param expired_count[out]    Number of objects of the queue that expired since the last front
+         *
+         * @returns Pointer to the first object, nullptr if there is none
+         */
+        T* PeekRef(Queue& queue, uint32_t& expired_count)
+        {
+            std::lock_guard<std::mutex> _(mutex_);
+
+            queue.front_ = FrontIndex(queue, expired_count);
+            return queue.front_ != kNone ? &At(queue.front_).value : nullptr;
+        }
+
+        /**
+         * @brief Move the first object of a queue out and remove it
+         *
+         * @param queue                 Queue to pop from
+         * @param value[out]            Assigned the first object if there is one
+         * @param expired_count[out]    Number of objects of the queue that expired since the last front
+         *
+         * @returns True if an object was popped into value
+         */
+        bool TryPopInto(Queue& queue, T& value, uint32_t& expired_count)
+        {
+            return TryPopInto(queue, value, expired_count, [](const T&) { return true; });
+        }
+
+        /**
+         * @brief Move the first object of a queue out and remove it if it matches a predicate
+         *
+         * @param queue                 Queue to pop from
+         * @param value[out]            Assigned the first object if there is one and it matches
+         * @param expired_count[out]    Number of objects of the queue that expired since the last front
+         * @param pred                  Predicate called with the first object, returns true to pop it
+         *
+         * @returns True if an object was popped into value
+         */
+        template<typename Pred>
+        bool TryPopInto(Queue& queue, T& value, uint32_t& expired_count, Pred&& pred)
+        {
+            std::lock_guard<std::mutex> _(mutex_);
+
+            const auto index = FrontIndex(queue, expired_count);
+            if (index == kNone || !pred(std::as_const(At(index).value))) {
+                return false;
+            }
+
+            value = std::move(At(index).value);
+            Remove(index);
+            return true;
+        }
+
+        /**
+         * @brief Move the first object of a queue out and remove it
+         *
+         * @param queue         Queue to pop from
+         * @param elem[out]     Time queue element storage. Expired count is the number of objects of the
+         *                      queue that expired since the last front.
+         */
+        void PopFront(Queue& queue, TimeQueueElement<T>& elem)
+        {
+            elem.has_value = TryPopInto(queue, elem.value, elem.expired_count);
+        }
+
+        /**
+         * @brief Remove the object returned by the last front access, otherwise the front object of the first
+         *        priority that has objects
+         */
+        void Pop(Queue& queue)
+        {
+            std::lock_guard<std::mutex> _(mutex_);
+
+            if (const auto index = std::exchange(queue.front_, kNone); index != kNone) {
+                Remove(index);
+            } else if (queue.active_mask_ != 0) {
+                Remove((*queue.fifos_)[std::countr_zero(queue.active_mask_)].head);
+            }
+        }
+
+        /**
+         * @brief Remove all objects of a queue
+         */
+        void Clear(Queue& queue)
+        {
+            std::lock_guard<std::mutex> _(mutex_);
+
+            queue.front_ = kNone;
+            while (queue.active_mask_ != 0) {
+                Remove((*queue.fifos_)[std::countr_zero(queue.active_mask_)].head);
+            }
+        }
+
+        /**
+         * @brief Remove the objects of a queue that match a predicate
+         *
+         * @details Visits every object of the queue. The object returned by the last front access is not removed,
+         *      so a reference from PeekRef() stays valid.
+         *
+         * @param queue     Queue to remove objects from
+         * @param pred      Predicate called with each object, returns true to remove the object
+         *
+         * @returns Number of objects removed
+         */
+        template<typename Pred>
+        size_t EraseIf(Queue& queue, Pred&& pred)
+        {
+            std::lock_guard<std::mutex> _(mutex_);
+
+            size_t removed = 0;
+            for (auto mask = queue.active_mask_; mask != 0; mask &= mask - 1) {
+                auto index = (*queue.fifos_)[std::countr_zero(mask)].head;
+
+                while (index != kNone) {
+                    const auto next = At(index).fifo_next;
+
+                    if (index != queue.front_ && pred(std::as_const(At(index).value))) {
+                        Remove(index);
+                        removed++;
+                    }
+
+                    index = next;
+                }
+            }
+
+            return removed;
+        }
+
+        /**
+         * @brief Number of objects in all queues
+         */
+        size_t Size()
+        {
+            std::lock_guard<std::mutex> _(mutex_);
+            return size_;
+        }
+
+      private:
+        struct Entry
+        {
+            T value{};
+            TickType expire_tick{ 0 };   /// Wheel tick the entry is expired at
+            TickType wait_for_tick{ 0 }; /// Millisecond tick the entry can be popped at
+            Queue* queue{ nullptr };     /// Queue of the entry, null if the entry is free
+            Index fifo_prev{ kNone };
+            Index fifo_next{ kNone };
+            Index slot_prev{ kNone };
+            Index slot_next{ kNone }; /// Next entry in the slot, or next free entry
+            uint32_t bytes{ 0 }; /// Size of the value when it was pushed, counted in the queue bytes
+            uint16_t slot{ 0 };
+            uint8_t priority{ 0 };
+            bool scheduled{ false }; /// Entry is in a slot, false once expired while pinned as a queue front
+        };
+
+        /**
+         * @brief Advance the wheel to the current time and expire entries in the elapsed slots
+         *
+         * @returns Current tick value in milliseconds
+         */
+        TickType Advance()
+        {
+            const TickType ticks = tick_service_->Milliseconds();
+            const TickType wheel_tick = ticks / interval_;
+
+            while (current_tick_ < wheel_tick) {
+                if (size_ == 0) {
+                    current_tick_ = wheel_tick;
+                    break;
+                }
+
+                ++current_tick_;
+
+                if ((current_tick_ & kSlotMask) == 0) {
+                    if (((current_tick_ >> kSlotBits) & kSlotMask) == 0) {
+                        Cascade(2 * kSlots + ((current_tick_ >> (2 * kSlotBits)) & kSlotMask));
+                    }
+                    Cascade(kSlots + ((current_tick_ >> kSlotBits) & kSlotMask));
+                }
+
+                // Level 0 slot only has entries that expire at the current tick
+                auto& slot = slots_[current_tick_ & kSlotMask];
+                while (slot != kNone) {
+                    auto& queue = *At(slot).queue;
+
+                    // Pinned front is expired on the next access of its queue
+                    if (queue.front_ == slot) {
+                        Unschedule(slot);
+                        continue;
+                    }
+
+                    queue.expired_count_++;
+                    Remove(slot);
+                }
+            }
+
+            return ticks;
+        }
+
+        /**
+         * @brief Move the entries of a level 1 or 2 slot to lower levels
+         */
+        void Cascade(std::size_t slot)
+        {
+            Index index = std::exchange(slots_[slot], kNone);
+            while (index != kNone) {
+                const Index next = At(index).slot_next;
+                Schedule(index);
+                index = next;
+            }
+        }
+
+        /**
+         * @brief Add entry to the slot of its expire tick
+         *
+         * @details Level is the lowest level where the expire tick and current tick differ only in the bits
+         *      of that level. Expire tick is never more than 2^16 ticks ahead, so it fits in three levels.
+         */
+        void Schedule(Index index)
+        {
+            auto& entry = At(index);
+
+            std::size_t slot;
+            if ((entry.expire_tick >> kSlotBits) == (current_tick_ >> kSlotBits)) {
+                slot = entry.expire_tick & kSlotMask;
+            } else if ((entry.expire_tick >> (2 * kSlotBits)) == (current_tick_ >> (2 * kSlotBits))) {
+                slot = kSlots + ((entry.expire_tick >> kSlotBits) & kSlotMask);
+            } else {
+                slot = 2 * kSlots + ((entry.expire_tick >> (2 * kSlotBits)) & kSlotMask);
+            }
+
+            entry.slot = static_cast<uint16_t>(slot);
+            entry.slot_prev = kNone;
+            entry.slot_next = slots_[slot];
+            entry.scheduled = true;
+            if (slots_[slot] != kNone) {
+                At(slots_[slot]).slot_prev = index;
+            }
+            slots_[slot] = index;
+        }
+
+        /**
+         * @brief Unlink entry from its slot
+         */
+        void Unschedule(Index index)
+        {
+            auto& entry = At(index);
+
+            if (entry.slot_prev != kNone) {
+                At(entry.slot_prev).slot_next = entry.slot_next;
+            } else {
+                slots_[entry.slot] = entry.slot_next;
+            }
+
+            if (entry.slot_next != kNone) {
+                At(entry.slot_next).slot_prev = entry.slot_prev;
+            }
+
+            entry.scheduled = false;
+        }
+
+        /**
+         * @brief Unlink entry from its queue and slot and free it
+         */
+        void Remove(Index index)
+        {
+            auto& entry = At(index);
+            auto& queue = *entry.queue;
+            auto& fifo = (*queue.fifos_)[entry.priority];
+
+            if (entry.fifo_prev != kNone) {
+                At(entry.fifo_prev).fifo_next = entry.fifo_next;
+            } else {
+                fifo.head = entry.fifo_next;
+            }
+
+            if (entry.fifo_next != kNone) {
+                At(entry.fifo_next).fifo_prev = entry.fifo_prev;
+            } else {
+                fifo.tail = entry.fifo_prev;
+            }
+
+            if (fifo.head == kNone) {
+                queue.active_mask_ &= ~(uint64_t{ 1 } << entry.priority);
+            }
+
+            if (entry.scheduled) {
+                Unschedule(index);
+            }
+
+            if (queue.front_ == index) {
+                queue.front_ = kNone;
+            }
+
+            queue.size_.store(queue.Size() - 1, std::memory_order_relaxed);
+            queue.bytes_.store(queue.Bytes() - entry.bytes, std::memory_order_relaxed);
+            --size_;
+
+            entry.value = T{};
+            entry.queue = nullptr;
+            entry.slot_next = free_head_;
+            free_head_ = index;
+        }
+
+        Entry& At(Index index) noexcept { return chunks_[index >> kChunkBits][index & (kChunkSize - 1)]; }
+
+        void AddChunk()
+        {
+            chunks_.push_back(std::make_unique<Entry[]>(kChunkSize));
+
+            // Link the new entries into the free list in index order
+            for (std::size_t i = kChunkSize; i > 0; --i) {
+                const auto index = static_cast<Index>(capacity_ + i - 1);
+                At(index).slot_next = free_head_;
+                free_head_ = index;
+            }
+
+            capacity_ += kChunkSize;
+        }
+
+        Index AllocateEntry()
+        {
+            if (free_head_ == kNone) {
+                AddChunk();
+            }
+
+            return std::exchange(free_head_, At(free_head_).slot_next);
+        }
+
+        /**
+         * @brief Find the first object of a queue that can be popped
+         *
+         * @details Removes the previous front if it expired while pinned.
+         *
+         * @param queue                 Queue to get the front of
+         * @param expired_count[out]    Number of objects of the queue that expired since the last front
+         *
+         * @returns Index of the first object, kNone if there is none
+         */
+        Index FrontIndex(Queue& queue, uint32_t& expired_count)
+        {
+            const TickType ticks = Advance();
+
+            if (const auto index = std::exchange(queue.front_, kNone); index != kNone && !At(index).scheduled) {
+                queue.expired_count_++;
+                Remove(index);
+            }
+
+            expired_count = std::exchange(queue.expired_count_, 0);
+
+            for (auto mask = queue.active_mask_; mask != 0; mask &= mask - 1) {
+                const auto index = (*queue.fifos_)[std::countr_zero(mask)].head;
+
+                if (At(index).wait_for_tick <= ticks) {
+                    return index;
+                }
+            }
+
+            return kNone;
+        }
+
+        std::mutex mutex_;
+        const size_t duration_;
+        const size_t interval_;
+        std::shared_ptr<TickService> tick_service_;
+
+        TickType current_tick_{ 0 }; /// Wheel tick of the last advance, milliseconds / interval
+        size_t size_{ 0 };           /// Entries in use by all queues
+        size_t capacity_{ 0 };       /// Entries allocated
+        Index free_head_{ kNone };   /// First free entry
+
+        std::vector<std::unique_ptr<Entry[]>> chunks_;
+        std::array<Index, kLevels * kSlots> slots_;
+    };
+
+} // namespace quicr
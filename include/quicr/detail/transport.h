@@ -6,6 +6,7 @@
 #include "messages.h"
 #include "tick_service.h"
 
+#include "flat_hash_map.h"
 #include "quic_transport.h"
 
 #include <chrono>
@@ -229,6 +230,10 @@ namespace quicr {
                                    DataContextId data_ctx_id,
                                    const QuicDataContextMetrics& quic_data_context_metrics) override;
 
+        void OnDataContextBackpressure(const ConnectionHandle& connection_handle,
+                                       const DataContextId& data_ctx_id) override;
+        void OnDataContextDrained(const ConnectionHandle& connection_handle, const DataContextId& data_ctx_id) override;
+
         // -------------------------------------------------------------------------------------------------
         // End of transport handler/callback functions
         // -------------------------------------------------------------------------------------------------
@@ -260,16 +265,16 @@ namespace quicr {
             std::map<messages::RequestID, SubscribeContext> recv_sub_id;
 
             /// Tracks by request ID (Subscribe and Fetch)
-            std::map<messages::RequestID, std::shared_ptr<SubscribeTrackHandler>> tracks_by_request_id;
+            FlatHashMap<messages::RequestID, std::shared_ptr<SubscribeTrackHandler>> tracks_by_request_id;
 
             /// Subscribes by Track Alais is used for data object forwarding
-            std::map<messages::TrackAlias, std::shared_ptr<SubscribeTrackHandler>> sub_by_track_alias;
+            FlatHashMap<messages::TrackAlias, std::shared_ptr<SubscribeTrackHandler>> sub_by_track_alias;
 
             /// Publish tracks by namespace and name. map[track namespace][track name] = track handler
             std::map<TrackNamespaceHash, std::map<TrackNameHash, std::shared_ptr<PublishTrackHandler>>>
               pub_tracks_by_name;
 
-            std::map<messages::TrackAlias, std::shared_ptr<PublishTrackHandler>> pub_tracks_by_track_alias;
+            FlatHashMap<messages::TrackAlias, std::shared_ptr<PublishTrackHandler>> pub_tracks_by_track_alias;
 
             /** MoQT draft 11 does not send all announce messages with namespace. Instead, they are sent
              *  with request-id. The namespace is needed. This map is used to map request ID to namespace
@@ -277,7 +282,7 @@ namespace quicr {
             std::map<messages::RequestID, TrackNamespaceHash> pub_tracks_ns_by_request_id;
 
             /// Published tracks by quic transport data context ID.
-            std::map<DataContextId, std::shared_ptr<PublishTrackHandler>> pub_tracks_by_data_ctx_id;
+            FlatHashMap<DataContextId, std::shared_ptr<PublishTrackHandler>> pub_tracks_by_data_ctx_id;
 
             /// Fetch Publishers by subscribe ID.
             std::map<messages::RequestID, std::shared_ptr<PublishTrackHandler>> pub_fetch_tracks_by_sub_id;
@@ -312,6 +317,41 @@ namespace quicr {
                                                             std::optional<Extensions> extensions,
                                                             BytesSpan data);
 
+        /**
+         * @brief Set the TX queue budget of the publish data context of the track
+         *
+         * @details Uses the budget of the track handler if set, otherwise the transport config budget
+         */
+        void SetPublishTxQueueBudget(const PublishTrackHandler& track_handler);
+
+        /**
+         * @brief Set the TX rate limit of the publish data context of the track if the track handler has one
+         */
+        void SetPublishTxRateLimit(const PublishTrackHandler& track_handler);
+
+        /**
+         * @brief Publish status of the result of enqueueing objects of a track
+         *
+         * @details The TX queue status of the track is set by the transport backpressure and drained callbacks
+         *
+         * @returns kQueueFull if the objects were not queued due to the TX queue budget, otherwise kOk
+         */
+        static PublishTrackHandler::PublishObjectStatus EnqueueStatus(TransportError error);
+
+        /**
+         * @brief Set the TX queue status of the track that publishes on the data context
+         */
+        void SetTxQueueStatus(const ConnectionHandle& connection_handle,
+                              const DataContextId& data_ctx_id,
+                              PublishTrackHandler::TxQueueStatus status);
+
+        /**
+         * @brief Get the cleared buffer to serialize object headers into
+         *
+         * @details The buffer is per thread instead of per publish track, so idle tracks do not hold one
+         */
+        static Bytes& ObjectMsgBuffer();
+
         void SendCtrlMsg(const ConnectionContext& conn_ctx, BytesSpan data);
         void SendClientSetup();
         void SendServerSetup(ConnectionContext& conn_ctx);
@@ -393,6 +433,24 @@ namespace quicr {
 
         std::shared_ptr<PublishTrackHandler> GetPubTrackHandler(ConnectionContext& conn_ctx, TrackHash& th);
 
+        /**
+         * @brief Find the connection context
+         *
+         * @details Transport callbacks for different connections run at the same time, so the connections
+         *      map is only looked up and updated under the state mutex. The returned context remains valid
+         *      until the connection is removed since the map is pointer stable.
+         *
+         * @returns Pointer to the connection context, nullptr if the connection does not exist
+         */
+        ConnectionContext* FindConnContext(ConnectionHandle conn_id);
+
+        /**
+         * @brief Get the connection context, creating it if it does not exist
+         *
+         * @details Locks the state mutex like FindConnContext()
+         */
+        ConnectionContext& GetOrCreateConnContext(ConnectionHandle conn_id);
+
         void RemoveAllTracksForConnectionClose(ConnectionContext& conn_ctx);
 
         bool OnRecvSubgroup(messages::StreamHeaderType type,
@@ -443,7 +501,8 @@ namespace quicr {
         const ServerConfig server_config_;
         const ClientConfig client_config_;
 
-        std::map<ConnectionHandle, ConnectionContext> connections_;
+        /// Connection contexts by handle. Pointer stable since references are held across calls.
+        FlatHashMap<ConnectionHandle, ConnectionContext, true> connections_;
 
         Status status_{ Status::kNotReady };
 
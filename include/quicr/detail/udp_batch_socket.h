@@ -0,0 +1,176 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <sys/socket.h>
+#include <vector>
+
+namespace quicr {
+
+    /**
+     * @brief UDP socket that sends and receives datagrams in batches
+     *
+     * @details Uses recvmmsg/sendmmsg to move up to kBatchSize messages per syscall. When the kernel supports
+     *      it, UDP generic segmentation offload (UDP_SEGMENT) sends several equal sized packets to the same
+     *      peer as one message and generic receive offload (UDP_GRO) receives them as one message. Offload is
+     *      turned off if the kernel or device rejects it.
+     *
+     *      Only supported on Linux, see Supported(). The socket is not thread safe and is expected to be
+     *      used by the packet loop thread only.
+     */
+    class UdpBatchSocket
+    {
+      public:
+        static constexpr std::size_t kBatchSize = 32;      /// Max messages per syscall
+        static constexpr std::size_t kMaxGsoSegments = 16; /// Max packets coalesced in one send message
+        static constexpr std::size_t kMaxGroSize = 65535;  /// Receive buffer size per message when GRO is on
+
+        /**
+         * @brief Received datagram
+         *
+         * @details Data and addresses are valid until the next call to Receive(). They can be modified in place,
+         *      such as when decrypting.
+         */
+        struct Packet
+        {
+            std::span<uint8_t> data;
+            sockaddr_storage* peer_addr;  /// Address the datagram was received from
+            sockaddr_storage* local_addr; /// Address the datagram was sent to, including the bound port
+            int if_index;                 /// Interface the datagram was received on
+            uint8_t ecn;                  /// ECN bits of the datagram
+        };
+
+        struct Stats
+        {
+            uint64_t rx_syscalls{ 0 };
+            uint64_t rx_packets{ 0 };
+            uint64_t tx_syscalls{ 0 };
+            uint64_t tx_packets{ 0 };
+            uint64_t tx_errors{ 0 }; /// Messages that failed to send and were dropped
+        };
+
+        /**
+         * @brief Message that failed to send
+         */
+        struct SendError
+        {
+            sockaddr* peer_addr;  /// Address the message was sent to
+            sockaddr* local_addr; /// Address the message was sent from, nullptr if chosen by the kernel
+            int if_index;         /// Interface the message was sent from
+            int error;            /// errno value of the failed send
+            void* context;        /// Context passed to QueueSend()
+        };
+
+        using SendErrorHandler = std::function<void(const SendError&)>;
+
+        /**
+         * @brief Construct the socket, Open() needs to be called before use
+         *
+         * @param max_packet_size   Max size in bytes of a single datagram
+         * @param use_offload       Use UDP GSO/GRO if supported by the kernel
+         */
+        UdpBatchSocket(std::size_t max_packet_size, bool use_offload);
+        ~UdpBatchSocket();
+
+        UdpBatchSocket(const UdpBatchSocket&) = delete;
+        UdpBatchSocket& operator=(const UdpBatchSocket&) = delete;
+
+        /**
+         * @brief Check if batched UDP I/O is supported on this platform
+         */
+        static bool Supported() noexcept;
+
+        /**
+         * @brief Open and bind the socket
+         *
+         * @param family        AF_INET or AF_INET6. AF_INET6 sockets are dual stack.
+         * @param port          Local port to bind, zero for an ephemeral port
+         * @param reuse_port    Set SO_REUSEPORT so that several sockets can bind the same port
+         *
+         * @returns Zero on success, errno value otherwise
+         */
+        int Open(int family, uint16_t port, bool reuse_port);
+
+        void Close();
+
+        int Fd() const noexcept { return fd_; }
+        bool GsoEnabled() const noexcept { return gso_enabled_; }
+        bool GroEnabled() const noexcept { return gro_enabled_; }
+        const Stats& GetStats() const noexcept { return stats_; }
+
+        /**
+         * @brief Set the handler called for each message that fails to send
+         *
+         * @details Called by Flush(), including the flush done by SendBuffer() when the batch is full
+         */
+        void SetSendErrorHandler(SendErrorHandler handler) { send_error_handler_ = std::move(handler); }
+
+        /**
+         * @brief Receive a batch of datagrams without blocking
+         *
+         * @details Messages received with GRO are split back into their datagrams.
+         *
+         * @returns Datagrams received, empty if none are pending
+         */
+        std::span<const Packet> Receive();
+
+        /**
+         * @brief Buffer to write the next message to send into
+         *
+         * @details Has room for kMaxGsoSegments packets when GSO is enabled, otherwise for one packet.
+         *      Flushes queued messages if the batch is full.
+         */
+        std::span<uint8_t> SendBuffer();
+
+        /**
+         * @brief Queue the message written to SendBuffer() to be sent by Flush()
+         *
+         * @param length        Number of bytes written to the send buffer
+         * @param segment_size  Size of each packet if more than one packet was written, zero otherwise
+         * @param peer_addr     Address to send to
+         * @param local_addr    Address to send from, nullptr or AF_UNSPEC to let the kernel choose
+         * @param if_index      Interface to send from, zero to let the kernel choose
+         * @param context       Passed to the send error handler if the message fails to send
+         */
+        void QueueSend(std::size_t length,
+                       std::size_t segment_size,
+                       const sockaddr* peer_addr,
+                       const sockaddr* local_addr,
+                       int if_index,
+                       void* context = nullptr);
+
+        /**
+         * @brief Send all queued messages
+         *
+         * @returns Number of packets sent
+         */
+        std::size_t Flush();
+
+      private:
+        struct MessageBatch;
+
+        std::size_t SendSegmented(std::size_t index);
+        void NotifySendError(std::size_t index, int error);
+
+        int fd_{ -1 };
+        int family_{ 0 };
+        uint16_t local_port_{ 0 }; /// Bound port in network byte order
+        std::size_t max_packet_size_;
+        bool use_offload_;
+        bool gso_enabled_{ false };
+        bool gro_enabled_{ false };
+
+        std::unique_ptr<MessageBatch> rx_;
+        std::unique_ptr<MessageBatch> tx_;
+        std::vector<Packet> rx_packets_;
+        Stats stats_;
+        SendErrorHandler send_error_handler_;
+    };
+
+} // namespace quicr
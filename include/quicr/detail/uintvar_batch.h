@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace quicr {
+
+    /**
+     * @brief Implementation used to decode and encode a batch of QUIC variable length integers
+     */
+    enum class UintVarKernel : uint8_t
+    {
+        kScalar = 0, /// Branchless scalar, always supported
+        kSse4,       /// x86 SSE4.1
+        kAvx2,       /// x86 AVX2
+        kNeon,       /// ARM NEON (AArch64), only built with the QUICR_UINTVAR_NEON CMake option
+    };
+
+    /**
+     * @brief Check if the kernel is supported by the build and the CPU it runs on
+     */
+    bool UintVarKernelSupported(UintVarKernel kernel) noexcept;
+
+    /**
+     * @brief Best kernel supported by the CPU, detected once and used by the batch functions without a kernel
+     */
+    UintVarKernel SelectedUintVarKernel() noexcept;
+
+    /**
+     * @brief Decode values.size() consecutive uintvars from the bytes
+     *
+     * @param kernel    Kernel to decode with, falls back to scalar if not supported
+     * @param bytes     Encoded uintvars
+     * @param values    Decoded values, the number of values to decode is the size of the span
+     *
+     * @returns Number of bytes consumed, or nullopt if the bytes end before all values are decoded.
+     *      Values decoded before the end of the bytes are written even if nullopt is returned.
+     */
+    std::optional<std::size_t> DecodeUintVars(UintVarKernel kernel,
+                                              std::span<const uint8_t> bytes,
+                                              std::span<uint64_t> values) noexcept;
+
+    inline std::optional<std::size_t> DecodeUintVars(std::span<const uint8_t> bytes,
+                                                     std::span<uint64_t> values) noexcept
+    {
+        return DecodeUintVars(SelectedUintVarKernel(), bytes, values);
+    }
+
+    /**
+     * @brief Encode the values as consecutive uintvars using the shortest encoding of each value
+     *
+     * @param kernel    Kernel to encode with, falls back to scalar if not supported
+     * @param values    Values to encode
+     * @param bytes     Buffer to encode into, needs to be large enough for all the encoded values. Bytes
+     *                  after the returned length may be overwritten.
+     *
+     * @returns Number of bytes written
+     *
+     * @throws std::invalid_argument if a value is greater than the uintvar maximum or the buffer is too small
+     */
+    std::size_t EncodeUintVars(UintVarKernel kernel, std::span<const uint64_t> values, std::span<uint8_t> bytes);
+
+    inline std::size_t EncodeUintVars(std::span<const uint64_t> values, std::span<uint8_t> bytes)
+    {
+        return EncodeUintVars(SelectedUintVarKernel(), values, bytes);
+    }
+}
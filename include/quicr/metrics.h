@@ -49,13 +49,18 @@ namespace quicr {
             uint64_t tx_buffer_drops{ 0 };   ///< count of write buffer drops of data due to RESET request
             uint64_t tx_queue_discards{ 0 }; ///< count of objects discarded due clear and transition to new stream
             uint64_t tx_queue_expired{ 0 };  ///< count of objects expired before pop/front due to TTL expiry
+            uint64_t tx_queue_full{ 0 };     ///< count of objects not queued due to the TX queue budget
+            uint64_t tx_group_drops{ 0 };    ///< count of objects dropped because a newer group was queued
 
             uint64_t tx_delayed_callback{ 0 }; ///< count of times transmit callbacks were delayed
             uint64_t tx_reset_wait{ 0 };       ///< count of times data context performed a reset and wait
+            uint64_t tx_rate_limited{ 0 };     ///< count of times transmit callbacks waited for rate limit tokens
+            uint64_t tx_rate_tokens{ 0 };      ///< rate limit tokens in bytes available at end of period
 
-            MinMaxAvg tx_queue_size;         ///< TX queue size in period
-            MinMaxAvg tx_callback_ms;        ///< Callback time in milliseconds in period
-            MinMaxAvg tx_object_duration_us; ///< TX object time in queue duration in microseconds
+            MinMaxAvg tx_queue_size;           ///< TX queue size in period
+            MinMaxAvg tx_callback_ms;          ///< Callback time in milliseconds in period
+            MinMaxAvg tx_object_duration_us;   ///< TX object time in queue duration in microseconds
+            MinMaxAvg tx_objects_per_callback; ///< Objects written per stream callback in period
         } quic;
     };
 
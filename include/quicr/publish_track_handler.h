@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <quicr/detail/base_track_handler.h>
 #include <quicr/detail/messages.h>
@@ -51,6 +52,10 @@ namespace quicr {
             /// Previous object payload has not been completed and new object cannot start in per-track track mode
             /// without creating a new track. This requires to unpublish and to publish track again.
             kPreviousObjectNotCompleteMustStartNewTrack,
+
+            /// Object was not sent because the transmit queue of the track is over its budget. The next object
+            /// that starts a new group is always queued.
+            kQueueFull,
         };
 
         /**
@@ -69,6 +74,33 @@ namespace quicr {
             kNewGroupRequested,
         };
 
+        /**
+         * @brief Status of the transmit queue of the track
+         */
+        enum class TxQueueStatus : uint8_t
+        {
+            kDrained = 0, ///< Queue has room for objects
+            kBackpressure ///< Queue is over its budget and objects are not sent, see PublishObjectStatus::kQueueFull
+        };
+
+        /**
+         * @brief Transmit queue budget of the track
+         */
+        struct TxQueueBudget
+        {
+            uint64_t max_bytes{ 0 };   ///< Max bytes of queued objects, zero is unlimited
+            uint32_t max_objects{ 0 }; ///< Max number of queued objects, zero is unlimited
+        };
+
+        /**
+         * @brief Transmit rate limit of the track
+         */
+        struct TxRateLimit
+        {
+            uint64_t rate_bps{ 0 };    ///< Max rate in bits per second, zero is unlimited
+            uint32_t burst_bytes{ 0 }; ///< Max burst in bytes, zero is 100ms of the rate
+        };
+
       protected:
         /**
          * @brief Publish track handler constructor
@@ -137,6 +169,18 @@ namespace quicr {
          */
         virtual void StatusChanged(Status status);
 
+        /**
+         * @brief Notification of transmit queue status change
+         * @details Backpressure is notified after an object is not sent because the transmit queue is over its
+         *      budget, publishing the object returns PublishObjectStatus::kQueueFull right away. Drained is
+         *      notified when the queue is below half of its budget. Both are notified in order by the transport
+         *      callback thread of the connection. Encoders can skip producing objects while there is
+         *      backpressure instead of producing them to be dropped.
+         *
+         * @param status        Status of the transmit queue
+         */
+        virtual void TxQueueStatusChanged(TxQueueStatus status);
+
         /**
          * @brief Notification callback to provide sampled metrics
          *
@@ -187,6 +231,28 @@ namespace quicr {
          */
         constexpr Status GetStatus() const noexcept { return publish_status_; }
 
+        /**
+         * @brief Set the transmit queue budget of the track
+         *
+         * @details Overrides TransportConfig::tx_queue_max_bytes and tx_queue_max_objects for this track.
+         *      Takes effect when the track is published.
+         */
+        void SetTxQueueBudget(const TxQueueBudget& budget) noexcept { tx_queue_budget_ = budget; }
+
+        /**
+         * @brief Set the transmit rate limit of the track
+         *
+         * @details Objects stay queued until the track has sent less than the rate allows, which spreads
+         *      bursts of objects such as key frames out over time. Applies to stream track modes.
+         *      Takes effect when the track is published.
+         */
+        void SetTxRateLimit(const TxRateLimit& rate_limit) noexcept { tx_rate_limit_ = rate_limit; }
+
+        /**
+         * @brief Get the transmit queue status
+         */
+        TxQueueStatus GetTxQueueStatus() const noexcept { return tx_queue_status_; }
+
         // --------------------------------------------------------------------------
         // Methods that normally do not need to be overridden
         // --------------------------------------------------------------------------
@@ -345,6 +411,16 @@ namespace quicr {
             StatusChanged(status);
         }
 
+        /**
+         * @brief Set the transmit queue status, notifying on change
+         */
+        void SetTxQueueStatus(TxQueueStatus status) noexcept
+        {
+            if (tx_queue_status_.exchange(status) != status) {
+                TxQueueStatusChanged(status);
+            }
+        }
+
         // --------------------------------------------------------------------------
         // Member variables
         // --------------------------------------------------------------------------
@@ -364,7 +440,9 @@ namespace quicr {
         uint64_t object_payload_remaining_length_{ 0 };
         bool sent_first_header_{ false }; // Used to indicate if the first stream has sent the header or not
 
-        Bytes object_msg_buffer_; // TODO(tievens): Review shrink/resize
+        std::optional<TxQueueBudget> tx_queue_budget_; // Transport config budget is used if not set
+        std::optional<TxRateLimit> tx_rate_limit_;     // Unlimited if not set
+        std::atomic<TxQueueStatus> tx_queue_status_{ TxQueueStatus::kDrained };
 
         friend class Transport;
         friend class Client;
@@ -57,6 +57,15 @@ namespace quicr {
             const messages::GroupId preceding_group_offset;
         };
 
+        /**
+         * @brief Received full data object, see ObjectsReceived()
+         */
+        struct ReceivedObject
+        {
+            ObjectHeaders headers;    ///< Object headers
+            SharedSpan<uint8_t> data; ///< Object payload data, matches ObjectHeaders::payload_length
+        };
+
       protected:
         /**
          * @brief Subscribe track handler constructor
@@ -162,6 +171,31 @@ namespace quicr {
         virtual void ObjectReceived([[maybe_unused]] const ObjectHeaders& object_headers,
                                     [[maybe_unused]] BytesSpan data);
 
+        /**
+         * @brief Notification of received [full] data object with a handle to the payload
+         *
+         * @details Event notification to provide the caller the received full data object. The payload
+         *      handle aliases the received data and holds a reference to it. The caller can keep a copy of
+         *      the handle to retain the payload without copying the data. The default implementation calls
+         *      ObjectReceived(const ObjectHeaders&, BytesSpan).
+         *
+         * @param object_headers    Object headers, must include group and object Ids
+         * @param data              Object payload data received, **MUST** match ObjectHeaders::payload_length.
+         */
+        virtual void ObjectReceived(const ObjectHeaders& object_headers, const SharedSpan<uint8_t>& data);
+
+        /**
+         * @brief Notification of the full data objects received in a slice of data
+         *
+         * @details Event notification to provide the caller all full data objects parsed from a received
+         *      stream data slice or datagram, in the order received. The default implementation calls
+         *      ObjectReceived() for each object. Override to handle them with one call per slice.
+         *      Copies of the payload handles of the objects can be kept after return of this method.
+         *
+         * @param objects           Objects received
+         */
+        virtual void ObjectsReceived(std::span<const ReceivedObject> objects);
+
         /**
          * @brief Notification of received stream data slice
          *
@@ -244,6 +278,22 @@ namespace quicr {
             StatusChanged(status);
         }
 
+        /**
+         * @brief Queue a parsed object for the next NotifyReceivedObjects()
+         *
+         * @param object_headers    Object headers
+         * @param payload           Object payload
+         */
+        void QueueReceivedObject(ObjectHeaders&& object_headers, SharedSpan<uint8_t>&& payload);
+
+        /**
+         * @brief Notify the queued objects to a track handler with one ObjectsReceived() call
+         *
+         * @param handler           Track handler to notify, the handler that queued the objects or the
+         *                          handler it forwards to
+         */
+        void NotifyReceivedObjects(SubscribeTrackHandler& handler);
+
         StreamBuffer<uint8_t> stream_buffer_;
 
       private:
@@ -254,6 +304,7 @@ namespace quicr {
         uint64_t current_stream_id_{ 0 };
         std::optional<messages::Location> latest_location_;
         std::optional<JoiningFetch> joining_fetch_;
+        std::vector<ReceivedObject> received_objects_; /// Parsed objects of the data slice not yet notified
 
         friend class Transport;
         friend class Client;
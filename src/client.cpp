@@ -38,14 +38,14 @@ namespace quicr {
                                   uint64_t request_id,
                                   const SubscribeResponse& subscribe_response)
     {
-        auto conn_it = connections_.find(connection_handle);
-        if (conn_it == connections_.end()) {
+        auto conn_ctx = FindConnContext(connection_handle);
+        if (conn_ctx == nullptr) {
             return;
         }
 
         switch (subscribe_response.reason_code) {
             case SubscribeResponse::ReasonCode::kOk: {
-                SendSubscribeOk(conn_it->second,
+                SendSubscribeOk(*conn_ctx,
                                 request_id,
                                 kSubscribeExpires,
                                 subscribe_response.largest_location.has_value(),
@@ -57,7 +57,7 @@ namespace quicr {
 
             default:
                 SendSubscribeError(
-                  conn_it->second, request_id, {}, messages::SubscribeErrorCode::kInternalError, "Internal error");
+                  *conn_ctx, request_id, {}, messages::SubscribeErrorCode::kInternalError, "Internal error");
                 break;
         }
     }
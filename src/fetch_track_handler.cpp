@@ -12,7 +12,7 @@ namespace quicr {
             stream_buffer_.Clear();
 
             stream_buffer_.InitAny<messages::FetchHeader>();
-            stream_buffer_.Push(*data);
+            stream_buffer_.Push(data);
             stream_buffer_.Pop(); // Remove type header
 
             // Expect that on initial start of stream, there is enough data to process the stream headers
@@ -24,16 +24,21 @@ namespace quicr {
                 return;
             }
         } else {
-            stream_buffer_.Push(*data);
+            stream_buffer_.Push(data);
         }
 
         if (not stream_buffer_.AnyHasValueB()) {
             stream_buffer_.InitAnyB<messages::FetchObject>();
         }
 
-        auto& obj = stream_buffer_.GetAnyB<messages::FetchObject>();
+        // Parse all objects in the received data, there can be many small objects in one slice
+        while (true) {
+            auto& obj = stream_buffer_.GetAnyB<messages::FetchObject>();
+            obj.view_payload = true;
+            if (not(stream_buffer_ >> obj)) {
+                break;
+            }
 
-        if (stream_buffer_ >> obj) {
             SPDLOG_TRACE("Received fetch_object subscribe_id: {} priority: {} "
                          "group_id: {} subgroup_id: {} object_id: {} data size: {}",
                          *GetSubscribeId(),
@@ -41,23 +46,25 @@ namespace quicr {
                          obj.group_id,
                          obj.subgroup_id,
                          obj.object_id,
-                         obj.payload.size());
+                         obj.payload_view.size());
 
             subscribe_track_metrics_.objects_received++;
-            subscribe_track_metrics_.bytes_received += obj.payload.size();
-
-            ObjectReceived({ obj.group_id,
-                             obj.object_id,
-                             obj.subgroup_id,
-                             obj.payload.size(),
-                             obj.object_status,
-                             obj.publisher_priority,
-                             std::nullopt,
-                             TrackMode::kStream,
-                             obj.extensions },
-                           obj.payload);
+            subscribe_track_metrics_.bytes_received += obj.payload_view.size();
+
+            QueueReceivedObject({ obj.group_id,
+                                  obj.object_id,
+                                  obj.subgroup_id,
+                                  obj.payload_view.size(),
+                                  obj.object_status,
+                                  obj.publisher_priority,
+                                  std::nullopt,
+                                  TrackMode::kStream,
+                                  std::move(obj.extensions) },
+                                std::move(obj.payload_view));
 
             stream_buffer_.ResetAnyB<messages::FetchObject>();
         }
+
+        NotifyReceivedObjects(*this);
     }
 }
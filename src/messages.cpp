@@ -86,6 +86,104 @@ namespace quicr::messages {
         return true;
     }
 
+    /**
+     * @brief Decoder of message fields that are contiguous in memory
+     *
+     * @details Fast path for messages received in one chunk. Reads do not check for the end of the
+     *      bytes individually for the caller, a read past the end fails the decoder and returns zero. The
+     *      caller checks Ok() once after reading all fields, and falls back to parsing from the stream
+     *      buffer if it failed.
+     */
+    class SpanDecoder
+    {
+      public:
+        explicit SpanDecoder(BytesSpan bytes) noexcept
+          : bytes_(bytes)
+        {
+        }
+
+        bool Ok() const noexcept { return ok_; }
+        std::size_t Consumed() const noexcept { return pos_; }
+        std::size_t Remaining() const noexcept { return bytes_.size() - pos_; }
+
+        uint64_t UintV() noexcept
+        {
+            if (pos_ >= bytes_.size()) {
+                ok_ = false;
+                return 0;
+            }
+
+            const std::size_t len = std::size_t{ 1 } << (bytes_[pos_] >> 6);
+            if (Remaining() < len) {
+                ok_ = false;
+                return 0;
+            }
+
+            uint64_t value = 0;
+            if (Remaining() >= sizeof(uint64_t)) {
+                std::memcpy(&value, bytes_.data() + pos_, sizeof(uint64_t));
+                value = SwapBytes(value) >> (64 - 8 * len);
+            } else {
+                for (std::size_t i = 0; i < len; ++i) {
+                    value = (value << 8) | bytes_[pos_ + i];
+                }
+            }
+
+            pos_ += len;
+            return value & (~uint64_t{ 0 } >> (66 - 8 * len)); // Clear the length bits
+        }
+
+        uint8_t Byte() noexcept
+        {
+            if (pos_ >= bytes_.size()) {
+                ok_ = false;
+                return 0;
+            }
+
+            return bytes_[pos_++];
+        }
+
+        BytesSpan Read(uint64_t len) noexcept
+        {
+            if (Remaining() < len) {
+                ok_ = false;
+                return {};
+            }
+
+            const auto bytes = bytes_.subspan(pos_, len);
+            pos_ += len;
+            return bytes;
+        }
+
+      private:
+        BytesSpan bytes_;
+        std::size_t pos_{ 0 };
+        bool ok_{ true };
+    };
+
+    static void DecodeExtensions(SpanDecoder& decoder, std::optional<Extensions>& extensions)
+    {
+        const auto count = decoder.UintV();
+
+        for (uint64_t extension = 0; extension < count && decoder.Ok(); extension++) {
+            if (extensions == std::nullopt) {
+                extensions = Extensions();
+            }
+
+            const auto tag = decoder.UintV();
+            if (tag % 2 == 0) {
+                const auto val = decoder.UintV();
+                std::vector<uint8_t> bytes(8);
+                memcpy(bytes.data(), &val, 8);
+                extensions.value()[tag] = std::move(bytes);
+            } else {
+                const auto len = decoder.UintV();
+                const auto val = decoder.Read(len);
+                extensions.value()[tag].assign(val.begin(), val.end());
+            }
+        }
+    }
+
     static void PushBytes(Bytes& buffer, const Bytes& bytes)
     {
         buffer.insert(buffer.end(), bytes.begin(), bytes.end());
@@ -150,11 +248,14 @@ namespace quicr::messages {
         buffer << UintVar(msg.object_id);
         buffer.push_back(msg.publisher_priority);
         PushExtensions(buffer, msg.extensions);
-        if (msg.payload.empty()) {
+        if (msg.payload.empty() && msg.payload_len == 0) {
             // empty payload needs a object status to be set
             auto status = UintVar(static_cast<uint8_t>(msg.object_status));
             buffer.push_back(0);
             buffer << status;
+        } else if (msg.payload.empty()) {
+            // Header only, the payload of payload_len bytes is written separately by the caller
+            buffer << UintVar(msg.payload_len);
         } else {
             buffer << UintVar(msg.payload.size());
             PushBytes(buffer, msg.payload);
@@ -162,9 +263,53 @@ namespace quicr::messages {
         return buffer;
     }
 
+    /**
+     * @brief Decode the fields before the payload if they are contiguous at the front of the buffer
+     */
+    template<class StreamBufferType>
+    void DecodeContiguous(StreamBufferType& buffer, FetchObject& msg)
+    {
+        SpanDecoder decoder(buffer.FrontContiguous());
+        const auto group_id = decoder.UintV();
+        const auto subgroup_id = decoder.UintV();
+        const auto object_id = decoder.UintV();
+        const auto publisher_priority = decoder.Byte();
+        std::optional<Extensions> extensions;
+        DecodeExtensions(decoder, extensions);
+        const auto payload_len = decoder.UintV();
+        const auto status = payload_len == 0 ? decoder.UintV() : 0;
+
+        if (!decoder.Ok()) {
+            return;
+        }
+
+        buffer.Pop(decoder.Consumed());
+        msg.group_id = group_id;
+        msg.subgroup_id = subgroup_id;
+        msg.object_id = object_id;
+        msg.publisher_priority = publisher_priority;
+        msg.extensions = std::move(extensions);
+        msg.payload_len = payload_len;
+        msg.current_pos = 7;
+
+        if (payload_len == 0) {
+            msg.object_status = static_cast<ObjectStatus>(status);
+            msg.current_pos = 6;
+            msg.parse_completed = true;
+        }
+    }
+
     template<class StreamBufferType>
     bool operator>>(StreamBufferType& buffer, FetchObject& msg)
     {
+        if (msg.current_pos == 0) {
+            DecodeContiguous(buffer, msg);
+
+            if (msg.parse_completed) {
+                return true;
+            }
+        }
+
         switch (msg.current_pos) {
             case 0: {
                 if (!ParseUintVField(buffer, msg.group_id)) {
@@ -230,12 +375,20 @@ namespace quicr::messages {
                 if (!buffer.Available(msg.payload_len)) {
                     return false;
                 }
-                auto val = buffer.Front(msg.payload_len);
-                if (val.size() == 0) {
-                    return false;
+                if (msg.view_payload) {
+                    auto view = buffer.FrontView(msg.payload_len);
+                    if (!view) {
+                        return false;
+                    }
+                    msg.payload_view = std::move(*view);
+                } else {
+                    auto val = buffer.Front(msg.payload_len);
+                    if (val.size() == 0) {
+                        return false;
+                    }
+                    msg.payload = std::move(val);
                 }
 
-                msg.payload = std::move(val);
                 buffer.Pop(msg.payload_len);
                 msg.parse_completed = true;
                 [[fallthrough]];
@@ -272,9 +425,41 @@ namespace quicr::messages {
         return buffer;
     }
 
+    /**
+     * @brief Decode the fields before the payload if they are contiguous at the front of the buffer
+     */
+    template<class StreamBufferType>
+    void DecodeContiguous(StreamBufferType& buffer, ObjectDatagram& msg)
+    {
+        SpanDecoder decoder(buffer.FrontContiguous());
+        const auto track_alias = decoder.UintV();
+        const auto group_id = decoder.UintV();
+        const auto object_id = decoder.UintV();
+        const auto priority = decoder.Byte();
+        std::optional<Extensions> extensions;
+        DecodeExtensions(decoder, extensions);
+
+        if (!decoder.Ok()) {
+            return;
+        }
+
+        buffer.Pop(decoder.Consumed());
+        msg.track_alias = track_alias;
+        msg.group_id = group_id;
+        msg.object_id = object_id;
+        msg.priority = priority;
+        msg.extensions = std::move(extensions);
+        msg.payload_len = buffer.Size();
+        msg.current_pos = 5;
+    }
+
     template<class StreamBufferType>
     bool operator>>(StreamBufferType& buffer, ObjectDatagram& msg)
     {
+        if (msg.current_pos == 0) {
+            DecodeContiguous(buffer, msg);
+        }
+
         switch (msg.current_pos) {
             case 0: {
                 if (!ParseUintVField(buffer, msg.track_alias)) {
@@ -325,7 +510,12 @@ namespace quicr::messages {
                     return false;
                 }
 
-                msg.payload = std::move(buffer.Front(msg.payload_len));
+                if (msg.view_payload) {
+                    msg.payload_view = std::move(*buffer.FrontView(msg.payload_len));
+                } else {
+                    msg.payload = std::move(buffer.Front(msg.payload_len));
+                }
+
                 buffer.Pop(msg.payload_len);
                 msg.parse_completed = true;
                 [[fallthrough]];
@@ -503,11 +693,14 @@ namespace quicr::messages {
         if (msg.serialize_extensions) {
             PushExtensions(buffer, msg.extensions);
         }
-        if (msg.payload.empty()) {
+        if (msg.payload.empty() && msg.payload_len == 0) {
             // empty payload needs a object status to be set
             auto status = UintVar(static_cast<uint8_t>(msg.object_status));
             buffer.push_back(0);
             buffer << status;
+        } else if (msg.payload.empty()) {
+            // Header only, the payload of payload_len bytes is written separately by the caller
+            buffer << UintVar(msg.payload_len);
         } else {
             buffer << UintVar(msg.payload.size());
             PushBytes(buffer, msg.payload);
@@ -515,9 +708,49 @@ namespace quicr::messages {
         return buffer;
     }
 
+    /**
+     * @brief Decode the fields before the payload if they are contiguous at the front of the buffer
+     */
+    template<class StreamBufferType>
+    void DecodeContiguous(StreamBufferType& buffer, StreamSubGroupObject& msg)
+    {
+        SpanDecoder decoder(buffer.FrontContiguous());
+        const auto object_id = decoder.UintV();
+        std::optional<Extensions> extensions;
+        if (msg.serialize_extensions) {
+            DecodeExtensions(decoder, extensions);
+        }
+        const auto payload_len = decoder.UintV();
+        const auto status = payload_len == 0 ? decoder.UintV() : 0;
+
+        if (!decoder.Ok()) {
+            return;
+        }
+
+        buffer.Pop(decoder.Consumed());
+        msg.object_id = object_id;
+        msg.extensions = std::move(extensions);
+        msg.payload_len = payload_len;
+        msg.current_pos = 4;
+
+        if (payload_len == 0) {
+            msg.object_status = static_cast<ObjectStatus>(status);
+            msg.current_pos = 3;
+            msg.parse_completed = true;
+        }
+    }
+
     template<class StreamBufferType>
     bool operator>>(StreamBufferType& buffer, StreamSubGroupObject& msg)
     {
+        if (msg.current_pos == 0) {
+            DecodeContiguous(buffer, msg);
+
+            if (msg.parse_completed) {
+                return true;
+            }
+        }
+
         switch (msg.current_pos) {
             case 0: {
                 if (!ParseUintVField(buffer, msg.object_id)) {
@@ -561,12 +794,20 @@ namespace quicr::messages {
                 if (!buffer.Available(msg.payload_len)) {
                     return false;
                 }
-                auto val = buffer.Front(msg.payload_len);
-                if (val.size() == 0) {
-                    return false;
+                if (msg.view_payload) {
+                    auto view = buffer.FrontView(msg.payload_len);
+                    if (!view) {
+                        return false;
+                    }
+                    msg.payload_view = std::move(*view);
+                } else {
+                    auto val = buffer.Front(msg.payload_len);
+                    if (val.size() == 0) {
+                        return false;
+                    }
+                    msg.payload = std::move(val);
                 }
 
-                msg.payload = std::move(val);
                 buffer.Pop(msg.payload_len);
                 msg.parse_completed = true;
                 [[fallthrough]];
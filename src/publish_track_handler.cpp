@@ -5,6 +5,7 @@
 
 namespace quicr {
     void PublishTrackHandler::StatusChanged(Status) {}
+    void PublishTrackHandler::TxQueueStatusChanged(TxQueueStatus) {}
     void PublishTrackHandler::MetricsSampled(const PublishTrackMetrics&) {}
 
     PublishTrackHandler::PublishObjectStatus PublishTrackHandler::ForwardPublishedData(
@@ -102,15 +103,23 @@ namespace quicr {
         publish_track_metrics_.objects_published++;
 
         if (publish_object_func_ != nullptr) {
-            return publish_object_func_(object_headers.priority.has_value() ? object_headers.priority.value()
-                                                                            : default_priority_,
-                                        object_headers.ttl.has_value() ? object_headers.ttl.value() : default_ttl_,
-                                        is_stream_header_needed,
-                                        object_headers.group_id,
-                                        object_headers.subgroup_id,
-                                        object_headers.object_id,
-                                        object_headers.extensions,
-                                        data);
+            const auto status =
+              publish_object_func_(object_headers.priority.has_value() ? object_headers.priority.value()
+                                                                       : default_priority_,
+                                   object_headers.ttl.has_value() ? object_headers.ttl.value() : default_ttl_,
+                                   is_stream_header_needed,
+                                   object_headers.group_id,
+                                   object_headers.subgroup_id,
+                                   object_headers.object_id,
+                                   object_headers.extensions,
+                                   data);
+
+            // Stream was not started, so the next object needs to start it
+            if (status == PublishObjectStatus::kQueueFull && is_stream_header_needed) {
+                sent_first_header_ = false;
+            }
+
+            return status;
         }
 
         return PublishObjectStatus::kInternalError;
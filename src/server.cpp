@@ -42,23 +42,23 @@ namespace quicr {
                                  const std::vector<ConnectionHandle>& subscribers,
                                  const AnnounceResponse& response)
     {
-        auto conn_it = connections_.find(connection_handle);
-        if (conn_it == connections_.end()) {
+        auto conn_ctx = FindConnContext(connection_handle);
+        if (conn_ctx == nullptr) {
             return;
         }
 
         switch (response.reason_code) {
             case AnnounceResponse::ReasonCode::kOk: {
-                SendAnnounceOk(conn_it->second, request_id);
+                SendAnnounceOk(*conn_ctx, request_id);
 
                 for (const auto& sub_conn_handle : subscribers) {
-                    auto it = connections_.find(sub_conn_handle);
-                    if (it == connections_.end()) {
+                    auto sub_conn_ctx = FindConnContext(sub_conn_handle);
+                    if (sub_conn_ctx == nullptr) {
                         continue;
                     }
 
                     // TODO: what request Id do we send for subscribe announces???
-                    SendAnnounce(it->second, request_id, track_namespace);
+                    SendAnnounce(*sub_conn_ctx, request_id, track_namespace);
                 }
                 break;
             }
@@ -93,19 +93,19 @@ namespace quicr {
                                   uint64_t request_id,
                                   const SubscribeResponse& subscribe_response)
     {
-        auto conn_it = connections_.find(connection_handle);
-        if (conn_it == connections_.end()) {
+        auto conn_ctx = FindConnContext(connection_handle);
+        if (conn_ctx == nullptr) {
             return;
         }
 
         switch (subscribe_response.reason_code) {
             case SubscribeResponse::ReasonCode::kOk: {
                 // Save the latest state for joining fetch.
-                assert(conn_it->second.recv_sub_id.find(request_id) != conn_it->second.recv_sub_id.end());
-                conn_it->second.recv_sub_id[request_id].largest_location = subscribe_response.largest_location;
+                assert(conn_ctx->recv_sub_id.find(request_id) != conn_ctx->recv_sub_id.end());
+                conn_ctx->recv_sub_id[request_id].largest_location = subscribe_response.largest_location;
 
                 // Send the ok.
-                SendSubscribeOk(conn_it->second,
+                SendSubscribeOk(*conn_ctx,
                                 request_id,
                                 kSubscribeExpires,
                                 subscribe_response.largest_location.has_value(),
@@ -116,14 +116,14 @@ namespace quicr {
             }
             case SubscribeResponse::ReasonCode::kRetryTrackAlias: {
                 if (subscribe_response.track_alias.has_value()) {
-                    SendSubscribeError(conn_it->second,
+                    SendSubscribeError(*conn_ctx,
                                        request_id,
                                        *subscribe_response.track_alias,
                                        messages::SubscribeErrorCode::kRetryTrackAlias,
                                        subscribe_response.error_reason.has_value() ? *subscribe_response.error_reason
                                                                                    : "internal error");
                 } else {
-                    SendSubscribeError(conn_it->second,
+                    SendSubscribeError(*conn_ctx,
                                        request_id,
                                        {},
                                        messages::SubscribeErrorCode::kInternalError,
@@ -133,7 +133,7 @@ namespace quicr {
             }
             default:
                 SendSubscribeError(
-                  conn_it->second, request_id, {}, messages::SubscribeErrorCode::kInternalError, "Internal error");
+                  *conn_ctx, request_id, {}, messages::SubscribeErrorCode::kInternalError, "Internal error");
                 break;
         }
     }
@@ -210,6 +210,8 @@ namespace quicr {
                                              track_handler->default_track_mode_ == TrackMode::kDatagram ? false : true,
                                              track_handler->default_priority_,
                                              false);
+        SetPublishTxQueueBudget(*track_handler);
+        SetPublishTxRateLimit(*track_handler);
 
         // Setup the function for the track handler to use to send objects with thread safety
         std::weak_ptr weak_track_handler(track_handler);
@@ -324,7 +326,11 @@ namespace quicr {
 
         ITransport::EnqueueFlags eflags;
 
-        track_handler.object_msg_buffer_.clear();
+        // Fetch header and object are enqueued together
+        std::array<ITransport::EnqueueObject, 2> objects;
+        std::size_t num_objects = 0;
+
+        auto& msg_buffer = ObjectMsgBuffer();
 
         // use stream per subgroup, group change
         eflags.use_reliable = true;
@@ -336,18 +342,15 @@ namespace quicr {
 
             messages::FetchHeader fetch_header{};
             fetch_header.subscribe_id = request_id;
-            track_handler.object_msg_buffer_ << fetch_header;
-
-            quic_transport_->Enqueue(track_handler.connection_handle_,
-                                     track_handler.publish_data_ctx_id_,
-                                     std::make_shared<std::vector<uint8_t>>(track_handler.object_msg_buffer_.begin(),
-                                                                            track_handler.object_msg_buffer_.end()),
-                                     priority,
-                                     ttl,
-                                     0,
-                                     eflags);
-
-            track_handler.object_msg_buffer_.clear();
+            msg_buffer << fetch_header;
+
+            objects[num_objects++] = { std::make_shared<std::vector<uint8_t>>(msg_buffer.begin(), msg_buffer.end()),
+                                       priority,
+                                       ttl,
+                                       eflags,
+                                       nullptr };
+
+            msg_buffer.clear();
             eflags.new_stream = false;
             eflags.clear_tx_queue = false;
             eflags.use_reset = false;
@@ -359,17 +362,22 @@ namespace quicr {
         object.object_id = object_id;
         object.publisher_priority = priority;
         object.extensions = extensions;
-        object.payload.assign(data.begin(), data.end());
-        track_handler.object_msg_buffer_ << object;
-
-        quic_transport_->Enqueue(track_handler.connection_handle_,
-                                 track_handler.publish_data_ctx_id_,
-                                 std::make_shared<std::vector<uint8_t>>(track_handler.object_msg_buffer_.begin(),
-                                                                        track_handler.object_msg_buffer_.end()),
-                                 priority,
-                                 ttl,
-                                 0,
-                                 eflags);
+        object.payload_len = data.size();
+        msg_buffer << object; // Header only, payload is enqueued as its own segment
+
+        // Only copy of the payload, it is gathered with the header when written to the network
+        auto payload =
+          data.empty() ? nullptr : std::make_shared<const std::vector<uint8_t>>(data.begin(), data.end());
+
+        objects[num_objects++] = { std::make_shared<std::vector<uint8_t>>(msg_buffer.begin(), msg_buffer.end()),
+                                   priority,
+                                   ttl,
+                                   eflags,
+                                   std::move(payload) };
+
+        quic_transport_->EnqueueBatch(track_handler.connection_handle_,
+                                      track_handler.publish_data_ctx_id_,
+                                      std::span(objects.data(), num_objects));
         return PublishTrackHandler::PublishObjectStatus::kOk;
     }
 
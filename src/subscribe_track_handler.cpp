@@ -12,6 +12,34 @@ namespace quicr {
     {
     }
 
+    void SubscribeTrackHandler::ObjectReceived(const ObjectHeaders& object_headers, const SharedSpan<uint8_t>& data)
+    {
+        ObjectReceived(object_headers, data.Span());
+    }
+
+    void SubscribeTrackHandler::ObjectsReceived(std::span<const ReceivedObject> objects)
+    {
+        for (const auto& object : objects) {
+            ObjectReceived(object.headers, object.data);
+        }
+    }
+
+    void SubscribeTrackHandler::QueueReceivedObject(ObjectHeaders&& object_headers, SharedSpan<uint8_t>&& payload)
+    {
+        received_objects_.push_back({ std::move(object_headers), std::move(payload) });
+    }
+
+    void SubscribeTrackHandler::NotifyReceivedObjects(SubscribeTrackHandler& handler)
+    {
+        if (received_objects_.empty()) {
+            return;
+        }
+
+        handler.ObjectsReceived(received_objects_);
+
+        received_objects_.clear();
+    }
+
     void SubscribeTrackHandler::StreamDataRecv(bool is_start,
                                                uint64_t stream_id,
                                                std::shared_ptr<const std::vector<uint8_t>> data)
@@ -28,7 +56,7 @@ namespace quicr {
             stream_buffer_.Clear();
 
             stream_buffer_.InitAny<messages::StreamHeaderSubGroup>();
-            stream_buffer_.Push(*data);
+            stream_buffer_.Push(data);
 
             // Expect that on initial start of stream, there is enough data to process the stream headers
 
@@ -39,7 +67,7 @@ namespace quicr {
                 return;
             }
         } else {
-            stream_buffer_.Push(*data);
+            stream_buffer_.Push(data);
         }
 
         auto& s_hdr = stream_buffer_.GetAny<messages::StreamHeaderSubGroup>();
@@ -48,9 +76,15 @@ namespace quicr {
             stream_buffer_.InitAnyB<messages::StreamSubGroupObject>();
         }
 
-        auto& obj = stream_buffer_.GetAnyB<messages::StreamSubGroupObject>();
-        obj.serialize_extensions = TypeWillSerializeExtensions(s_hdr.type);
-        if (stream_buffer_ >> obj) {
+        // Parse all objects in the received data, there can be many small objects in one slice
+        while (true) {
+            auto& obj = stream_buffer_.GetAnyB<messages::StreamSubGroupObject>();
+            obj.serialize_extensions = TypeWillSerializeExtensions(s_hdr.type);
+            obj.view_payload = true;
+            if (not(stream_buffer_ >> obj)) {
+                break;
+            }
+
             SPDLOG_TRACE("Received stream_subgroup_object type: {} priority: {} track_alias: {} "
                          "group_id: {} subgroup_id: {} object_id: {} data size: {}",
                          static_cast<std::uint8_t>(s_hdr.subgroup_type),
@@ -59,7 +93,7 @@ namespace quicr {
                          s_hdr.group_id,
                          s_hdr.subgroup_id.has_value() ? *s_hdr.subgroup_id : -1,
                          obj.object_id,
-                         obj.payload.size());
+                         obj.payload_view.size());
 
             if (!s_hdr.subgroup_id.has_value()) {
                 // TODO(RichLogan): This is a protocol error?
@@ -69,31 +103,34 @@ namespace quicr {
             }
 
             subscribe_track_metrics_.objects_received++;
-            subscribe_track_metrics_.bytes_received += obj.payload.size();
-
-            ObjectReceived({ s_hdr.group_id,
-                             obj.object_id,
-                             s_hdr.subgroup_id.value(),
-                             obj.payload.size(),
-                             obj.object_status,
-                             s_hdr.priority,
-                             std::nullopt,
-                             TrackMode::kStream,
-                             obj.extensions },
-                           obj.payload);
+            subscribe_track_metrics_.bytes_received += obj.payload_view.size();
+
+            QueueReceivedObject({ s_hdr.group_id,
+                                  obj.object_id,
+                                  s_hdr.subgroup_id.value(),
+                                  obj.payload_view.size(),
+                                  obj.object_status,
+                                  s_hdr.priority,
+                                  std::nullopt,
+                                  TrackMode::kStream,
+                                  std::move(obj.extensions) },
+                                std::move(obj.payload_view));
 
             stream_buffer_.ResetAnyB<messages::StreamSubGroupObject>();
         }
+
+        NotifyReceivedObjects(*this);
     }
 
     void SubscribeTrackHandler::DgramDataRecv(std::shared_ptr<const std::vector<uint8_t>> data)
     {
         stream_buffer_.Clear();
 
-        stream_buffer_.Push(*data);
+        stream_buffer_.Push(data);
         stream_buffer_.Pop(); // Remove type header
 
         messages::ObjectDatagram msg;
+        msg.view_payload = true;
         if (stream_buffer_ >> msg) {
             SPDLOG_TRACE("Received object datagram conn_id: {0} data_ctx_id: {1} subscriber_id: {2} "
                          "track_alias: {3} group_id: {4} object_id: {5} data size: {6}",
@@ -103,23 +140,22 @@ namespace quicr {
                          msg.track_alias,
                          msg.group_id,
                          msg.object_id,
-                         msg.payload.size());
+                         msg.payload_view.size());
 
             subscribe_track_metrics_.objects_received++;
-            subscribe_track_metrics_.bytes_received += msg.payload.size();
-            ObjectReceived(
-              {
-                msg.group_id,
-                msg.object_id,
-                0, // datagrams don't have subgroups
-                msg.payload.size(),
-                ObjectStatus::kAvailable,
-                msg.priority,
-                std::nullopt,
-                TrackMode::kDatagram,
-                msg.extensions,
-              },
-              std::move(msg.payload));
+            subscribe_track_metrics_.bytes_received += msg.payload_view.size();
+
+            const ReceivedObject object{ { msg.group_id,
+                                           msg.object_id,
+                                           0, // datagrams don't have subgroups
+                                           msg.payload_view.size(),
+                                           ObjectStatus::kAvailable,
+                                           msg.priority,
+                                           std::nullopt,
+                                           TrackMode::kDatagram,
+                                           std::move(msg.extensions) },
+                                         std::move(msg.payload_view) };
+            ObjectsReceived({ &object, 1 });
         }
     }
 
@@ -134,8 +134,7 @@ namespace quicr {
             StatusChanged(status_);
 
             SPDLOG_LOGGER_INFO(logger_, "Connecting session conn_id: {0}...", conn_id);
-            auto [conn_ctx, _] = connections_.try_emplace(conn_id, ConnectionContext{});
-            conn_ctx->second.connection_handle = conn_id;
+            GetOrCreateConnContext(conn_id);
 
             return status_;
         } else {
@@ -190,7 +189,13 @@ namespace quicr {
         // SAH - FIXME - preallocate "buffer" to encode the data...
         buffer << client_setup;
 
+        std::unique_lock<std::mutex> lock(state_mutex_);
+        if (connections_.empty()) {
+            return;
+        }
+
         auto& conn_ctx = connections_.begin()->second;
+        lock.unlock();
 
         SendCtrlMsg(conn_ctx, buffer);
     }
@@ -676,7 +681,7 @@ namespace quicr {
     void Transport::UnsubscribeTrack(quicr::TransportConnId conn_id,
                                      const std::shared_ptr<SubscribeTrackHandler>& track_handler)
     {
-        auto& conn_ctx = connections_[conn_id];
+        auto& conn_ctx = GetOrCreateConnContext(conn_id);
         RemoveSubscribeTrack(conn_ctx, *track_handler);
     }
 
@@ -858,6 +863,8 @@ namespace quicr {
                                              track_handler->default_track_mode_ == TrackMode::kDatagram ? false : true,
                                              track_handler->default_priority_,
                                              false);
+        SetPublishTxQueueBudget(*track_handler);
+        SetPublishTxRateLimit(*track_handler);
 
         // Setup the function for the track handler to use to send objects with thread safety
         std::weak_ptr<PublishTrackHandler> weak_handler(track_handler);
@@ -977,7 +984,9 @@ namespace quicr {
 
         switch (track_handler.default_track_mode_) {
             case TrackMode::kDatagram: {
+                const auto& tcfg = client_mode_ ? client_config_.transport_config : server_config_.transport_config;
                 eflags.use_reliable = false;
+                eflags.new_group = stream_header_needed && tcfg.tx_drop_stale_groups;
                 break;
             }
             default: {
@@ -993,10 +1002,10 @@ namespace quicr {
             }
         }
 
-        quic_transport_->Enqueue(
+        const auto error = quic_transport_->Enqueue(
           track_handler.connection_handle_, track_handler.publish_data_ctx_id_, data, priority, ttl, 0, eflags);
 
-        return PublishTrackHandler::PublishObjectStatus::kOk;
+        return EnqueueStatus(error);
     }
 
     PublishTrackHandler::PublishObjectStatus Transport::SendObject(PublishTrackHandler& track_handler,
@@ -1019,7 +1028,11 @@ namespace quicr {
 
         ITransport::EnqueueFlags eflags;
 
-        track_handler.object_msg_buffer_.clear();
+        // Subgroup header and object are enqueued together
+        std::array<ITransport::EnqueueObject, 2> objects;
+        std::size_t num_objects = 0;
+
+        auto& msg_buffer = ObjectMsgBuffer();
 
         switch (track_handler.default_track_mode_) {
             case TrackMode::kDatagram: {
@@ -1029,8 +1042,10 @@ namespace quicr {
                 object.priority = priority;
                 object.track_alias = *track_handler.GetTrackAlias();
                 object.extensions = extensions;
-                object.payload.assign(data.begin(), data.end());
-                track_handler.object_msg_buffer_ << object;
+                msg_buffer << object; // Header only, payload is enqueued as its own segment
+
+                const auto& tcfg = client_mode_ ? client_config_.transport_config : server_config_.transport_config;
+                eflags.new_group = stream_header_needed && tcfg.tx_drop_stale_groups;
                 break;
             }
             default: {
@@ -1048,19 +1063,16 @@ namespace quicr {
                     subgroup_hdr.subgroup_id = subgroup_id;
                     subgroup_hdr.priority = priority;
                     subgroup_hdr.track_alias = *track_handler.GetTrackAlias();
-                    track_handler.object_msg_buffer_ << subgroup_hdr;
-
-                    quic_transport_->Enqueue(
-                      track_handler.connection_handle_,
-                      track_handler.publish_data_ctx_id_,
-                      std::make_shared<std::vector<uint8_t>>(track_handler.object_msg_buffer_.begin(),
-                                                             track_handler.object_msg_buffer_.end()),
-                      priority,
-                      ttl,
-                      0,
-                      eflags);
-
-                    track_handler.object_msg_buffer_.clear();
+                    msg_buffer << subgroup_hdr;
+
+                    objects[num_objects++] = { std::make_shared<std::vector<uint8_t>>(
+                                                 msg_buffer.begin(), msg_buffer.end()),
+                                               priority,
+                                               ttl,
+                                               eflags,
+                                               nullptr };
+
+                    msg_buffer.clear();
                     eflags.new_stream = false;
                     eflags.clear_tx_queue = false;
                     eflags.use_reset = false;
@@ -1070,20 +1082,67 @@ namespace quicr {
                 object.object_id = object_id;
                 object.serialize_extensions = TypeWillSerializeExtensions(track_handler.GetStreamMode());
                 object.extensions = extensions;
-                object.payload.assign(data.begin(), data.end());
-                track_handler.object_msg_buffer_ << object;
+                object.payload_len = data.size();
+                msg_buffer << object; // Header only, payload is enqueued as its own segment
                 break;
             }
         }
 
-        quic_transport_->Enqueue(track_handler.connection_handle_,
-                                 track_handler.publish_data_ctx_id_,
-                                 std::make_shared<std::vector<uint8_t>>(track_handler.object_msg_buffer_.begin(),
-                                                                        track_handler.object_msg_buffer_.end()),
-                                 priority,
-                                 ttl,
-                                 0,
-                                 eflags);
+        // Only copy of the payload, it is gathered with the header when written to the network
+        auto payload =
+          data.empty() ? nullptr : std::make_shared<const std::vector<uint8_t>>(data.begin(), data.end());
+
+        objects[num_objects++] = { std::make_shared<std::vector<uint8_t>>(msg_buffer.begin(), msg_buffer.end()),
+                                   priority,
+                                   ttl,
+                                   eflags,
+                                   std::move(payload) };
+
+        const auto error = quic_transport_->EnqueueBatch(track_handler.connection_handle_,
+                                                         track_handler.publish_data_ctx_id_,
+                                                         std::span(objects.data(), num_objects));
+
+        return EnqueueStatus(error);
+    }
+
+    Bytes& Transport::ObjectMsgBuffer()
+    {
+        thread_local Bytes buffer;
+        buffer.clear();
+        return buffer;
+    }
+
+    void Transport::SetPublishTxQueueBudget(const PublishTrackHandler& track_handler)
+    {
+        const auto& tcfg = client_mode_ ? client_config_.transport_config : server_config_.transport_config;
+        const auto budget = track_handler.tx_queue_budget_.value_or(
+          PublishTrackHandler::TxQueueBudget{ tcfg.tx_queue_max_bytes, tcfg.tx_queue_max_objects });
+
+        if (budget.max_bytes == 0 && budget.max_objects == 0) {
+            return;
+        }
+
+        quic_transport_->SetDataCtxTxBudget(
+          track_handler.connection_handle_, track_handler.publish_data_ctx_id_, budget.max_bytes, budget.max_objects);
+    }
+
+    void Transport::SetPublishTxRateLimit(const PublishTrackHandler& track_handler)
+    {
+        if (!track_handler.tx_rate_limit_.has_value() || track_handler.tx_rate_limit_->rate_bps == 0) {
+            return;
+        }
+
+        quic_transport_->SetDataCtxRateLimit(track_handler.connection_handle_,
+                                             track_handler.publish_data_ctx_id_,
+                                             track_handler.tx_rate_limit_->rate_bps,
+                                             track_handler.tx_rate_limit_->burst_bytes);
+    }
+
+    PublishTrackHandler::PublishObjectStatus Transport::EnqueueStatus(TransportError error)
+    {
+        if (error == TransportError::kQueueFull) {
+            return PublishTrackHandler::PublishObjectStatus::kQueueFull;
+        }
 
         return PublishTrackHandler::PublishObjectStatus::kOk;
     }
@@ -1103,6 +1162,30 @@ namespace quicr {
         return pub_n_it->second;
     }
 
+    Transport::ConnectionContext* Transport::FindConnContext(ConnectionHandle conn_id)
+    {
+        std::lock_guard<std::mutex> _(state_mutex_);
+
+        auto conn_it = connections_.find(conn_id);
+        if (conn_it == connections_.end()) {
+            return nullptr;
+        }
+
+        return &conn_it->second;
+    }
+
+    Transport::ConnectionContext& Transport::GetOrCreateConnContext(ConnectionHandle conn_id)
+    {
+        std::lock_guard<std::mutex> _(state_mutex_);
+
+        auto [conn_it, is_new] = connections_.try_emplace(conn_id, ConnectionContext{});
+        if (is_new) {
+            conn_it->second.connection_handle = conn_id;
+        }
+
+        return conn_it->second;
+    }
+
     void Transport::RemoveAllTracksForConnectionClose(ConnectionContext& conn_ctx)
     {
         // clean up subscriber handlers on disconnect
@@ -1136,7 +1219,7 @@ namespace quicr {
         switch (status) {
             case TransportStatus::kReady: {
                 if (client_mode_) {
-                    auto& conn_ctx = connections_[conn_id];
+                    auto& conn_ctx = GetOrCreateConnContext(conn_id);
                     SPDLOG_LOGGER_INFO(logger_,
                                        "Connection established, creating bi-dir stream and sending CLIENT_SETUP");
 
@@ -1191,18 +1274,18 @@ namespace quicr {
 
         if (remove_connection) {
             // Clean up publish and subscribe tracks
-            auto conn_it = connections_.find(conn_id);
-            if (conn_it != connections_.end()) {
+            if (auto conn_ctx = FindConnContext(conn_id)) {
                 if (client_mode_) {
                     status_ = Status::kNotConnected;
                 }
 
-                RemoveAllTracksForConnectionClose(conn_it->second);
+                RemoveAllTracksForConnectionClose(*conn_ctx);
 
                 ConnectionStatusChanged(conn_id, conn_status);
 
+                // Erase by key, iterators are invalidated by inserts of other connections
                 std::lock_guard<std::mutex> _(state_mutex_);
-                connections_.erase(conn_it);
+                connections_.erase(conn_id);
             }
         }
 
@@ -1211,9 +1294,8 @@ namespace quicr {
 
     void Transport::OnNewConnection(const TransportConnId& conn_id, const TransportRemote& remote)
     {
-        auto [conn_ctx, is_new] = connections_.try_emplace(conn_id, ConnectionContext{});
+        GetOrCreateConnContext(conn_id);
 
-        conn_ctx->second.connection_handle = conn_id;
         NewConnectionAccepted(conn_id, { remote.host_or_ip, remote.port });
     }
 
@@ -1223,7 +1305,7 @@ namespace quicr {
                                  const bool is_bidir)
     try {
         auto rx_ctx = quic_transport_->GetStreamRxContext(conn_id, stream_id);
-        auto& conn_ctx = connections_[conn_id];
+        auto& conn_ctx = GetOrCreateConnContext(conn_id);
 
         if (rx_ctx == nullptr) {
             return;
@@ -1470,7 +1552,7 @@ namespace quicr {
                     SPDLOG_LOGGER_DEBUG(logger_,
                                         "Received datagram that is not message type kObjectDatagram or "
                                         "kObjectDatagramStatus, dropping");
-                    auto& conn_ctx = connections_[conn_id];
+                    auto& conn_ctx = GetOrCreateConnContext(conn_id);
                     conn_ctx.metrics.rx_dgram_invalid_type++;
                     continue;
                 }
@@ -1488,7 +1570,7 @@ namespace quicr {
                     continue; // Invalid, not enough bytes to decode
                 }
 
-                auto& conn_ctx = connections_[conn_id];
+                auto& conn_ctx = GetOrCreateConnContext(conn_id);
                 auto sub_it = conn_ctx.sub_by_track_alias.find(track_alias);
                 if (sub_it == conn_ctx.sub_by_track_alias.end()) {
                     conn_ctx.metrics.rx_dgram_unknown_track_alias++;
@@ -1514,7 +1596,7 @@ namespace quicr {
 
                 handler->DgramDataRecv(data);
             } else if (data) {
-                auto& conn_ctx = connections_[conn_id];
+                auto& conn_ctx = GetOrCreateConnContext(conn_id);
                 conn_ctx.metrics.rx_dgram_decode_failed++;
 
                 SPDLOG_LOGGER_DEBUG(logger_,
@@ -1530,8 +1612,7 @@ namespace quicr {
                                                const TransportConnId conn_id,
                                                const QuicConnectionMetrics& quic_connection_metrics)
     {
-        // TODO: doesn't require lock right now, but might need to add lock
-        auto& conn = connections_[conn_id];
+        auto& conn = GetOrCreateConnContext(conn_id);
 
         conn.metrics.last_sample_time = sample_time.time_since_epoch() / std::chrono::microseconds(1);
         conn.metrics.quic = quic_connection_metrics;
@@ -1548,7 +1629,7 @@ namespace quicr {
                                           const DataContextId data_ctx_id,
                                           const QuicDataContextMetrics& quic_data_context_metrics)
     {
-        const auto& conn = connections_[conn_id];
+        const auto& conn = GetOrCreateConnContext(conn_id);
         const auto& pub_th_it = conn.pub_tracks_by_data_ctx_id.find(data_ctx_id);
 
         if (pub_th_it != conn.pub_tracks_by_data_ctx_id.end()) {
@@ -1560,10 +1641,16 @@ namespace quicr {
             pub_h->publish_track_metrics_.quic.tx_callback_ms = quic_data_context_metrics.tx_callback_ms;
             pub_h->publish_track_metrics_.quic.tx_delayed_callback = quic_data_context_metrics.tx_delayed_callback;
             pub_h->publish_track_metrics_.quic.tx_object_duration_us = quic_data_context_metrics.tx_object_duration_us;
+            pub_h->publish_track_metrics_.quic.tx_objects_per_callback =
+              quic_data_context_metrics.tx_objects_per_callback;
             pub_h->publish_track_metrics_.quic.tx_queue_discards = quic_data_context_metrics.tx_queue_discards;
             pub_h->publish_track_metrics_.quic.tx_queue_expired = quic_data_context_metrics.tx_queue_expired;
+            pub_h->publish_track_metrics_.quic.tx_queue_full = quic_data_context_metrics.tx_queue_full;
+            pub_h->publish_track_metrics_.quic.tx_group_drops = quic_data_context_metrics.tx_group_drops;
             pub_h->publish_track_metrics_.quic.tx_queue_size = quic_data_context_metrics.tx_queue_size;
             pub_h->publish_track_metrics_.quic.tx_reset_wait = quic_data_context_metrics.tx_reset_wait;
+            pub_h->publish_track_metrics_.quic.tx_rate_limited = quic_data_context_metrics.tx_rate_limited;
+            pub_h->publish_track_metrics_.quic.tx_rate_tokens = quic_data_context_metrics.tx_rate_tokens;
 
             pub_h->MetricsSampled(pub_h->publish_track_metrics_);
         }
@@ -1573,6 +1660,39 @@ namespace quicr {
         }
     }
 
+    void Transport::OnDataContextBackpressure(const ConnectionHandle& connection_handle,
+                                              const DataContextId& data_ctx_id)
+    {
+        SetTxQueueStatus(connection_handle, data_ctx_id, PublishTrackHandler::TxQueueStatus::kBackpressure);
+    }
+
+    void Transport::OnDataContextDrained(const ConnectionHandle& connection_handle, const DataContextId& data_ctx_id)
+    {
+        SetTxQueueStatus(connection_handle, data_ctx_id, PublishTrackHandler::TxQueueStatus::kDrained);
+    }
+
+    void Transport::SetTxQueueStatus(const ConnectionHandle& connection_handle,
+                                     const DataContextId& data_ctx_id,
+                                     PublishTrackHandler::TxQueueStatus status)
+    {
+        std::unique_lock<std::mutex> lock(state_mutex_);
+
+        const auto conn_it = connections_.find(connection_handle);
+        if (conn_it == connections_.end()) {
+            return;
+        }
+
+        const auto pub_th_it = conn_it->second.pub_tracks_by_data_ctx_id.find(data_ctx_id);
+        if (pub_th_it == conn_it->second.pub_tracks_by_data_ctx_id.end()) {
+            return;
+        }
+
+        const auto track_handler = pub_th_it->second;
+        lock.unlock();
+
+        track_handler->SetTxQueueStatus(status);
+    }
+
     void Transport::OnNewDataContext(const ConnectionHandle&, const DataContextId&) {}
 
     void Transport::CloseConnection(TransportConnId conn_id,
@@ -18,15 +18,20 @@
 #include <quicr/detail/quic_transport_metrics.h>
 #include <quicr/detail/safe_queue.h>
 #include <quicr/detail/stream_buffer.h>
+#include <quicr/detail/task_queue.h>
 #include <quicr/detail/time_queue.h>
+#include <quicr/detail/udp_batch_socket.h>
 #include <spdlog/logger.h>
 
 // System.
 #include "picoquic_bbr.h"
 #include "picoquic_newreno.h"
 
+#include <algorithm>
 #include <arpa/inet.h>
+#include <array>
 #include <cassert>
+#include <cerrno>
 #include <chrono>
 #include <cstdint>
 #include <cstring>
@@ -39,14 +44,17 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <sys/select.h>
 #include <sys/socket.h>
 #include <thread>
+#include <unistd.h>
 #include <utility>
 #include <vector>
 
 #if defined(__linux__)
 #include <net/ethernet.h>
 #include <netpacket/packet.h>
+#include <poll.h>
 #endif
 
 using namespace quicr;
@@ -65,16 +73,18 @@ PqEventCb(picoquic_cnx_t* pq_cnx,
           void* callback_ctx,
           void* v_stream_ctx)
 {
-    PicoQuicTransport* transport = static_cast<PicoQuicTransport*>(callback_ctx);
+    auto* shard = static_cast<PicoQuicTransport::Shard*>(callback_ctx);
     PicoQuicTransport::DataContext* data_ctx = static_cast<PicoQuicTransport::DataContext*>(v_stream_ctx);
-    const auto conn_id = reinterpret_cast<uint64_t>(pq_cnx);
 
     bool is_fin = false;
 
-    if (transport == NULL) {
+    if (shard == NULL || shard->transport == NULL) {
         return PICOQUIC_ERROR_UNEXPECTED_ERROR;
     }
 
+    PicoQuicTransport* transport = shard->transport;
+    const auto conn_id = PicoQuicTransport::MakeConnId(*shard, pq_cnx);
+
     switch (fin_or_event) {
 
         case picoquic_callback_prepare_datagram: {
@@ -290,6 +300,9 @@ PqEventCb(picoquic_cnx_t* pq_cnx,
 
             transport->Close(conn_id, app_reason_code);
 
+            // No more callbacks for the connection, picoquic may reuse its pointer for a new connection
+            shard->conn_ids.erase(pq_cnx);
+
             if (not transport->is_server_mode) {
                 // TODO: Fix picoquic. Apparently picoquic is not processing return values for this callback
                 return PICOQUIC_NO_ERROR_TERMINATE_PACKET_LOOP;
@@ -300,7 +313,7 @@ PqEventCb(picoquic_cnx_t* pq_cnx,
 
         case picoquic_callback_ready: { // Connection callback, not per stream
             if (transport->is_server_mode) {
-                transport->CreateConnContext(pq_cnx);
+                transport->CreateConnContext(*shard, pq_cnx);
                 transport->OnNewConnection(conn_id);
             } else {
                 // Client
@@ -324,23 +337,25 @@ PqEventCb(picoquic_cnx_t* pq_cnx,
 int
 PqLoopCb(picoquic_quic_t* quic, picoquic_packet_loop_cb_enum cb_mode, void* callback_ctx, void* callback_arg)
 {
-    PicoQuicTransport* transport = static_cast<PicoQuicTransport*>(callback_ctx);
+    auto* shard = static_cast<PicoQuicTransport::Shard*>(callback_ctx);
     int ret = 0;
 
-    if (transport == NULL) {
+    if (shard == NULL || shard->transport == NULL) {
         std::cerr << "picoquic transport was called with NULL transport" << '\n';
         return PICOQUIC_ERROR_UNEXPECTED_ERROR;
     }
 
+    PicoQuicTransport* transport = shard->transport;
+
     if (transport->Status() == TransportStatus::kDisconnected) {
         return PICOQUIC_NO_ERROR_TERMINATE_PACKET_LOOP;
     }
 
-    transport->PqRunner();
+    transport->PqRunner(*shard);
 
     switch (cb_mode) {
         case picoquic_packet_loop_ready: {
-            SPDLOG_LOGGER_INFO(transport->logger, "packet_loop_ready, waiting for packets");
+            SPDLOG_LOGGER_INFO(transport->logger, "packet_loop_ready, shard: {0} waiting for packets", shard->index);
 
             if (transport->is_server_mode)
                 transport->SetStatus(TransportStatus::kReady);
@@ -370,39 +385,44 @@ PqLoopCb(picoquic_quic_t* quic, picoquic_packet_loop_cb_enum cb_mode, void* call
         case picoquic_packet_loop_time_check: {
             packet_loop_time_check_arg_t* targ = static_cast<packet_loop_time_check_arg_t*>(callback_arg);
 
-            if (targ->delta_t > kPqLoopMaxDelayUs) {
-                targ->delta_t = kPqLoopMaxDelayUs;
+            // Loops that are woken up by events do not need to poll for queued work
+            const int64_t max_delay_us = shard->event_wakeup ? kPqLoopIdleMaxDelayUs : kPqLoopMaxDelayUs;
+            if (targ->delta_t > max_delay_us) {
+                targ->delta_t = max_delay_us;
             }
 
-            if (!transport->pq_loop_prev_time) {
-                transport->pq_loop_prev_time = targ->current_time;
+            transport->ResumePacedStreams(*shard, targ->delta_t);
+
+            if (!shard->pq_loop_prev_time) {
+                shard->pq_loop_prev_time = targ->current_time;
             }
 
-            if (targ->current_time - transport->pq_loop_metrics_prev_time >= kMetricsIntervalUs) {
-                // Use this time to clean up streams that have been closed
-                transport->RemoveClosedStreams();
+            if (targ->current_time - shard->pq_loop_metrics_prev_time >= kMetricsIntervalUs) {
+                // Use this time to clean up streams and connections that have been closed
+                transport->RemoveClosedStreams(*shard);
+                shard->conn_table.Reclaim();
 
-                if (transport->pq_loop_metrics_prev_time) {
-                    transport->EmitMetrics();
+                if (shard->pq_loop_metrics_prev_time) {
+                    transport->EmitMetrics(*shard);
                 }
 
-                transport->pq_loop_metrics_prev_time = targ->current_time;
+                shard->pq_loop_metrics_prev_time = targ->current_time;
             }
 
-            if (targ->current_time - transport->pq_loop_prev_time > kCongestionCheckInterval) {
+            if (targ->current_time - shard->pq_loop_prev_time > kCongestionCheckInterval) {
 
-                transport->CheckConnsForCongestion();
+                transport->CheckConnsForCongestion(*shard);
 
-                transport->pq_loop_prev_time = targ->current_time;
+                shard->pq_loop_prev_time = targ->current_time;
             }
 
             // Stop loop if done shutting down
-            if (transport->Status() == TransportStatus::kShutdown) {
+            if (transport->Status() == TransportStatus::kShutdown || shard->shutdown_complete) {
                 return PICOQUIC_NO_ERROR_TERMINATE_PACKET_LOOP;
             }
 
             if (transport->Status() == TransportStatus::kShuttingDown) {
-                SPDLOG_LOGGER_INFO(transport->logger, "picoquic is shutting down");
+                SPDLOG_LOGGER_INFO(transport->logger, "picoquic shard {0} is shutting down", shard->index);
 
                 picoquic_cnx_t* close_cnx = picoquic_get_first_cnx(quic);
 
@@ -411,13 +431,14 @@ PqLoopCb(picoquic_quic_t* quic, picoquic_packet_loop_cb_enum cb_mode, void* call
                 }
 
                 while (close_cnx != NULL) {
-                    SPDLOG_LOGGER_INFO(
-                      transport->logger, "Closing connection id {0}", reinterpret_cast<uint64_t>(close_cnx));
-                    transport->Close(reinterpret_cast<uint64_t>(close_cnx));
+                    const auto conn_id = PicoQuicTransport::MakeConnId(*shard, close_cnx);
+                    SPDLOG_LOGGER_INFO(transport->logger, "Closing connection id {0}", conn_id);
+                    transport->Close(conn_id);
                     close_cnx = picoquic_get_next_cnx(close_cnx);
                 }
 
-                transport->SetStatus(TransportStatus::kShutdown);
+                // Other shards may still be closing their connections, only this loop is done
+                shard->shutdown_complete = true;
             }
 
             break;
@@ -446,8 +467,6 @@ PicoQuicTransport::Status() const
 TransportConnId
 PicoQuicTransport::Start()
 {
-    uint64_t current_time = picoquic_current_time();
-
     if (debug) {
         debug_set_stream(stderr);
     }
@@ -469,20 +488,6 @@ PicoQuicTransport::Start()
     (void)picoquic_config_set_option(
       &config_, picoquic_option_MAX_CONNECTIONS, std::to_string(tconfig_.max_connections).c_str());
 
-    quic_ctx_ = picoquic_create_and_configure(&config_, PqEventCb, this, current_time, NULL);
-
-    if (quic_ctx_ == NULL) {
-        SPDLOG_LOGGER_CRITICAL(logger, "Unable to create picoquic context, check certificate and key filenames");
-        throw PicoQuicException("Unable to create picoquic context");
-    }
-
-    if (config_.enable_sslkeylog) {
-        if (std::getenv("SSLKEYLOGFILE") == nullptr) {
-            SPDLOG_LOGGER_WARN(logger, "Key log enabled but $SSLKEYLOGFILE not set");
-        }
-        picoquic_set_key_log_file_from_env(quic_ctx_);
-    }
-
     /*
      * TODO doc: Apparently need to set some value to send datagrams. If not set,
      *    max datagram size is zero, preventing sending of datagrams. Setting this
@@ -497,60 +502,99 @@ PicoQuicTransport::Start()
     local_tp_options_.max_ack_delay = 100000;
     local_tp_options_.min_ack_delay = 1000;
 
-    picoquic_set_default_handshake_timeout(quic_ctx_, (tconfig_.idle_timeout_ms * 1000) / 2);
-    picoquic_set_default_tp(quic_ctx_, &local_tp_options_);
-    picoquic_set_default_idle_timeout(quic_ctx_, tconfig_.idle_timeout_ms);
-    picoquic_set_default_priority(quic_ctx_, 2);
-    picoquic_set_default_datagram_priority(quic_ctx_, 1);
-
     SPDLOG_LOGGER_INFO(logger, "Setting idle timeout to {0}ms", tconfig_.idle_timeout_ms);
     // picoquic_set_default_wifi_shadow_rtt(quic_ctx, tconfig.quic_wifi_shadow_rtt_us);
     // logger->info << "Setting wifi shadow RTT to " << tconfig.quic_wifi_shadow_rtt_us << "us" << std::flush;
 
-    picoquic_runner_queue_.SetLimit(2000);
+    const size_t num_shards = is_server_mode ? std::max<size_t>(tconfig_.server_threads, 1) : 1;
+
+    for (size_t i = 0; i < num_shards; i++) {
+        auto& shard = shards_.emplace_back(std::make_unique<Shard>());
+        shard->transport = this;
+        shard->index = i;
+        shard->rx_buffer_pool = BufferPool(tconfig_.rx_buffer_pool_size, kRxBufferSize);
 
-    cbNotifyQueue_.SetLimit(2000);
-    cbNotifyThread_ = std::thread(&PicoQuicTransport::CbNotifier, this);
+        CreateQuicContext(*shard);
+    }
+
+    const size_t num_notify_workers = std::max<size_t>(tconfig_.notify_threads, 1);
+
+    for (size_t i = 0; i < num_notify_workers; i++) {
+        auto& worker = notify_workers_.emplace_back(std::make_unique<NotifyWorker>());
+        worker->index = i;
+        worker->thread = std::thread(&PicoQuicTransport::CbNotifier, this, std::ref(*worker));
+    }
 
     TransportConnId cid = 0;
     std::ostringstream log_msg;
 
     if (is_server_mode) {
 
-        SPDLOG_LOGGER_INFO(logger, "Starting server, listening on {0}:{1}", serverInfo_.host_or_ip, serverInfo_.port);
-
-        picoQuicThread_ = std::thread(&PicoQuicTransport::Server, this);
+        SPDLOG_LOGGER_INFO(logger,
+                           "Starting server, listening on {0}:{1} using {2} packet loop threads",
+                           serverInfo_.host_or_ip,
+                           serverInfo_.port,
+                           shards_.size());
+
+        running_shards_ = shards_.size();
+        for (auto& shard : shards_) {
+            shard->thread = std::thread(&PicoQuicTransport::Server, this, std::ref(*shard));
+        }
 
     } else {
         SPDLOG_LOGGER_INFO(logger, "Connecting to server {0}:{1}", serverInfo_.host_or_ip, serverInfo_.port);
 
         if ((cid = CreateClient())) {
-            picoQuicThread_ = std::thread(&PicoQuicTransport::Client, this, cid);
+            shards_.front()->thread = std::thread(&PicoQuicTransport::Client, this, cid);
         }
     }
 
+    return cid;
+}
+
+void
+PicoQuicTransport::CreateQuicContext(Shard& shard)
+{
+    shard.quic_ctx = picoquic_create_and_configure(&config_, PqEventCb, &shard, picoquic_current_time(), NULL);
+
+    if (shard.quic_ctx == NULL) {
+        SPDLOG_LOGGER_CRITICAL(logger, "Unable to create picoquic context, check certificate and key filenames");
+        throw PicoQuicException("Unable to create picoquic context");
+    }
+
+    if (config_.enable_sslkeylog) {
+        if (std::getenv("SSLKEYLOGFILE") == nullptr) {
+            SPDLOG_LOGGER_WARN(logger, "Key log enabled but $SSLKEYLOGFILE not set");
+        }
+        picoquic_set_key_log_file_from_env(shard.quic_ctx);
+    }
+
+    picoquic_set_default_handshake_timeout(shard.quic_ctx, (tconfig_.idle_timeout_ms * 1000) / 2);
+    picoquic_set_default_tp(shard.quic_ctx, &local_tp_options_);
+    picoquic_set_default_idle_timeout(shard.quic_ctx, tconfig_.idle_timeout_ms);
+    picoquic_set_default_priority(shard.quic_ctx, 2);
+    picoquic_set_default_datagram_priority(shard.quic_ctx, 1);
+
     if (!tconfig_.quic_qlog_path.empty()) {
         SPDLOG_LOGGER_INFO(logger, "Enabling qlog using '{0}' path", tconfig_.quic_qlog_path);
-        picoquic_set_qlog(quic_ctx_, tconfig_.quic_qlog_path.c_str());
+        picoquic_set_qlog(shard.quic_ctx, tconfig_.quic_qlog_path.c_str());
     }
-
-    return cid;
 }
 
 bool
 PicoQuicTransport::GetPeerAddrInfo(const TransportConnId& conn_id, sockaddr_storage* addr)
 {
-    std::lock_guard<std::mutex> _(state_mutex_);
+    const auto conn_table = GetShard(conn_id).conn_table.Read();
 
     // Locate the specified transport connection context
-    auto it = conn_context_.find(conn_id);
+    auto it = conn_table->find(conn_id);
 
     // If not found, return false
-    if (it == conn_context_.end())
+    if (it == conn_table->end())
         return false;
 
     // Copy the address
-    std::memcpy(addr, &it->second.peer_addr, sizeof(sockaddr_storage));
+    std::memcpy(addr, &it->second->peer_addr, sizeof(sockaddr_storage));
 
     return true;
 }
@@ -564,83 +608,145 @@ PicoQuicTransport::Enqueue(const TransportConnId& conn_id,
                            [[maybe_unused]] const uint32_t delay_ms,
                            const EnqueueFlags flags)
 {
-    if (bytes->empty()) {
-        SPDLOG_LOGGER_ERROR(
-          logger, "enqueue dropped due bytes empty, conn_id: {0} data_ctx_id: {1}", conn_id, data_ctx_id);
+    EnqueueObject object{ std::move(bytes), priority, ttl_ms, flags, nullptr };
+    return EnqueueBatch(conn_id, data_ctx_id, { &object, 1 });
+}
+
+TransportError
+PicoQuicTransport::EnqueueBatch(const TransportConnId& conn_id,
+                                const DataContextId& data_ctx_id,
+                                std::span<EnqueueObject> objects)
+{
+    if (objects.empty()) {
         return TransportError::kNone;
     }
 
-    std::lock_guard<std::mutex> _(state_mutex_);
+    auto& shard = GetShard(conn_id);
+    const auto conn_table = shard.conn_table.Read();
 
-    const auto conn_ctx_it = conn_context_.find(conn_id);
-    if (conn_ctx_it == conn_context_.end()) {
+    const auto conn_ctx_it = conn_table->find(conn_id);
+    if (conn_ctx_it == conn_table->end()) {
         return TransportError::kInvalidConnContextId;
     }
 
-    const auto data_ctx_it = conn_ctx_it->second.active_data_contexts.find(data_ctx_id);
-    if (data_ctx_it == conn_ctx_it->second.active_data_contexts.end()) {
+    auto& conn_ctx = *conn_ctx_it->second;
+    std::lock_guard<std::mutex> _(conn_ctx.mutex);
+
+    const auto data_ctx_it = conn_ctx.active_data_contexts.find(data_ctx_id);
+    if (data_ctx_it == conn_ctx.active_data_contexts.end()) {
         return TransportError::kInvalidDataContextId;
     }
 
-    data_ctx_it->second.priority = priority; // Match object priority for next stream create
+    auto& data_ctx = data_ctx_it->second;
+    const auto tick_microseconds = tick_service_->Microseconds();
+
+    if (!data_ctx.TxQueueAdmit(objects)) {
+        // Notified by the packet loop so that it is ordered with the drained notification
+        if (!data_ctx.tx_backpressure_pending.exchange(true)) {
+            shard.RunOnLoop([this, conn_id, data_ctx_id]() { SetTxBackpressure(conn_id, data_ctx_id); });
+        }
+        return TransportError::kQueueFull;
+    }
+
+    bool stream_enqueued{ false };
+    bool dgram_enqueued{ false };
 
-    data_ctx_it->second.metrics.enqueued_objs++;
+    for (auto& object : objects) {
+        if (!object.bytes || object.bytes->empty()) {
+            SPDLOG_LOGGER_ERROR(
+              logger, "enqueue dropped due bytes empty, conn_id: {0} data_ctx_id: {1}", conn_id, data_ctx_id);
+            continue;
+        }
 
-    if (flags.use_reliable) {
-        StreamAction stream_action{ StreamAction::kNoAction };
+        data_ctx.priority = object.priority; // Match object priority for next stream create
 
-        if (flags.new_stream) {
-            data_ctx_it->second.tx_start_stream = true;
+        data_ctx.metrics.enqueued_objs++;
 
-            if (flags.use_reset) {
-                stream_action = StreamAction::kReplaceStreamUseReset;
-            } else {
-                stream_action = StreamAction::kReplaceStreamUseFin;
+        if (object.flags.use_reliable) {
+            StreamAction stream_action{ StreamAction::kNoAction };
+
+            if (object.flags.new_stream) {
+                data_ctx.tx_start_stream = true;
+
+                if (object.flags.use_reset) {
+                    stream_action = StreamAction::kReplaceStreamUseReset;
+                } else {
+                    stream_action = StreamAction::kReplaceStreamUseFin;
+                }
             }
-        }
 
-        if (flags.clear_tx_queue) {
-            data_ctx_it->second.metrics.tx_queue_discards += data_ctx_it->second.tx_data->Size();
-            data_ctx_it->second.tx_data->Clear();
-        }
+            if (object.flags.clear_tx_queue) {
+                data_ctx.metrics.tx_queue_discards += data_ctx.tx_data->Size();
+                data_ctx.tx_data->Clear();
+            }
 
-        ConnData cd{ conn_id, data_ctx_id, priority, stream_action, std::move(bytes), tick_service_->Microseconds() };
-        data_ctx_it->second.tx_data->Push(std::move(cd), ttl_ms, priority, 0);
+            data_ctx.tx_data->Emplace(object.ttl_ms,
+                                      object.priority,
+                                      0,
+                                      conn_id,
+                                      data_ctx_id,
+                                      object.priority,
+                                      stream_action,
+                                      std::move(object.bytes),
+                                      tick_microseconds,
+                                      std::move(object.payload));
+            stream_enqueued = true;
+        }
 
-        if (!data_ctx_it->second.mark_stream_active) {
-            data_ctx_it->second.mark_stream_active = true;
+        else { // datagram
+            if (object.flags.new_group) {
+                // Datagrams of all data contexts share a queue, only drop the ones of this data context
+                data_ctx.metrics.tx_group_drops +=
+                  conn_ctx.dgram_tx_data->EraseIf([data_ctx_id, priority = object.priority](const ConnData& cd) {
+                      return cd.data_ctx_id == data_ctx_id && cd.priority >= priority;
+                  });
+            }
 
-            picoquic_runner_queue_.Push([this, conn_id, data_ctx_id]() { MarkStreamActive(conn_id, data_ctx_id); });
+            conn_ctx.dgram_tx_data->Emplace(object.ttl_ms,
+                                            object.priority,
+                                            0,
+                                            conn_id,
+                                            data_ctx_id,
+                                            object.priority,
+                                            StreamAction::kNoAction,
+                                            std::move(object.bytes),
+                                            tick_microseconds,
+                                            std::move(object.payload));
+            dgram_enqueued = true;
         }
     }
 
-    else { // datagram
-        ConnData cd{ conn_id,          data_ctx_id,
-                     priority,         StreamAction::kNoAction,
-                     std::move(bytes), tick_service_->Microseconds() };
-        conn_ctx_it->second.dgram_tx_data->Push(std::move(cd), ttl_ms, priority, 0);
+    // Activate once for the batch
+    if (stream_enqueued && !data_ctx.mark_stream_active) {
+        data_ctx.mark_stream_active = true;
 
-        if (!conn_ctx_it->second.mark_dgram_ready) {
-            conn_ctx_it->second.mark_dgram_ready = true;
+        shard.RunOnLoop([this, conn_id, data_ctx_id]() { MarkStreamActive(conn_id, data_ctx_id); });
+    }
 
-            picoquic_runner_queue_.Push([this, conn_id]() { MarkDgramReady(conn_id); });
-        }
+    if (dgram_enqueued && !conn_ctx.mark_dgram_ready) {
+        conn_ctx.mark_dgram_ready = true;
+
+        shard.RunOnLoop([this, conn_id]() { MarkDgramReady(conn_id); });
     }
+
     return TransportError::kNone;
 }
 
 std::shared_ptr<StreamRxContext>
 PicoQuicTransport::GetStreamRxContext(TransportConnId conn_id, uint64_t stream_id)
 {
-    std::lock_guard<std::mutex> _(state_mutex_);
+    const auto conn_table = GetShard(conn_id).conn_table.Read();
 
-    const auto conn_ctx_it = conn_context_.find(conn_id);
-    if (conn_ctx_it == conn_context_.end()) {
+    const auto conn_ctx_it = conn_table->find(conn_id);
+    if (conn_ctx_it == conn_table->end()) {
         throw TransportError::kInvalidConnContextId;
     }
 
-    const auto sbuf_it = conn_ctx_it->second.rx_stream_buffer.find(stream_id);
-    if (sbuf_it != conn_ctx_it->second.rx_stream_buffer.end()) {
+    auto& conn_ctx = *conn_ctx_it->second;
+    std::lock_guard<std::mutex> _(conn_ctx.mutex);
+
+    const auto sbuf_it = conn_ctx.rx_stream_buffer.find(stream_id);
+    if (sbuf_it != conn_ctx.rx_stream_buffer.end()) {
         return sbuf_it->second.rx_ctx;
     }
 
@@ -650,14 +756,15 @@ PicoQuicTransport::GetStreamRxContext(TransportConnId conn_id, uint64_t stream_i
 std::shared_ptr<const std::vector<uint8_t>>
 PicoQuicTransport::Dequeue(TransportConnId conn_id, [[maybe_unused]] std::optional<DataContextId> data_ctx_id)
 {
-    std::lock_guard<std::mutex> _(state_mutex_);
+    const auto conn_table = GetShard(conn_id).conn_table.Read();
 
-    const auto conn_ctx_it = conn_context_.find(conn_id);
-    if (conn_ctx_it == conn_context_.end()) {
+    const auto conn_ctx_it = conn_table->find(conn_id);
+    if (conn_ctx_it == conn_table->end()) {
         return {};
     }
 
-    auto data = conn_ctx_it->second.dgram_rx_data->Pop();
+    // Datagram receive queue is thread safe, no need to lock the connection
+    auto data = conn_ctx_it->second->dgram_rx_data->Pop();
     if (data.has_value()) {
         return *data;
     }
@@ -671,8 +778,6 @@ PicoQuicTransport::CreateDataContext(const TransportConnId conn_id,
                                      uint8_t priority,
                                      bool bidir)
 {
-    std::lock_guard<std::mutex> _(state_mutex_);
-
     if (priority > 127) {
         /*
          * Picoquic most significant bit of priority indicates to use round-robin. We don't want
@@ -681,37 +786,39 @@ PicoQuicTransport::CreateDataContext(const TransportConnId conn_id,
         throw std::runtime_error("Create stream priority cannot be greater than 127, range is 0 - 127");
     }
 
-    const auto conn_it = conn_context_.find(conn_id);
-    if (conn_it == conn_context_.end()) {
+    const auto conn_table = GetShard(conn_id).conn_table.Read();
+
+    const auto conn_it = conn_table->find(conn_id);
+    if (conn_it == conn_table->end()) {
         SPDLOG_LOGGER_ERROR(logger, "Invalid conn_id: {0}, cannot create data context", conn_id);
         return 0;
     }
 
-    const auto [data_ctx_it, is_new] =
-      conn_it->second.active_data_contexts.emplace(conn_it->second.next_data_ctx_id, DataContext{});
+    auto& conn_ctx = *conn_it->second;
+    std::lock_guard<std::mutex> _(conn_ctx.mutex);
+
+    const auto [data_ctx_it, is_new] = conn_ctx.active_data_contexts.emplace(conn_ctx.next_data_ctx_id);
 
     if (is_new) {
         // Init context
         data_ctx_it->second.conn_id = conn_id;
         data_ctx_it->second.is_bidir = bidir;
-        data_ctx_it->second.data_ctx_id = conn_it->second.next_data_ctx_id++; // Set and bump next data_ctx_id
+        data_ctx_it->second.data_ctx_id = conn_ctx.next_data_ctx_id++; // Set and bump next data_ctx_id
 
         data_ctx_it->second.priority = priority;
+        data_ctx_it->second.tx_quantum = tconfig_.tx_drr_quantum;
 
-        data_ctx_it->second.tx_data = std::make_unique<PriorityQueue<ConnData>>(tconfig_.time_queue_max_duration,
-                                                                                tconfig_.time_queue_bucket_interval,
-                                                                                tick_service_,
-                                                                                tconfig_.time_queue_init_queue_size);
+        data_ctx_it->second.tx_data = std::make_unique<PriorityQueue<ConnData>>(conn_ctx.tx_wheel);
 
         // Create stream
         if (use_reliable_transport) {
-            CreateStream(conn_it->second, &data_ctx_it->second);
+            CreateStream(conn_ctx, &data_ctx_it->second);
             SPDLOG_LOGGER_DEBUG(logger,
                                 "Created STREAM data context id: {} pri: {}",
                                 data_ctx_it->second.data_ctx_id,
                                 static_cast<int>(priority));
         } else {
-            picoquic_set_datagram_priority(conn_it->second.pq_cnx, priority);
+            picoquic_set_datagram_priority(conn_ctx.pq_cnx, priority);
             SPDLOG_LOGGER_DEBUG(logger,
                                 "Created DGRAM data context id: {} pri: {}",
                                 data_ctx_it->second.data_ctx_id,
@@ -725,45 +832,55 @@ PicoQuicTransport::CreateDataContext(const TransportConnId conn_id,
 void
 PicoQuicTransport::Close(const TransportConnId& conn_id, uint64_t app_reason_code)
 {
-    std::lock_guard<std::mutex> _(state_mutex_);
+    auto& shard = GetShard(conn_id);
 
-    const auto conn_it = conn_context_.find(conn_id);
+    {
+        const auto conn_table = shard.conn_table.Read();
+        const auto conn_it = conn_table->find(conn_id);
 
-    if (conn_it == conn_context_.end())
-        return;
+        if (conn_it == conn_table->end())
+            return;
+
+        auto& conn_ctx = *conn_it->second;
+        std::lock_guard<std::mutex> _(conn_ctx.mutex);
 
-    // Remove pointer references in picoquic for active streams
-    for (const auto& [stream_id, rx_buf] : conn_it->second.rx_stream_buffer) {
-        picoquic_mark_active_stream(conn_it->second.pq_cnx, stream_id, 0, NULL);
-        picoquic_unlink_app_stream_ctx(conn_it->second.pq_cnx, stream_id);
+        // Remove pointer references in picoquic for active streams
+        for (const auto& [stream_id, rx_buf] : conn_ctx.rx_stream_buffer) {
+            picoquic_mark_active_stream(conn_ctx.pq_cnx, stream_id, 0, NULL);
+            picoquic_unlink_app_stream_ctx(conn_ctx.pq_cnx, stream_id);
 
-        if (!rx_buf.closed) {
-            picoquic_reset_stream(conn_it->second.pq_cnx, stream_id, 0);
+            if (!rx_buf.closed) {
+                picoquic_reset_stream(conn_ctx.pq_cnx, stream_id, 0);
+            }
         }
-    }
 
-    // Only one datagram context is per connection, if it's deleted, then the connection is to be terminated
-    switch (app_reason_code) {
-        case 1: // idle timeout
-            OnConnectionStatus(conn_id, TransportStatus::kIdleTimeout);
-            break;
+        // Only one datagram context is per connection, if it's deleted, then the connection is to be terminated
+        switch (app_reason_code) {
+            case 1: // idle timeout
+                OnConnectionStatus(conn_id, TransportStatus::kIdleTimeout);
+                break;
 
-        case 100: // Client shutting down connection
-            OnConnectionStatus(conn_id, TransportStatus::kRemoteRequestClose);
-            break;
+            case 100: // Client shutting down connection
+                OnConnectionStatus(conn_id, TransportStatus::kRemoteRequestClose);
+                break;
 
-        default:
-            OnConnectionStatus(conn_id, TransportStatus::kDisconnected);
-            break;
-    }
+            default:
+                OnConnectionStatus(conn_id, TransportStatus::kDisconnected);
+                break;
+        }
 
-    if (not is_server_mode) {
-        SetStatus(TransportStatus::kShutdown);
+        if (not is_server_mode) {
+            SetStatus(TransportStatus::kShutdown);
+        }
+
+        picoquic_close(conn_ctx.pq_cnx, app_reason_code);
     }
 
-    picoquic_close(conn_it->second.pq_cnx, app_reason_code);
+    // Context is freed by the shard packet loop once no reader can be using it
+    shard.conn_table.Update([conn_id](ConnectionTable& table) { table.erase(conn_id); });
 
-    conn_context_.erase(conn_it);
+    // Send the close without waiting for the next timer
+    shard.wakeup.Signal();
 }
 
 void
@@ -774,18 +891,110 @@ PicoQuicTransport::SetRemoteDataCtxId([[maybe_unused]] const TransportConnId con
     return;
 }
 
+void
+PicoQuicTransport::SetDataCtxTxBudget(const TransportConnId conn_id,
+                                      DataContextId data_ctx_id,
+                                      uint64_t max_bytes,
+                                      uint32_t max_objects)
+{
+    SPDLOG_LOGGER_DEBUG(logger,
+                        "Set data context TX budget to {0} bytes {1} objects conn_id: {2} data_ctx_id: {3}",
+                        max_bytes,
+                        max_objects,
+                        conn_id,
+                        data_ctx_id);
+
+    // Budget is read by the picoquic thread without the lock, so only it updates the budget
+    GetShard(conn_id).RunOnLoop([this, conn_id, data_ctx_id, max_bytes, max_objects]() {
+        const auto conn_ctx = GetConnContext(conn_id);
+        if (conn_ctx == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> _(conn_ctx->mutex);
+
+        const auto data_ctx_it = conn_ctx->active_data_contexts.find(data_ctx_id);
+        if (data_ctx_it == conn_ctx->active_data_contexts.end())
+            return;
+
+        auto& data_ctx = data_ctx_it->second;
+        data_ctx.tx_max_bytes = max_bytes;
+        data_ctx.tx_max_objects = max_objects;
+
+        // A larger budget can end backpressure without the queue draining
+        CheckTxDrained(data_ctx);
+    });
+}
+
+void
+PicoQuicTransport::SetDataCtxQuantum(const TransportConnId conn_id, DataContextId data_ctx_id, uint32_t quantum)
+{
+    SPDLOG_LOGGER_DEBUG(
+      logger, "Set data context quantum to {0} conn_id: {1} data_ctx_id: {2}", quantum, conn_id, data_ctx_id);
+
+    // Round robin state is only updated by the picoquic thread
+    GetShard(conn_id).RunOnLoop([this, conn_id, data_ctx_id, quantum]() {
+        const auto conn_ctx = GetConnContext(conn_id);
+        if (conn_ctx == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> _(conn_ctx->mutex);
+
+        const auto data_ctx_it = conn_ctx->active_data_contexts.find(data_ctx_id);
+        if (data_ctx_it == conn_ctx->active_data_contexts.end())
+            return;
+
+        data_ctx_it->second.tx_quantum = quantum;
+    });
+}
+
+void
+PicoQuicTransport::SetDataCtxRateLimit(const TransportConnId conn_id,
+                                       DataContextId data_ctx_id,
+                                       uint64_t rate_bps,
+                                       uint32_t burst_bytes)
+{
+    if (rate_bps != 0) {
+        burst_bytes = DataContext::TxBurstBytes(rate_bps, burst_bytes);
+    }
+
+    SPDLOG_LOGGER_DEBUG(logger,
+                        "Set data context rate limit to {0} bps burst {1} bytes conn_id: {2} data_ctx_id: {3}",
+                        rate_bps,
+                        burst_bytes,
+                        conn_id,
+                        data_ctx_id);
+
+    // Tokens are only updated by the picoquic thread
+    GetShard(conn_id).RunOnLoop([this, conn_id, data_ctx_id, rate_bps, burst_bytes]() {
+        const auto conn_ctx = GetConnContext(conn_id);
+        if (conn_ctx == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> _(conn_ctx->mutex);
+
+        const auto data_ctx_it = conn_ctx->active_data_contexts.find(data_ctx_id);
+        if (data_ctx_it == conn_ctx->active_data_contexts.end())
+            return;
+
+        data_ctx_it->second.SetTxRateLimit(rate_bps, burst_bytes, tick_service_->Microseconds());
+    });
+}
+
 void
 PicoQuicTransport::SetDataCtxPriority(const TransportConnId conn_id, DataContextId data_ctx_id, uint8_t priority)
 {
-    std::lock_guard<std::mutex> _(state_mutex_);
+    const auto conn_table = GetShard(conn_id).conn_table.Read();
 
-    const auto conn_it = conn_context_.find(conn_id);
+    const auto conn_it = conn_table->find(conn_id);
 
-    if (conn_it == conn_context_.end())
+    if (conn_it == conn_table->end())
         return;
 
-    const auto data_ctx_it = conn_it->second.active_data_contexts.find(data_ctx_id);
-    if (data_ctx_it == conn_it->second.active_data_contexts.end())
+    auto& conn_ctx = *conn_it->second;
+    std::lock_guard<std::mutex> _(conn_ctx.mutex);
+
+    const auto data_ctx_it = conn_ctx.active_data_contexts.find(data_ctx_id);
+    if (data_ctx_it == conn_ctx.active_data_contexts.end())
         return;
 
     SPDLOG_LOGGER_DEBUG(logger,
@@ -800,15 +1009,19 @@ PicoQuicTransport::SetDataCtxPriority(const TransportConnId conn_id, DataContext
 void
 PicoQuicTransport::SetStreamIdDataCtxId(const TransportConnId conn_id, DataContextId data_ctx_id, uint64_t stream_id)
 {
-    std::lock_guard<std::mutex> _(state_mutex_);
+    auto& shard = GetShard(conn_id);
+    const auto conn_table = shard.conn_table.Read();
 
-    const auto conn_it = conn_context_.find(conn_id);
+    const auto conn_it = conn_table->find(conn_id);
 
-    if (conn_it == conn_context_.end())
+    if (conn_it == conn_table->end())
         return;
 
-    const auto data_ctx_it = conn_it->second.active_data_contexts.find(data_ctx_id);
-    if (data_ctx_it == conn_it->second.active_data_contexts.end())
+    auto& conn_ctx = *conn_it->second;
+    std::lock_guard<std::mutex> _(conn_ctx.mutex);
+
+    const auto data_ctx_it = conn_ctx.active_data_contexts.find(data_ctx_id);
+    if (data_ctx_it == conn_ctx.active_data_contexts.end())
         return;
 
     SPDLOG_LOGGER_DEBUG(logger,
@@ -819,9 +1032,16 @@ PicoQuicTransport::SetStreamIdDataCtxId(const TransportConnId conn_id, DataConte
 
     data_ctx_it->second.current_stream_id = stream_id;
 
-    picoquic_runner_queue_.Push([=]() {
-        if (conn_it->second.pq_cnx != nullptr)
-            picoquic_set_app_stream_ctx(conn_it->second.pq_cnx, stream_id, &data_ctx_it->second);
+    shard.RunOnLoop([this, conn_id, data_ctx_id, stream_id]() {
+        const auto conn_ctx = GetConnContext(conn_id);
+        if (conn_ctx == nullptr || conn_ctx->pq_cnx == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> _(conn_ctx->mutex);
+
+        const auto data_ctx_it = conn_ctx->active_data_contexts.find(data_ctx_id);
+        if (data_ctx_it != conn_ctx->active_data_contexts.end())
+            picoquic_set_app_stream_ctx(conn_ctx->pq_cnx, stream_id, &data_ctx_it->second);
     });
 }
 
@@ -833,26 +1053,67 @@ PicoQuicTransport::SetStreamIdDataCtxId(const TransportConnId conn_id, DataConte
 PicoQuicTransport::ConnectionContext*
 PicoQuicTransport::GetConnContext(const TransportConnId& conn_id)
 {
+    const auto conn_table = GetShard(conn_id).conn_table.Read();
+
     // Locate the specified transport connection context
-    auto it = conn_context_.find(conn_id);
+    auto it = conn_table->find(conn_id);
 
     // If not found, return empty context
-    if (it == conn_context_.end())
+    if (it == conn_table->end())
         return nullptr;
 
-    return &it->second;
+    return it->second.get();
+}
+
+PicoQuicTransport::Shard&
+PicoQuicTransport::GetShard(const TransportConnId conn_id)
+{
+    return *shards_[(conn_id >> kConnIdShardShift) % shards_.size()];
+}
+
+TransportConnId
+PicoQuicTransport::MakeConnId(Shard& shard, picoquic_cnx_t* pq_cnx)
+{
+    auto [conn_id_it, is_new] = shard.conn_ids.try_emplace(pq_cnx, 0);
+    if (is_new) {
+        conn_id_it->second = (static_cast<TransportConnId>(shard.index) << kConnIdShardShift) | ++shard.last_conn_seq;
+    }
+
+    return conn_id_it->second;
+}
+
+PicoQuicTransport::NotifyWorker&
+PicoQuicTransport::GetNotifyWorker(const TransportConnId conn_id)
+{
+    // Mix the bits so that the shard index and sequence both spread connections across workers
+    const uint64_t hash = (conn_id ^ (conn_id >> 33)) * 0xff51afd7ed558ccdULL;
+    return *notify_workers_[(hash >> 32) % notify_workers_.size()];
 }
 
 PicoQuicTransport::ConnectionContext&
-PicoQuicTransport::CreateConnContext(picoquic_cnx_t* pq_cnx)
+PicoQuicTransport::CreateConnContext(Shard& shard, picoquic_cnx_t* pq_cnx)
 {
+    const auto conn_id = MakeConnId(shard, pq_cnx);
 
-    auto [conn_it, is_new] = conn_context_.emplace(reinterpret_cast<TransportConnId>(pq_cnx), pq_cnx);
+    std::shared_ptr<ConnectionContext> conn_ctx_ptr;
+    {
+        const auto conn_table = shard.conn_table.Read();
+        if (const auto conn_it = conn_table->find(conn_id); conn_it != conn_table->end()) {
+            conn_ctx_ptr = conn_it->second;
+        }
+    }
+
+    const bool is_new = conn_ctx_ptr == nullptr;
+    if (is_new) {
+        conn_ctx_ptr = std::make_shared<ConnectionContext>(pq_cnx);
+    }
 
     sockaddr* addr;
 
-    auto& conn_ctx = conn_it->second;
-    conn_ctx.conn_id = reinterpret_cast<TransportConnId>(pq_cnx);
+    auto& conn_ctx = *conn_ctx_ptr;
+    std::lock_guard<std::mutex> _(conn_ctx.mutex);
+
+    conn_ctx.conn_id = conn_id;
     conn_ctx.pq_cnx = pq_cnx;
 
     picoquic_get_peer_addr(pq_cnx, &addr);
@@ -883,10 +1144,13 @@ PicoQuicTransport::CreateConnContext(picoquic_cnx_t* pq_cnx)
         SPDLOG_LOGGER_INFO(logger, "Created new connection context for conn_id: {0}", conn_ctx.conn_id);
 
         conn_ctx.dgram_rx_data->SetLimit(tconfig_.time_queue_rx_size);
-        conn_ctx.dgram_tx_data = std::make_shared<PriorityQueue<ConnData>>(tconfig_.time_queue_max_duration,
-                                                                           tconfig_.time_queue_bucket_interval,
-                                                                           tick_service_,
-                                                                           tconfig_.time_queue_init_queue_size);
+        conn_ctx.tx_wheel = std::make_shared<TimingWheel<ConnData>>(tconfig_.time_queue_max_duration,
+                                                                    tconfig_.time_queue_bucket_interval,
+                                                                    tick_service_,
+                                                                    tconfig_.time_queue_init_queue_size);
+        conn_ctx.dgram_tx_data = std::make_shared<PriorityQueue<ConnData>>(conn_ctx.tx_wheel);
+
+        shard.conn_table.Update([&](ConnectionTable& table) { table.emplace(conn_id, conn_ctx_ptr); });
     }
 
     return conn_ctx;
@@ -942,33 +1206,32 @@ PicoQuicTransport::SetStatus(TransportStatus status)
 PicoQuicTransport::DataContext*
 PicoQuicTransport::CreateDataContextBiDirRecv(TransportConnId conn_id, uint64_t stream_id)
 {
-    std::lock_guard<std::mutex> _(state_mutex_);
+    const auto conn_table = GetShard(conn_id).conn_table.Read();
 
-    const auto conn_it = conn_context_.find(conn_id);
-    if (conn_it == conn_context_.end()) {
+    const auto conn_it = conn_table->find(conn_id);
+    if (conn_it == conn_table->end()) {
         SPDLOG_LOGGER_ERROR(logger, "Invalid conn_id: {0}, cannot create data context", conn_id);
         return nullptr;
     }
 
-    const auto [data_ctx_it, is_new] =
-      conn_it->second.active_data_contexts.emplace(conn_it->second.next_data_ctx_id, DataContext{});
+    auto& conn_ctx = *conn_it->second;
+    std::lock_guard<std::mutex> _(conn_ctx.mutex);
+
+    const auto [data_ctx_it, is_new] = conn_ctx.active_data_contexts.emplace(conn_ctx.next_data_ctx_id);
 
     if (is_new) {
         // Init context
         data_ctx_it->second.conn_id = conn_id;
         data_ctx_it->second.is_bidir = true;
-        data_ctx_it->second.data_ctx_id = conn_it->second.next_data_ctx_id++; // Set and bump next data_ctx_id
+        data_ctx_it->second.data_ctx_id = conn_ctx.next_data_ctx_id++; // Set and bump next data_ctx_id
 
         data_ctx_it->second.priority = 10; // TODO: Need to get priority from remote
 
-        data_ctx_it->second.tx_data = std::make_unique<PriorityQueue<ConnData>>(tconfig_.time_queue_max_duration,
-                                                                                tconfig_.time_queue_bucket_interval,
-                                                                                tick_service_,
-                                                                                tconfig_.time_queue_init_queue_size);
+        data_ctx_it->second.tx_data = std::make_unique<PriorityQueue<ConnData>>(conn_ctx.tx_wheel);
 
         data_ctx_it->second.current_stream_id = stream_id;
 
-        cbNotifyQueue_.Push([=, data_ctx_id = data_ctx_it->second.data_ctx_id, this]() {
+        GetNotifyWorker(conn_id).queue.PushOrOverflow([=, data_ctx_id = data_ctx_it->second.data_ctx_id, this]() {
             delegate_.OnNewDataContext(conn_id, data_ctx_id);
         });
 
@@ -985,36 +1248,43 @@ PicoQuicTransport::CreateDataContextBiDirRecv(TransportConnId conn_id, uint64_t
 }
 
 void
-PicoQuicTransport::PqRunner()
+PicoQuicTransport::PqRunner(Shard& shard)
 {
-
-    if (picoquic_runner_queue_.Empty()) {
-        return;
-    }
-
-    // note: check before running move of optional, which is more CPU taxing when empty
-    while (auto cb = picoquic_runner_queue_.Pop()) {
-        (*cb)();
+    // A task that throws is removed from the queue, continue with the rest
+    while (true) {
+        try {
+            shard.runner_queue.RunAll();
+            return;
+        } catch (const std::exception& e) {
+            SPDLOG_LOGGER_ERROR(logger, "picoquic shard {0} runner task failed: {1}", shard.index, e.what());
+        } catch (...) {
+            SPDLOG_LOGGER_ERROR(logger, "picoquic shard {0} runner task failed", shard.index);
+        }
     }
 }
 
 void
 PicoQuicTransport::DeleteDataContextInternal(TransportConnId conn_id, DataContextId data_ctx_id)
 {
-    const auto conn_it = conn_context_.find(conn_id);
+    const auto conn_table = GetShard(conn_id).conn_table.Read();
+
+    const auto conn_it = conn_table->find(conn_id);
 
-    if (conn_it == conn_context_.end())
+    if (conn_it == conn_table->end())
         return;
 
+    auto& conn_ctx = *conn_it->second;
+    std::lock_guard<std::mutex> _(conn_ctx.mutex);
+
     SPDLOG_LOGGER_INFO(logger, "Delete data context {0} in conn_id: {1}", data_ctx_id, conn_id);
 
-    const auto data_ctx_it = conn_it->second.active_data_contexts.find(data_ctx_id);
-    if (data_ctx_it == conn_it->second.active_data_contexts.end())
+    const auto data_ctx_it = conn_ctx.active_data_contexts.find(data_ctx_id);
+    if (data_ctx_it == conn_ctx.active_data_contexts.end())
         return;
 
-    CloseStream(conn_it->second, &data_ctx_it->second, false);
+    CloseStream(conn_ctx, &data_ctx_it->second, false);
 
-    conn_it->second.active_data_contexts.erase(data_ctx_it);
+    conn_ctx.active_data_contexts.erase(data_ctx_it);
 }
 
 void
@@ -1028,7 +1298,7 @@ PicoQuicTransport::DeleteDataContext(const TransportConnId& conn_id, DataContext
      * Race conditions exist with picoquic thread callbacks that will cause a problem if the context (pointer context)
      *    is deleted outside of the picoquic thread. Below schedules the delete to be done within the picoquic thread.
      */
-    picoquic_runner_queue_.Push([this, conn_id, data_ctx_id]() { DeleteDataContextInternal(conn_id, data_ctx_id); });
+    GetShard(conn_id).RunOnLoop([this, conn_id, data_ctx_id]() { DeleteDataContextInternal(conn_id, data_ctx_id); });
 }
 
 void
@@ -1038,53 +1308,72 @@ PicoQuicTransport::SendNextDatagram(ConnectionContext* conn_ctx, uint8_t* bytes_
         return;
     }
 
-    TimeQueueElement<ConnData> out_data;
-    conn_ctx->dgram_tx_data->Front(out_data);
-    if (out_data.has_value) {
-        const auto data_ctx_it = conn_ctx->active_data_contexts.find(out_data.value.data_ctx_id);
-        if (data_ctx_it == conn_ctx->active_data_contexts.end()) {
+    // Datagram is read in place and popped once it is copied to the packet
+    uint32_t expired_count = 0;
+    const auto* out_data = conn_ctx->dgram_tx_data->PeekRef(expired_count);
+    if (out_data != nullptr) {
+        // Data contexts are created by other threads, they are only deleted by the loop thread
+        DataContext* data_ctx = nullptr;
+        {
+            std::lock_guard<std::mutex> _(conn_ctx->mutex);
+            const auto data_ctx_it = conn_ctx->active_data_contexts.find(out_data->data_ctx_id);
+            if (data_ctx_it != conn_ctx->active_data_contexts.end()) {
+                data_ctx = &data_ctx_it->second;
+            }
+        }
+
+        if (data_ctx == nullptr) {
             SPDLOG_LOGGER_DEBUG(logger,
                                 "send_next_dgram has no data context conn_id: {0} data len: {1} dropping",
                                 conn_ctx->conn_id,
-                                out_data.value.data->size());
+                                out_data->Size());
             conn_ctx->metrics.tx_dgram_drops++;
             return;
         }
 
-        CheckCallbackDelta(&data_ctx_it->second);
+        CheckCallbackDelta(data_ctx);
+
+        const auto dgram_size = out_data->Size();
 
-        if (out_data.value.data->size() == 0) {
+        if (dgram_size == 0) {
             SPDLOG_LOGGER_ERROR(logger,
                                 "conn_id: {0} data_ctx_id: {1} priority: {2} has ZERO data size",
-                                data_ctx_it->second.conn_id,
-                                data_ctx_it->second.data_ctx_id,
-                                static_cast<int>(data_ctx_it->second.priority));
-            data_ctx_it->second.tx_data->Pop();
+                                data_ctx->conn_id,
+                                data_ctx->data_ctx_id,
+                                static_cast<int>(data_ctx->priority));
+            data_ctx->tx_data->Pop();
             return;
         }
 
-        data_ctx_it->second.metrics.tx_queue_expired += out_data.expired_count;
+        data_ctx->metrics.tx_queue_expired += expired_count;
 
-        if (out_data.value.data->size() <= max_len) {
-            conn_ctx->dgram_tx_data->Pop();
-
-            data_ctx_it->second.metrics.tx_object_duration_us.AddValue(tick_service_->Microseconds() -
-                                                                       out_data.value.tick_microseconds);
-            data_ctx_it->second.metrics.tx_dgrams_bytes += out_data.value.data->size();
-            data_ctx_it->second.metrics.tx_dgrams++;
+        if (dgram_size <= max_len) {
+            data_ctx->metrics.tx_object_duration_us.AddValue(tick_service_->Microseconds() -
+                                                             out_data->tick_microseconds);
+            data_ctx->metrics.tx_dgrams_bytes += dgram_size;
+            data_ctx->metrics.tx_dgrams++;
 
             uint8_t* buf = nullptr;
 
-            buf = picoquic_provide_datagram_buffer_ex(
-              bytes_ctx,
-              out_data.value.data->size(),
-              conn_ctx->dgram_tx_data->Empty() ? picoquic_datagram_not_active : picoquic_datagram_active_any_path);
+            buf = picoquic_provide_datagram_buffer_ex(bytes_ctx,
+                                                      dgram_size,
+                                                      conn_ctx->dgram_tx_data->Size() == 1
+                                                        ? picoquic_datagram_not_active
+                                                        : picoquic_datagram_active_any_path);
 
             if (buf != nullptr) {
-                std::memcpy(buf, out_data.value.data->data(), out_data.value.data->size());
+                // Gather the data and payload
+                const auto& data = *out_data->data;
+                std::memcpy(buf, data.data(), data.size());
+
+                if (out_data->payload) {
+                    std::memcpy(buf + data.size(), out_data->payload->data(), out_data->payload->size());
+                }
             }
+
+            conn_ctx->dgram_tx_data->Pop();
         } else {
-            picoquic_runner_queue_.Push([this, conn_id = conn_ctx->conn_id]() { MarkDgramReady(conn_id); });
+            GetShard(conn_ctx->conn_id).RunOnLoop([this, conn_id = conn_ctx->conn_id]() { MarkDgramReady(conn_id); });
 
             /* TODO(tievens): picoquic_prepare_stream_and_datagrams() appears to ignore the
              *     below unless data was sent/provided
@@ -1120,8 +1409,8 @@ PicoQuicTransport::StreamActionCheck(DataContext* data_ctx, StreamAction stream_
         case StreamAction::kReplaceStreamUseReset: {
             data_ctx->uses_reset_wait = false;
 
-            std::lock_guard<std::mutex> _(state_mutex_);
             const auto conn_ctx = GetConnContext(data_ctx->conn_id);
+            std::lock_guard<std::mutex> _(conn_ctx->mutex);
 
             /*
             // Keep stream in discard mode if still congested
@@ -1165,9 +1454,9 @@ PicoQuicTransport::StreamActionCheck(DataContext* data_ctx, StreamAction stream_
                                data_ctx->conn_id,
                                *data_ctx->current_stream_id);
 
-            std::lock_guard<std::mutex> _(state_mutex_);
-
             const auto conn_ctx = GetConnContext(data_ctx->conn_id);
+            std::lock_guard<std::mutex> _(conn_ctx->mutex);
+
             CloseStream(*conn_ctx, data_ctx, false);
             CreateStream(*conn_ctx, data_ctx);
 
@@ -1200,21 +1489,31 @@ PicoQuicTransport::SendStreamBytes(DataContext* data_ctx, uint8_t* bytes_ctx, si
 
     if (data_ctx != nullptr && data_ctx->tx_reset_wait_discard) { // Drop TX objects till next reset/new stream
         data_ctx->tx_data->PopFront(obj);
+        CheckTxDrained(*data_ctx);
         if (obj.has_value) {
             data_ctx->metrics.tx_queue_discards++;
 
-            picoquic_runner_queue_.Push([this, conn_id = data_ctx->conn_id, data_ctx_id = data_ctx->data_ctx_id]() {
-                MarkStreamActive(conn_id, data_ctx_id);
-            });
+            GetShard(data_ctx->conn_id)
+              .RunOnLoop([this, conn_id = data_ctx->conn_id, data_ctx_id = data_ctx->data_ctx_id]() {
+                  MarkStreamActive(conn_id, data_ctx_id);
+              });
         }
 
         data_ctx->mark_stream_active = false;
         return;
     }
 
+    if (data_ctx->tx_rate_bps != 0 && WaitForTxTokens(*data_ctx)) {
+        picoquic_provide_stream_data_buffer(bytes_ctx, 0, 0, 0);
+        return;
+    }
+
+    data_ctx->TakeTxUnsent();
+
     if (data_ctx->stream_tx_object == nullptr) {
         data_ctx->tx_data->PopFront(obj);
         data_ctx->metrics.tx_queue_expired += obj.expired_count;
+        CheckTxDrained(*data_ctx);
 
         if (obj.expired_count != 0) {
             SPDLOG_LOGGER_DEBUG(logger,
@@ -1226,7 +1525,7 @@ PicoQuicTransport::SendStreamBytes(DataContext* data_ctx, uint8_t* bytes_ctx, si
         }
 
         if (obj.has_value) {
-            if (obj.value.data->size() == 0) {
+            if (obj.value.Size() == 0) {
                 SPDLOG_LOGGER_ERROR(logger,
                                     "conn_id: {0} data_ctx_id: {1} priority: {2} stream has ZERO data size",
                                     data_ctx->conn_id,
@@ -1242,12 +1541,13 @@ PicoQuicTransport::SendStreamBytes(DataContext* data_ctx, uint8_t* bytes_ctx, si
 
             if (StreamActionCheck(data_ctx, obj.value.stream_action)) {
                 data_ctx->stream_tx_object = std::move(obj.value.data);
+                data_ctx->stream_tx_payload = std::move(obj.value.payload);
                 SPDLOG_LOGGER_TRACE(logger,
                                     "New Stream conn_id: {} data_ctx_id: {} stream_id: {}, object size: {}",
                                     data_ctx->conn_id,
                                     data_ctx->data_ctx_id,
                                     *data_ctx->current_stream_id,
-                                    data_ctx->stream_tx_object->size());
+                                    data_ctx->TxObjectSize());
                 return;
             } else if (obj.value.stream_action != StreamAction::kNoAction) {
                 SPDLOG_LOGGER_TRACE(
@@ -1256,15 +1556,17 @@ PicoQuicTransport::SendStreamBytes(DataContext* data_ctx, uint8_t* bytes_ctx, si
                   data_ctx->conn_id,
                   data_ctx->data_ctx_id,
                   *data_ctx->current_stream_id,
-                  obj.value.data->size(),
+                  obj.value.Size(),
                   data_ctx->tx_data->Size());
             }
 
             data_ctx->stream_tx_object = std::move(obj.value.data);
+            data_ctx->stream_tx_payload = std::move(obj.value.payload);
             data_ctx->tx_start_stream = false;
 
         } else {
             // Queue is empty
+            data_ctx->tx_deficit = 0;
             picoquic_provide_stream_data_buffer(
               bytes_ctx, 0, 0, data_ctx->mark_stream_active || not data_ctx->tx_data->Empty());
 
@@ -1272,26 +1574,86 @@ PicoQuicTransport::SendStreamBytes(DataContext* data_ctx, uint8_t* bytes_ctx, si
         }
     }
 
-    data_len = data_ctx->stream_tx_object->size() - data_ctx->stream_tx_object_offset;
+    // Bytes left in the round robin turn and rate limit of this stream, all of max_len if both are disabled
+    const size_t allowance = data_ctx->TxAllowance(max_len);
+
+    data_len = data_ctx->TxObjectSize() - data_ctx->stream_tx_object_offset;
     offset = data_ctx->stream_tx_object_offset;
 
-    if (data_len > max_len) {
-        data_ctx->stream_tx_object_offset += max_len;
-        data_len = max_len;
+    if (data_len > allowance) {
+        data_ctx->stream_tx_object_offset += allowance;
+        data_len = allowance;
         is_still_active = 1;
 
     } else {
         data_ctx->stream_tx_object_offset = 0;
     }
 
-    data_ctx->metrics.tx_stream_bytes += data_len;
+    // Coalesce following objects on the same stream into this write, stopping at a stream action
+    auto& coalesce = GetShard(data_ctx->conn_id).tx_coalesce;
+    size_t coalesce_len = 0;
+    size_t last_object_len = 0; /// Bytes of the last coalesced object that fit, the rest is sent next callback
+    size_t unsent_taken = 0;    /// Objects taken from tx_unsent, which are already counted in the metrics
+
+    while (!is_still_active && data_len + coalesce_len < allowance) {
+        auto& next = coalesce.emplace_back();
+
+        if (unsent_taken < data_ctx->tx_unsent.size()) {
+            next = std::move(data_ctx->tx_unsent[unsent_taken++]);
+        } else {
+            uint32_t expired_count = 0;
+            const bool popped = data_ctx->tx_data->TryPopInto(next, expired_count, [](const ConnData& object) {
+                return object.stream_action == StreamAction::kNoAction && object.Size() != 0;
+            });
+            data_ctx->metrics.tx_queue_expired += expired_count;
+
+            if (!popped) {
+                coalesce.pop_back();
+                break;
+            }
+
+            data_ctx->metrics.tx_stream_objects++;
+            data_ctx->metrics.tx_object_duration_us.AddValue(tick_service_->Microseconds() -
+                                                             next.tick_microseconds);
+        }
+
+        last_object_len = std::min(next.Size(), allowance - data_len - coalesce_len);
+        coalesce_len += last_object_len;
+        is_still_active = last_object_len < next.Size();
+    }
+
+    data_ctx->tx_unsent.erase(data_ctx->tx_unsent.begin(), data_ctx->tx_unsent.begin() + unsent_taken);
+
+    if (!coalesce.empty()) {
+        CheckTxDrained(*data_ctx);
+    }
 
-    if (!is_still_active && !data_ctx->tx_data->Empty())
+    data_ctx->metrics.tx_stream_bytes += data_len + coalesce_len;
+    data_ctx->metrics.tx_objects_per_callback.AddValue(1 + coalesce.size());
+
+    if (!is_still_active && (!data_ctx->tx_data->Empty() || !data_ctx->tx_unsent.empty()))
         is_still_active = 1;
 
+    if (data_ctx->TxConsume(data_len + coalesce_len) && is_still_active) {
+        // Turn is used up, the stream goes behind the others of the same priority until marked active again
+        is_still_active = 0;
+        data_ctx->metrics.tx_drr_yields++;
+
+        if (!data_ctx->mark_stream_active) {
+            data_ctx->mark_stream_active = true;
+
+            GetShard(data_ctx->conn_id)
+              .RunOnLoop([this, conn_id = data_ctx->conn_id, data_ctx_id = data_ctx->data_ctx_id]() {
+                  MarkStreamActive(conn_id, data_ctx_id);
+              });
+        }
+    } else if (!is_still_active) {
+        data_ctx->tx_deficit = 0; // Nothing left to send, the next turn starts with a full quantum
+    }
+
     uint8_t* buf = nullptr;
 
-    buf = picoquic_provide_stream_data_buffer(bytes_ctx, data_len, 0, is_still_active);
+    buf = picoquic_provide_stream_data_buffer(bytes_ctx, data_len + coalesce_len, 0, is_still_active);
 
     if (buf == NULL) {
         // Error allocating memory to write
@@ -1300,17 +1662,40 @@ PicoQuicTransport::SendStreamBytes(DataContext* data_ctx, uint8_t* bytes_ctx, si
                             data_ctx->conn_id,
                             data_ctx->data_ctx_id,
                             static_cast<int>(data_ctx->priority),
-                            data_len);
+                            data_len + coalesce_len);
+
+        // Nothing was written, send the same bytes and coalesced objects in the next callback
+        data_ctx->RestoreTxUnsent(offset, coalesce);
         return;
     }
 
-    // Write data
-    std::memcpy(buf, data_ctx->stream_tx_object->data() + offset, data_len);
+    // Write data, gathering the object and payload
+    data_ctx->CopyTxObject(buf, offset, data_len);
 
     if (data_ctx->stream_tx_object_offset == 0 && data_ctx->stream_tx_object != nullptr) {
         // Zero offset at this point means the object was fully sent
         data_ctx->ResetTxObject();
     }
+
+    // Coalesced objects are written through the TX object, the last one is kept if it did not fit
+    buf += data_len;
+    for (size_t i = 0; i < coalesce.size(); ++i) {
+        auto& object = coalesce[i];
+        const auto len = i + 1 < coalesce.size() ? object.Size() : last_object_len;
+
+        data_ctx->stream_tx_object = std::move(object.data);
+        data_ctx->stream_tx_payload = std::move(object.payload);
+        data_ctx->CopyTxObject(buf, 0, len);
+        buf += len;
+
+        if (len < data_ctx->TxObjectSize()) {
+            data_ctx->stream_tx_object_offset = len;
+        } else {
+            data_ctx->ResetTxObject();
+        }
+    }
+
+    coalesce.clear();
 }
 
 void
@@ -1321,7 +1706,7 @@ PicoQuicTransport::OnConnectionStatus(const TransportConnId conn_id, const Trans
         SPDLOG_LOGGER_INFO(logger, "Connection established to server {0}", conn_ctx->peer_addr_text);
     }
 
-    cbNotifyQueue_.Push([=, this]() { delegate_.OnConnectionStatus(conn_id, status); });
+    GetNotifyWorker(conn_id).queue.PushOrOverflow([=, this]() { delegate_.OnConnectionStatus(conn_id, status); });
 }
 
 void
@@ -1350,7 +1735,7 @@ PicoQuicTransport::OnNewConnection(const TransportConnId conn_id)
         picoquic_set_priority_limit_for_bypass(conn_ctx->pq_cnx, tconfig_.quic_priority_limit);
     }
 
-    cbNotifyQueue_.Push([=, this]() { delegate_.OnNewConnection(conn_id, remote); });
+    GetNotifyWorker(conn_id).queue.PushOrOverflow([=, this]() { delegate_.OnNewConnection(conn_id, remote); });
 }
 
 void
@@ -1365,16 +1750,28 @@ PicoQuicTransport::OnRecvDatagram(ConnectionContext* conn_ctx, uint8_t* bytes, s
         return;
     }
 
-    conn_ctx->dgram_rx_data->Push(std::make_shared<const std::vector<uint8_t>>(bytes, bytes + length));
+    auto [data, pooled] = GetShard(conn_ctx->conn_id).rx_buffer_pool.Acquire({ bytes, length });
+    if (pooled) {
+        conn_ctx->metrics.rx_buffer_pool_hits++;
+    } else {
+        conn_ctx->metrics.rx_buffer_pool_misses++;
+    }
+
+    conn_ctx->dgram_rx_data->Push(std::move(data));
     conn_ctx->metrics.rx_dgrams++;
     conn_ctx->metrics.rx_dgrams_bytes += length;
 
-    if (cbNotifyQueue_.Size() > 100) {
-        SPDLOG_LOGGER_INFO(logger, "on_recv_datagram cbNotifyQueue size {0}", cbNotifyQueue_.Size());
+    auto& notify_worker = GetNotifyWorker(conn_ctx->conn_id);
+
+    if (notify_worker.queue.Size() > 100) {
+        SPDLOG_LOGGER_INFO(logger,
+                           "on_recv_datagram notify worker {0} queue size {1}",
+                           notify_worker.index,
+                           notify_worker.queue.Size());
     }
 
     if (conn_ctx->dgram_rx_data->Size() < 10 &&
-        !cbNotifyQueue_.Push([=, this]() { delegate_.OnRecvDgram(conn_ctx->conn_id, std::nullopt); })) {
+        !notify_worker.queue.Push([=, this]() { delegate_.OnRecvDgram(conn_ctx->conn_id, std::nullopt); })) {
         SPDLOG_LOGGER_ERROR(logger, "conn_id: {0} DGRAM notify queue is full", conn_ctx->conn_id);
     }
 }
@@ -1390,29 +1787,35 @@ PicoQuicTransport::OnRecvStreamBytes(ConnectionContext* conn_ctx,
         return;
     }
 
-    std::lock_guard<std::mutex> l(state_mutex_);
+    std::lock_guard<std::mutex> l(conn_ctx->mutex);
 
-    auto rx_buf_it = conn_ctx->rx_stream_buffer.find(stream_id);
-    if (rx_buf_it == conn_ctx->rx_stream_buffer.end()) {
+    auto [rx_buf_it, is_new] = conn_ctx->rx_stream_buffer.try_emplace(stream_id);
+    if (is_new) {
         if (bytes.size() < kMinStreamBytesForSend) {
             SPDLOG_LOGGER_DEBUG(logger,
                                 "bytes received from picoquic stream {} len: {} is too small to process stream header",
                                 stream_id,
                                 bytes.size());
         }
-        conn_ctx->rx_stream_buffer.try_emplace(stream_id);
-        conn_ctx->rx_stream_buffer[stream_id].rx_ctx->data_queue.SetLimit(tconfig_.time_queue_rx_size);
+        rx_buf_it->second.rx_ctx->data_queue.SetLimit(tconfig_.time_queue_rx_size);
     }
 
-    auto& rx_buf = conn_ctx->rx_stream_buffer[stream_id];
+    auto& rx_buf = rx_buf_it->second;
 
-    rx_buf.rx_ctx->data_queue.Push(std::make_shared<const std::vector<uint8_t>>(bytes.begin(), bytes.end()));
+    auto [data, pooled] = GetShard(conn_ctx->conn_id).rx_buffer_pool.Acquire(bytes);
+    if (pooled) {
+        conn_ctx->metrics.rx_buffer_pool_hits++;
+    } else {
+        conn_ctx->metrics.rx_buffer_pool_misses++;
+    }
+
+    rx_buf.rx_ctx->data_queue.Push(std::move(data));
 
     if (data_ctx != nullptr) {
         data_ctx->metrics.rx_stream_cb++;
         data_ctx->metrics.rx_stream_bytes += bytes.size();
 
-        if (!cbNotifyQueue_.Push([=, this]() {
+        if (!GetNotifyWorker(conn_ctx->conn_id).queue.Push([=, this]() {
                 delegate_.OnRecvStream(conn_ctx->conn_id, stream_id, data_ctx->data_ctx_id, data_ctx->is_bidir);
             })) {
 
@@ -1421,7 +1824,8 @@ PicoQuicTransport::OnRecvStreamBytes(ConnectionContext* conn_ctx,
         }
 
     } else {
-        if (!cbNotifyQueue_.Push([=, this]() { delegate_.OnRecvStream(conn_ctx->conn_id, stream_id, std::nullopt); })) {
+        if (!GetNotifyWorker(conn_ctx->conn_id).queue.Push(
+              [=, this]() { delegate_.OnRecvStream(conn_ctx->conn_id, stream_id, std::nullopt); })) {
             SPDLOG_LOGGER_ERROR(
               logger, "conn_id: {0} stream_id: {1} notify queue is full", conn_ctx->conn_id, stream_id);
         }
@@ -1429,31 +1833,68 @@ PicoQuicTransport::OnRecvStreamBytes(ConnectionContext* conn_ctx,
 }
 
 void
-PicoQuicTransport::EmitMetrics()
+PicoQuicTransport::EmitMetrics(Shard& shard)
 {
-    for (auto& [conn_id, conn_ctx] : conn_context_) {
+    const auto conn_table = shard.conn_table.Read();
+
+    for (const auto& [conn_id, conn_ctx] : *conn_table) {
         const auto sample_time = std::chrono::system_clock::now();
 
-        delegate_.OnConnectionMetricsSampled(sample_time, conn_id, conn_ctx.metrics);
+        delegate_.OnConnectionMetricsSampled(sample_time, conn_id, conn_ctx->metrics);
 
-        for (auto& [data_ctx_id, data_ctx] : conn_ctx.active_data_contexts) {
-            delegate_.OnDataMetricsStampled(sample_time, conn_id, data_ctx_id, data_ctx.metrics);
-            data_ctx.metrics.ResetPeriod();
+        // Sampled under the lock, the delegate is called without it
+        shard.metrics_samples.clear();
+        {
+            std::lock_guard<std::mutex> _(conn_ctx->mutex);
+            for (auto& [data_ctx_id, data_ctx] : conn_ctx->active_data_contexts) {
+                if (data_ctx.tx_rate_bps != 0) {
+                    data_ctx.TxRefillTokens(tick_service_->Microseconds());
+                    data_ctx.metrics.tx_rate_tokens = static_cast<uint64_t>(std::max(data_ctx.tx_tokens, 0.0));
+                }
+
+                shard.metrics_samples.emplace_back(data_ctx_id, data_ctx.metrics);
+                data_ctx.metrics.ResetPeriod();
+            }
+        }
+
+        for (const auto& [data_ctx_id, metrics] : shard.metrics_samples) {
+            delegate_.OnDataMetricsStampled(sample_time, conn_id, data_ctx_id, metrics);
         }
 
-        conn_ctx.metrics.ResetPeriod();
+        conn_ctx->metrics.ResetPeriod();
     }
 }
 
 void
-PicoQuicTransport::RemoveClosedStreams()
+PicoQuicTransport::ResumePacedStreams(Shard& shard, int64_t& delta_t)
+{
+    if (shard.tx_paced.empty()) {
+        return;
+    }
+
+    const auto now_us = tick_service_->Microseconds();
+
+    std::erase_if(shard.tx_paced, [&](const Shard::PacedStream& paced) {
+        if (paced.resume_us > now_us) {
+            delta_t = std::min<int64_t>(delta_t, paced.resume_us - now_us);
+            return false;
+        }
+
+        MarkStreamActive(paced.conn_id, paced.data_ctx_id);
+        return true;
+    });
+}
+
+void
+PicoQuicTransport::RemoveClosedStreams(Shard& shard)
 {
-    std::lock_guard<std::mutex> _(state_mutex_);
+    const auto conn_table = shard.conn_table.Read();
 
-    for (auto& [conn_id, conn_ctx] : conn_context_) {
+    for (const auto& [conn_id, conn_ctx] : *conn_table) {
+        std::lock_guard<std::mutex> _(conn_ctx->mutex);
         std::vector<uint64_t> closed_streams;
 
-        for (auto& [stream_id, rx_buf] : conn_ctx.rx_stream_buffer) {
+        for (auto& [stream_id, rx_buf] : conn_ctx->rx_stream_buffer) {
             if (rx_buf.closed && (rx_buf.rx_ctx->data_queue.Empty() || rx_buf.checked_once)) {
                 closed_streams.push_back(stream_id);
             }
@@ -1461,15 +1902,15 @@ PicoQuicTransport::RemoveClosedStreams()
         }
 
         for (const auto stream_id : closed_streams) {
-            conn_ctx.rx_stream_buffer.erase(stream_id);
+            conn_ctx->rx_stream_buffer.erase(stream_id);
         }
     }
 }
 
 void
-PicoQuicTransport::CheckConnsForCongestion()
+PicoQuicTransport::CheckConnsForCongestion(Shard& shard)
 {
-    std::lock_guard<std::mutex> _(state_mutex_);
+    const auto conn_table = shard.conn_table.Read();
 
     /*
      * A sign of congestion is when transmit queues are not being serviced (e.g., have a backlog).
@@ -1478,7 +1919,10 @@ PicoQuicTransport::CheckConnsForCongestion()
      * Check each queue size to determine if there is possible congestion
      */
 
-    for (auto& [conn_id, conn_ctx] : conn_context_) {
+    for (const auto& [conn_id, conn_ctx_ptr] : *conn_table) {
+        auto& conn_ctx = *conn_ctx_ptr;
+        std::lock_guard<std::mutex> _(conn_ctx.mutex);
+
         int congested_count{ 0 };
         uint16_t cwin_congested_count = conn_ctx.metrics.cwin_congested - conn_ctx.metrics.prev_cwin_congested;
 
@@ -1498,6 +1942,10 @@ PicoQuicTransport::CheckConnsForCongestion()
         conn_ctx.metrics.tx_rate_bps.AddValue(path_quality.pacing_rate * 8);
         conn_ctx.metrics.rx_rate_bps.AddValue(path_quality.receive_rate_estimate * 8);
 
+        auto& notify_worker = GetNotifyWorker(conn_id);
+        conn_ctx.metrics.notify_worker = notify_worker.index;
+        conn_ctx.metrics.notify_queue_size.AddValue(notify_worker.queue.Size());
+
         // Is CWIN congested?
         if (cwin_congested_count > 5 || (path_quality.cwin < kPqCcLowCwin && path_quality.bytes_in_transit)) {
 
@@ -1601,18 +2049,401 @@ PicoQuicTransport::CheckConnsForCongestion()
  * ============================================================================
  */
 void
-PicoQuicTransport::Server()
+PicoQuicTransport::Server(Shard& shard)
+{
+    int ret;
+
+    // Dual stack IPv6 socket, or IPv4 only when the host has IPv6 disabled
+    int family = AF_INET6;
+    if (const int fd = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP); fd >= 0) {
+        close(fd);
+    } else {
+        family = AF_INET;
+    }
+
+    SPDLOG_LOGGER_INFO(logger,
+                       "Shard {0} binding {1} port {2}",
+                       shard.index,
+                       family == AF_INET6 ? "IPv6 and IPv4" : "IPv4",
+                       serverInfo_.port);
+
+    if (tconfig_.use_batch_io && UdpBatchSocket::Supported()) {
+        ret = BatchPacketLoop(shard, family, serverInfo_.port);
+    } else {
+        ret = SocketPacketLoop(shard, family, serverInfo_.port);
+    }
+
+    if (shard.quic_ctx != NULL) {
+        picoquic_free(shard.quic_ctx);
+        shard.quic_ctx = NULL;
+    }
+
+    SPDLOG_LOGGER_INFO(logger, "picoquic packet loop shard {0} ended with {1}", shard.index, ret);
+
+    if (--running_shards_ == 0) {
+        SetStatus(TransportStatus::kShutdown);
+    }
+}
+
+int
+PicoQuicTransport::SocketPacketLoop(Shard& shard, int family, uint16_t port)
+{
+    const int fd = socket(family, SOCK_DGRAM, IPPROTO_UDP);
+    if (fd < 0) {
+        SPDLOG_LOGGER_ERROR(logger, "Shard {0} unable to create UDP socket, error: {1}", shard.index, errno);
+        return PICOQUIC_ERROR_UNEXPECTED_ERROR;
+    }
+
+    int opt_enable = 1;
+    int opt_disable = 0;
+    int buffer_size = kSocketBufferSize;
+#ifdef SO_REUSEPORT
+    if (shards_.size() > 1) {
+        (void)setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &opt_enable, sizeof(opt_enable));
+    }
+#endif
+    (void)setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+    (void)setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size));
+    (void)picoquic_socket_set_pkt_info(fd, family);
+
+    sockaddr_storage bind_addr{};
+    socklen_t bind_addr_len;
+    if (family == AF_INET6) {
+        (void)setsockopt(fd, IPPROTO_IPV6, IPV6_V6ONLY, &opt_disable, sizeof(opt_disable));
+
+        auto* addr = reinterpret_cast<sockaddr_in6*>(&bind_addr);
+        addr->sin6_family = AF_INET6;
+        addr->sin6_addr = in6addr_any;
+        addr->sin6_port = htons(port);
+        bind_addr_len = sizeof(sockaddr_in6);
+    } else {
+        auto* addr = reinterpret_cast<sockaddr_in*>(&bind_addr);
+        addr->sin_family = AF_INET;
+        addr->sin_addr.s_addr = INADDR_ANY;
+        addr->sin_port = htons(port);
+        bind_addr_len = sizeof(sockaddr_in);
+    }
+
+    if (bind(fd, reinterpret_cast<sockaddr*>(&bind_addr), bind_addr_len) != 0) {
+        SPDLOG_LOGGER_ERROR(logger, "Shard {0} unable to bind port {1}, error: {2}", shard.index, port, errno);
+        close(fd);
+        return PICOQUIC_ERROR_UNEXPECTED_ERROR;
+    }
+
+    // Port is assigned by the kernel when binding port zero
+    (void)getsockname(fd, reinterpret_cast<sockaddr*>(&bind_addr), &bind_addr_len);
+    const auto local_port = reinterpret_cast<sockaddr_in*>(&bind_addr)->sin_port; // Same offset for IPv6
+
+    picoquic_packet_loop_options_t options{};
+    shard.event_wakeup = true;
+    int ret = PqLoopCb(shard.quic_ctx, picoquic_packet_loop_ready, &shard, &options);
+
+    std::vector<uint8_t> recv_buffer(PICOQUIC_MAX_PACKET_SIZE);
+    std::vector<uint8_t> send_buffer(PICOQUIC_MAX_PACKET_SIZE);
+
+    while (ret == 0) {
+        // Run queued work first, it can change when picoquic next needs to run
+        PqRunner(shard);
+
+        uint64_t current_time = picoquic_current_time();
+
+        packet_loop_time_check_arg_t time_check;
+        time_check.current_time = current_time;
+        time_check.delta_t = picoquic_get_next_wake_delay(shard.quic_ctx, current_time, kPqLoopIdleMaxDelayUs);
+
+        if ((ret = PqLoopCb(shard.quic_ctx, picoquic_packet_loop_time_check, &shard, &time_check)) != 0) {
+            break;
+        }
+
+        // Work queued before arming does not signal the wakeup
+        shard.wakeup.Arm();
+        if (!shard.runner_queue.Empty()) {
+            time_check.delta_t = 0;
+        }
+
+        fd_set read_fds;
+        FD_ZERO(&read_fds);
+        FD_SET(fd, &read_fds);
+        if (shard.wakeup.Fd() >= 0) {
+            FD_SET(shard.wakeup.Fd(), &read_fds);
+        }
+
+        timeval timeout{ .tv_sec = static_cast<time_t>(time_check.delta_t / 1'000'000),
+                         .tv_usec = static_cast<suseconds_t>(time_check.delta_t % 1'000'000) };
+
+        const int ready = select(std::max(fd, shard.wakeup.Fd()) + 1, &read_fds, NULL, NULL, &timeout);
+        shard.wakeup.Disarm();
+
+        if (ready > 0 && FD_ISSET(fd, &read_fds)) {
+            sockaddr_storage addr_from;
+            sockaddr_storage addr_to;
+            int if_index_to = 0;
+            unsigned char received_ecn = 0;
+
+            const int bytes_recv = picoquic_recvmsg(fd,
+                                                    &addr_from,
+                                                    &addr_to,
+                                                    &if_index_to,
+                                                    &received_ecn,
+                                                    recv_buffer.data(),
+                                                    static_cast<int>(recv_buffer.size()));
+
+            if (bytes_recv > 0) {
+                // recvmsg does not provide the local port
+                reinterpret_cast<sockaddr_in6*>(&addr_to)->sin6_port = local_port;
+
+                current_time = picoquic_current_time();
+                picoquic_cnx_t* last_cnx = nullptr;
+                (void)picoquic_incoming_packet_ex(shard.quic_ctx,
+                                                  recv_buffer.data(),
+                                                  static_cast<size_t>(bytes_recv),
+                                                  reinterpret_cast<sockaddr*>(&addr_from),
+                                                  reinterpret_cast<sockaddr*>(&addr_to),
+                                                  if_index_to,
+                                                  received_ecn,
+                                                  &last_cnx,
+                                                  current_time);
+
+                if ((ret = PqLoopCb(shard.quic_ctx, picoquic_packet_loop_after_receive, &shard, NULL)) != 0) {
+                    break;
+                }
+            }
+        }
+
+        // Queued work may have made streams active
+        PqRunner(shard);
+
+        // Send all packets that are ready to go out
+        while (ret == 0) {
+            sockaddr_storage peer_addr;
+            sockaddr_storage local_addr;
+            int if_index = 0;
+            size_t send_length = 0;
+            size_t send_msg_size = 0;
+            picoquic_connection_id_t log_cid;
+            picoquic_cnx_t* last_cnx = nullptr;
+
+            ret = picoquic_prepare_next_packet_ex(shard.quic_ctx,
+                                                  picoquic_current_time(),
+                                                  send_buffer.data(),
+                                                  send_buffer.size(),
+                                                  &send_length,
+                                                  &peer_addr,
+                                                  &local_addr,
+                                                  &if_index,
+                                                  &log_cid,
+                                                  &last_cnx,
+                                                  &send_msg_size);
+
+            if (ret != 0 || send_length == 0) {
+                break;
+            }
+
+            int sock_err = 0;
+            const int sock_ret = picoquic_sendmsg(fd,
+                                                  reinterpret_cast<sockaddr*>(&peer_addr),
+                                                  reinterpret_cast<sockaddr*>(&local_addr),
+                                                  if_index,
+                                                  reinterpret_cast<const char*>(send_buffer.data()),
+                                                  static_cast<int>(send_length),
+                                                  0,
+                                                  &sock_err);
+
+            if (sock_ret <= 0) {
+                OnSendError(shard,
+                            last_cnx,
+                            reinterpret_cast<sockaddr*>(&peer_addr),
+                            reinterpret_cast<sockaddr*>(&local_addr),
+                            if_index,
+                            sock_err);
+            }
+        }
+
+        if (ret == 0) {
+            ret = PqLoopCb(shard.quic_ctx, picoquic_packet_loop_after_send, &shard, NULL);
+        }
+    }
+
+    close(fd);
+
+    return ret;
+}
+
+int
+PicoQuicTransport::BatchPacketLoop(Shard& shard, int family, uint16_t port)
 {
-    int ret = picoquic_packet_loop(quic_ctx_, serverInfo_.port, PF_UNSPEC, 0, 2000000, 0, PqLoopCb, this);
+#if defined(__linux__)
+    UdpBatchSocket socket(PICOQUIC_MAX_PACKET_SIZE, true);
+
+    if (const int err = socket.Open(family, port, shards_.size() > 1); err != 0) {
+        SPDLOG_LOGGER_ERROR(
+          logger, "Shard {0} unable to open UDP socket on port {1}, error: {2}", shard.index, port, err);
+        return PICOQUIC_ERROR_UNEXPECTED_ERROR;
+    }
+
+    SPDLOG_LOGGER_INFO(logger,
+                       "Shard {0} using batched UDP I/O, gso: {1} gro: {2}",
+                       shard.index,
+                       socket.GsoEnabled(),
+                       socket.GroEnabled());
+
+    // Connections that prepared packets are checked when the batch is flushed, picoquic may have deleted them
+    socket.SetSendErrorHandler([this, &shard](const UdpBatchSocket::SendError& error) {
+        auto* pq_cnx = static_cast<picoquic_cnx_t*>(error.context);
+        if (pq_cnx != nullptr && !shard.conn_ids.contains(pq_cnx)) {
+            pq_cnx = nullptr;
+        }
+
+        OnSendError(shard, pq_cnx, error.peer_addr, error.local_addr, error.if_index, error.error);
+    });
+
+    picoquic_packet_loop_options_t options{};
+    shard.event_wakeup = true;
+    int ret = PqLoopCb(shard.quic_ctx, picoquic_packet_loop_ready, &shard, &options);
+
+    while (ret == 0) {
+        // Run queued work first, it can change when picoquic next needs to run
+        PqRunner(shard);
+
+        uint64_t current_time = picoquic_current_time();
+
+        packet_loop_time_check_arg_t time_check;
+        time_check.current_time = current_time;
+        time_check.delta_t = picoquic_get_next_wake_delay(shard.quic_ctx, current_time, kPqLoopIdleMaxDelayUs);
+
+        if ((ret = PqLoopCb(shard.quic_ctx, picoquic_packet_loop_time_check, &shard, &time_check)) != 0) {
+            break;
+        }
+
+        // Work queued before arming does not signal the wakeup
+        shard.wakeup.Arm();
+        if (!shard.runner_queue.Empty()) {
+            time_check.delta_t = 0;
+        }
+
+        std::array<pollfd, 2> poll_fds{ { { socket.Fd(), POLLIN, 0 }, { shard.wakeup.Fd(), POLLIN, 0 } } };
+        const timespec timeout{ .tv_sec = static_cast<time_t>(time_check.delta_t / 1'000'000),
+                                .tv_nsec = static_cast<long>(time_check.delta_t % 1'000'000) * 1000 };
+
+        const int ready = ppoll(poll_fds.data(), poll_fds.size(), &timeout, nullptr);
+        shard.wakeup.Disarm();
+
+        if (ready > 0 && (poll_fds[0].revents & POLLIN)) {
+            const auto packets = socket.Receive();
+
+            if (!packets.empty()) {
+                current_time = picoquic_current_time();
+
+                for (const auto& packet : packets) {
+                    picoquic_cnx_t* last_cnx = nullptr;
+                    (void)picoquic_incoming_packet_ex(shard.quic_ctx,
+                                                      packet.data.data(),
+                                                      packet.data.size(),
+                                                      reinterpret_cast<sockaddr*>(packet.peer_addr),
+                                                      reinterpret_cast<sockaddr*>(packet.local_addr),
+                                                      packet.if_index,
+                                                      packet.ecn,
+                                                      &last_cnx,
+                                                      current_time);
+                }
+
+                if ((ret = PqLoopCb(shard.quic_ctx, picoquic_packet_loop_after_receive, &shard, NULL)) != 0) {
+                    break;
+                }
+            }
+        }
+
+        // Queued work may have made streams active
+        PqRunner(shard);
+
+        // Prepare all packets that are ready to go out, picoquic coalesces packets to the same peer when GSO is on
+        while (ret == 0) {
+            sockaddr_storage peer_addr;
+            sockaddr_storage local_addr;
+            int if_index = 0;
+            size_t send_length = 0;
+            size_t send_msg_size = 0;
+            picoquic_connection_id_t log_cid;
+            picoquic_cnx_t* last_cnx = nullptr;
+
+            const auto buffer = socket.SendBuffer();
+
+            ret = picoquic_prepare_next_packet_ex(shard.quic_ctx,
+                                                  picoquic_current_time(),
+                                                  buffer.data(),
+                                                  buffer.size(),
+                                                  &send_length,
+                                                  &peer_addr,
+                                                  &local_addr,
+                                                  &if_index,
+                                                  &log_cid,
+                                                  &last_cnx,
+                                                  &send_msg_size);
+
+            if (ret != 0 || send_length == 0) {
+                break;
+            }
+
+            socket.QueueSend(send_length,
+                             send_msg_size,
+                             reinterpret_cast<sockaddr*>(&peer_addr),
+                             reinterpret_cast<sockaddr*>(&local_addr),
+                             if_index,
+                             last_cnx);
+        }
 
-    if (quic_ctx_ != NULL) {
-        picoquic_free(quic_ctx_);
-        quic_ctx_ = NULL;
+        socket.Flush();
+
+        if (ret == 0) {
+            ret = PqLoopCb(shard.quic_ctx, picoquic_packet_loop_after_send, &shard, NULL);
+        }
     }
 
-    SPDLOG_LOGGER_INFO(logger, "picoquic packet loop ended with {0}", ret);
+    const auto& stats = socket.GetStats();
+    SPDLOG_LOGGER_INFO(logger,
+                       "Shard {0} batched UDP I/O rx packets: {1} syscalls: {2} tx packets: {3} syscalls: {4}",
+                       shard.index,
+                       stats.rx_packets,
+                       stats.rx_syscalls,
+                       stats.tx_packets,
+                       stats.tx_syscalls);
+
+    return ret;
+#else
+    // Not used when UdpBatchSocket is not supported
+    (void)family;
+    (void)port;
+    SPDLOG_LOGGER_ERROR(logger, "Shard {0} batched UDP I/O is only supported on Linux", shard.index);
+    return PICOQUIC_ERROR_UNEXPECTED_ERROR;
+#endif
+}
+
+void
+PicoQuicTransport::OnSendError(Shard& shard,
+                               picoquic_cnx_t* pq_cnx,
+                               sockaddr* peer_addr,
+                               sockaddr* local_addr,
+                               int if_index,
+                               int sock_err)
+{
+    SPDLOG_LOGGER_DEBUG(logger, "Shard {0} unable to send packet, error: {1}", shard.index, sock_err);
+
+    if (pq_cnx == nullptr) {
+        return;
+    }
 
-    SetStatus(TransportStatus::kShutdown);
+    switch (sock_err) {
+        case EADDRNOTAVAIL:
+        case ENETDOWN:
+        case ENETUNREACH:
+        case EHOSTDOWN:
+        case EHOSTUNREACH:
+            picoquic_notify_destination_unreachable(
+              pq_cnx, picoquic_current_time(), peer_addr, local_addr, if_index, sock_err);
+            break;
+        default:
+            break;
+    }
 }
 
 TransportConnId
@@ -1634,15 +2465,17 @@ PicoQuicTransport::CreateClient()
         sni = serverInfo_.host_or_ip.c_str();
     }
 
+    auto& shard = *shards_.front();
+
     if (tconfig_.use_bbr) {
-        picoquic_set_default_congestion_algorithm(quic_ctx_, picoquic_bbr_algorithm);
+        picoquic_set_default_congestion_algorithm(shard.quic_ctx, picoquic_bbr_algorithm);
     } else {
-        picoquic_set_default_congestion_algorithm(quic_ctx_, picoquic_newreno_algorithm);
+        picoquic_set_default_congestion_algorithm(shard.quic_ctx, picoquic_newreno_algorithm);
     }
 
     uint64_t current_time = picoquic_current_time();
 
-    picoquic_cnx_t* cnx = picoquic_create_cnx(quic_ctx_,
+    picoquic_cnx_t* cnx = picoquic_create_cnx(shard.quic_ctx,
                                               picoquic_null_connection_id,
                                               picoquic_null_connection_id,
                                               reinterpret_cast<struct sockaddr*>(&server_address),
@@ -1672,9 +2505,7 @@ PicoQuicTransport::CreateClient()
     //    picoquic_subscribe_pacing_rate_updates(cnx, tconfig.pacing_decrease_threshold_Bps,
     //                                           tconfig.pacing_increase_threshold_Bps);
 
-    CreateConnContext(cnx);
-
-    return reinterpret_cast<uint64_t>(cnx);
+    return CreateConnContext(shard, cnx).conn_id;
 }
 
 void
@@ -1682,6 +2513,7 @@ PicoQuicTransport::Client(const TransportConnId conn_id)
 {
     int ret;
 
+    auto& shard = GetShard(conn_id);
     auto conn_ctx = GetConnContext(conn_id);
 
     if (conn_ctx == nullptr) {
@@ -1695,7 +2527,7 @@ PicoQuicTransport::Client(const TransportConnId conn_id)
     if (conn_ctx->pq_cnx == NULL) {
         SPDLOG_LOGGER_ERROR(logger, "Could not create picoquic connection client context");
     } else {
-        picoquic_set_callback(conn_ctx->pq_cnx, PqEventCb, this);
+        picoquic_set_callback(conn_ctx->pq_cnx, PqEventCb, &shard);
 
         picoquic_enable_keep_alive(conn_ctx->pq_cnx, tconfig_.idle_timeout_ms * 500);
         ret = picoquic_start_client_cnx(conn_ctx->pq_cnx);
@@ -1704,17 +2536,24 @@ PicoQuicTransport::Client(const TransportConnId conn_id)
             return;
         }
 #ifdef ESP_PLATFORM
-        ret = picoquic_packet_loop(quic_ctx_, 0, PF_UNSPEC, 0, 0x2048, 0, PqLoopCb, this);
+        ret = picoquic_packet_loop(shard.quic_ctx, 0, PF_UNSPEC, 0, 0x2048, 0, PqLoopCb, &shard);
 #else
-        ret = picoquic_packet_loop(quic_ctx_, 0, PF_UNSPEC, 0, 2000000, 0, PqLoopCb, this);
+        sockaddr* server_addr = nullptr;
+        picoquic_get_peer_addr(conn_ctx->pq_cnx, &server_addr);
+
+        if (tconfig_.use_batch_io && UdpBatchSocket::Supported()) {
+            ret = BatchPacketLoop(shard, server_addr->sa_family, 0);
+        } else {
+            ret = SocketPacketLoop(shard, server_addr->sa_family, 0);
+        }
 #endif
 
         SPDLOG_LOGGER_INFO(logger, "picoquic ended with {0}", ret);
     }
 
-    if (quic_ctx_ != NULL) {
-        picoquic_free(quic_ctx_);
-        quic_ctx_ = NULL;
+    if (shard.quic_ctx != NULL) {
+        picoquic_free(shard.quic_ctx);
+        shard.quic_ctx = NULL;
     }
 
     SetStatus(TransportStatus::kDisconnected);
@@ -1728,17 +2567,29 @@ PicoQuicTransport::Shutdown()
 
     stop_ = true;
 
-    if (picoQuicThread_.joinable()) {
-        SPDLOG_LOGGER_INFO(logger, "Closing transport pico thread");
-        picoQuicThread_.join();
+    // Loops blocked waiting for events need to see the status change
+    for (auto& shard : shards_) {
+        shard->wakeup.Signal();
     }
 
-    picoquic_runner_queue_.StopWaiting();
-    cbNotifyQueue_.StopWaiting();
+    for (auto& shard : shards_) {
+        if (shard->thread.joinable()) {
+            SPDLOG_LOGGER_INFO(logger, "Closing transport pico thread for shard {0}", shard->index);
+            shard->thread.join();
+        }
 
-    if (cbNotifyThread_.joinable()) {
-        SPDLOG_LOGGER_INFO(logger, "Closing transport callback notifier thread");
-        cbNotifyThread_.join();
+        shard->runner_queue.StopWaiting();
+    }
+
+    for (auto& worker : notify_workers_) {
+        worker->queue.StopWaiting();
+    }
+
+    for (auto& worker : notify_workers_) {
+        if (worker->thread.joinable()) {
+            SPDLOG_LOGGER_INFO(logger, "Closing transport callback notifier thread {0}", worker->index);
+            worker->thread.join();
+        }
     }
 
     tick_service_.reset();
@@ -1777,20 +2628,95 @@ PicoQuicTransport::CheckCallbackDelta(DataContext* data_ctx, bool tx)
 }
 
 void
-PicoQuicTransport::CbNotifier()
+PicoQuicTransport::SetTxBackpressure(const TransportConnId conn_id, const DataContextId data_ctx_id)
 {
-    SPDLOG_LOGGER_INFO(logger, "Starting transport callback notifier thread");
+    const auto conn_table = GetShard(conn_id).conn_table.Read();
+
+    const auto conn_it = conn_table->find(conn_id);
+    if (conn_it == conn_table->end()) {
+        return;
+    }
+
+    auto& conn_ctx = *conn_it->second;
+    std::lock_guard<std::mutex> _(conn_ctx.mutex);
+
+    const auto data_ctx_it = conn_ctx.active_data_contexts.find(data_ctx_id);
+    if (data_ctx_it == conn_ctx.active_data_contexts.end()) {
+        return;
+    }
+
+    auto& data_ctx = data_ctx_it->second;
+    data_ctx.tx_backpressure_pending = false;
+
+    if (!data_ctx.tx_backpressure) {
+        data_ctx.tx_backpressure = true;
+
+        GetNotifyWorker(conn_id).queue.PushOrOverflow(
+          [this, conn_id, data_ctx_id]() { delegate_.OnDataContextBackpressure(conn_id, data_ctx_id); });
+    }
+
+    // The queue may have drained before the loop got here
+    CheckTxDrained(data_ctx);
+}
+
+void
+PicoQuicTransport::CheckTxDrained(DataContext& data_ctx)
+{
+    if (!data_ctx.tx_backpressure || !data_ctx.TxQueueDrained()) {
+        return;
+    }
+
+    data_ctx.tx_backpressure = false;
+
+    GetNotifyWorker(data_ctx.conn_id)
+      .queue.PushOrOverflow([this, conn_id = data_ctx.conn_id, data_ctx_id = data_ctx.data_ctx_id]() {
+          delegate_.OnDataContextDrained(conn_id, data_ctx_id);
+      });
+}
+
+bool
+PicoQuicTransport::WaitForTxTokens(DataContext& data_ctx)
+{
+    const auto now_us = tick_service_->Microseconds();
+    data_ctx.TxRefillTokens(now_us);
+
+    const auto min_tokens = static_cast<double>(std::min<uint32_t>(data_ctx.tx_burst_bytes, kTxPacingMinBytes));
+    if (data_ctx.tx_tokens >= min_tokens) {
+        return false;
+    }
+
+    data_ctx.metrics.tx_rate_limited++;
+
+    if (!data_ctx.tx_paused) {
+        data_ctx.tx_paused = true;
+        data_ctx.mark_stream_active = true;
+
+        const auto wait_us = static_cast<uint64_t>((min_tokens - data_ctx.tx_tokens) * 8'000'000.0 /
+                                                   static_cast<double>(data_ctx.tx_rate_bps));
+
+        GetShard(data_ctx.conn_id).tx_paced.push_back({ now_us + wait_us + 1, data_ctx.conn_id, data_ctx.data_ctx_id });
+    }
+
+    return true;
+}
+
+void
+PicoQuicTransport::CbNotifier(NotifyWorker& worker)
+{
+    SPDLOG_LOGGER_INFO(logger, "Starting transport callback notifier thread {0}", worker.index);
 
     while (not stop_) {
-        auto cb = cbNotifyQueue_.BlockPop();
-        if (cb) {
-            (*cb)();
-        } else {
-            SPDLOG_LOGGER_INFO(logger, "Notify callback is NULL");
+        try {
+            worker.queue.BlockRun();
+        } catch (const std::exception& e) {
+            SPDLOG_LOGGER_ERROR(
+              logger, "Transport callback notifier thread {0} callback failed: {1}", worker.index, e.what());
+        } catch (...) {
+            SPDLOG_LOGGER_ERROR(logger, "Transport callback notifier thread {0} callback failed", worker.index);
         }
     }
 
-    SPDLOG_LOGGER_INFO(logger, "Done with transport callback notifier thread");
+    SPDLOG_LOGGER_INFO(logger, "Done with transport callback notifier thread {0}", worker.index);
 }
 
 void
@@ -1820,7 +2746,7 @@ PicoQuicTransport::CreateStream(ConnectionContext& conn_ctx, DataContext* data_c
      */
     picoquic_set_app_stream_ctx(conn_ctx.pq_cnx, *data_ctx->current_stream_id, data_ctx);
 
-    picoquic_runner_queue_.Push([this, conn_id = conn_ctx.conn_id, data_ctx_id = data_ctx->data_ctx_id]() {
+    GetShard(conn_ctx.conn_id).RunOnLoop([this, conn_id = conn_ctx.conn_id, data_ctx_id = data_ctx->data_ctx_id]() {
         MarkStreamActive(conn_id, data_ctx_id);
     });
 }
@@ -1857,53 +2783,59 @@ PicoQuicTransport::CloseStream(ConnectionContext& conn_ctx, DataContext* data_ct
     if (data_ctx->current_stream_id) {
         const auto rx_buf_it = conn_ctx.rx_stream_buffer.find(*data_ctx->current_stream_id);
         if (rx_buf_it != conn_ctx.rx_stream_buffer.end()) {
-            std::lock_guard<std::mutex> _(state_mutex_);
             conn_ctx.rx_stream_buffer.erase(rx_buf_it);
         }
     }
 
     data_ctx->ResetTxObject();
+    data_ctx->tx_unsent.clear();
     data_ctx->current_stream_id = std::nullopt;
 }
 
 void
 PicoQuicTransport::MarkStreamActive(const TransportConnId conn_id, const DataContextId data_ctx_id)
 {
-    std::lock_guard _(state_mutex_);
+    const auto conn_table = GetShard(conn_id).conn_table.Read();
 
-    const auto conn_it = conn_context_.find(conn_id);
-    if (conn_it == conn_context_.end()) {
+    const auto conn_it = conn_table->find(conn_id);
+    if (conn_it == conn_table->end()) {
         return;
     }
 
-    const auto data_ctx_it = conn_it->second.active_data_contexts.find(data_ctx_id);
-    if (data_ctx_it == conn_it->second.active_data_contexts.end()) {
+    auto& conn_ctx = *conn_it->second;
+    std::lock_guard<std::mutex> _(conn_ctx.mutex);
+
+    const auto data_ctx_it = conn_ctx.active_data_contexts.find(data_ctx_id);
+    if (data_ctx_it == conn_ctx.active_data_contexts.end()) {
         return;
     }
 
     data_ctx_it->second.mark_stream_active = false;
+    data_ctx_it->second.tx_paused = false;
 
     if (!data_ctx_it->second.current_stream_id.has_value()) {
         return;
     }
 
-    picoquic_mark_active_stream(
-      conn_it->second.pq_cnx, *data_ctx_it->second.current_stream_id, 1, &data_ctx_it->second);
+    picoquic_mark_active_stream(conn_ctx.pq_cnx, *data_ctx_it->second.current_stream_id, 1, &data_ctx_it->second);
     picoquic_set_stream_priority(
-      conn_it->second.pq_cnx, *data_ctx_it->second.current_stream_id, (data_ctx_it->second.priority << 1));
+      conn_ctx.pq_cnx, *data_ctx_it->second.current_stream_id, (data_ctx_it->second.priority << 1));
 }
 
 void
 PicoQuicTransport::MarkDgramReady(const TransportConnId conn_id)
 {
-    std::lock_guard<std::mutex> _(state_mutex_);
+    const auto conn_table = GetShard(conn_id).conn_table.Read();
 
-    const auto conn_it = conn_context_.find(conn_id);
-    if (conn_it == conn_context_.end()) {
+    const auto conn_it = conn_table->find(conn_id);
+    if (conn_it == conn_table->end()) {
         return;
     }
 
-    picoquic_mark_datagram_ready(conn_it->second.pq_cnx, 1);
+    auto& conn_ctx = *conn_it->second;
+    std::lock_guard<std::mutex> _(conn_ctx.mutex);
+
+    picoquic_mark_datagram_ready(conn_ctx.pq_cnx, 1);
 
-    conn_it->second.mark_dgram_ready = false;
+    conn_ctx.mark_dgram_ready = false;
 }
@@ -3,11 +3,17 @@
 
 #pragma once
 
+#include "quicr/detail/buffer_pool.h"
+#include "quicr/detail/epoch_ptr.h"
+#include "quicr/detail/flat_hash_map.h"
+#include "quicr/detail/loop_wakeup.h"
 #include "quicr/detail/priority_queue.h"
 #include "quicr/detail/quic_transport_metrics.h"
 #include "quicr/detail/safe_queue.h"
 #include "quicr/detail/stream_buffer.h"
+#include "quicr/detail/task_queue.h"
 #include "quicr/detail/time_queue.h"
+#include "quicr/detail/timing_wheel.h"
 
 #include <picoquic.h>
 #include <picoquic_config.h>
@@ -15,10 +21,14 @@
 #include <quicr/detail/quic_transport.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <cstring>
 #include <functional>
+#include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -29,14 +39,20 @@
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <thread>
+#include <utility>
 #include <vector>
 
 namespace quicr {
 
     constexpr int kPqLoopMaxDelayUs = 500;            /// The max microseconds that pq_loop will be ran again
+    constexpr int kPqLoopIdleMaxDelayUs = 50'000;     /// Max microseconds an event woken pq_loop blocks when idle
     constexpr int kPqRestWaitMinPriority = 4;         /// Minimum priority value to consider for RESET and WAIT
     constexpr int kPqCcLowCwin = 4000;                /// Bytes less than this value are considered a low/congested CWIN
     constexpr int kCongestionCheckInterval = 100'000; /// Congestion check interval in microseconds
+    constexpr int kConnIdShardShift = 56;             /// Bit shift of the shard index encoded in the connection ID
+    constexpr int kRxBufferSize = 1536;               /// Size of pooled receive buffers, max picoquic packet size
+    constexpr int kSocketBufferSize = 2'000'000;      /// UDP socket send and receive buffer size in bytes
+    constexpr int kTxPacingMinBytes = 1200;           /// Tokens a rate limited stream waits for, about a packet
 
     /**
      * Minimum bytes needed to write before considering to send. This doesn't
@@ -58,27 +74,46 @@ namespace quicr {
          */
         struct DataContext
         {
+            // Flags and priority are packed together, a data context exists per track
             bool is_bidir{ false };           /// Indicates if the stream is bidir (true) or unidir (false)
             bool mark_stream_active{ false }; /// Instructs the stream to be marked active
             bool tx_start_stream{ false };    /// Indicates tx queue starts a new stream
 
             bool uses_reset_wait{ false };       /// Indicates if data context can/uses reset wait strategy
             bool tx_reset_wait_discard{ false }; /// Instructs TX objects to be discarded on POP instead
+            bool tx_backpressure{ false };       /// Backpressure was notified and drained is not yet, loop thread only
+            bool tx_paused{ false };             /// Waiting for rate limit tokens, the packet loop marks it active
+
+            std::atomic<bool> tx_backpressure_pending{ false }; /// Objects were refused, the loop is to notify it
+
+            uint8_t priority{ 0 };
+
+            uint32_t tx_max_objects{ 0 }; /// TX queue budget in objects, zero is unlimited
+            uint32_t tx_quantum{ 0 };     /// Round robin bytes per turn among equal priority streams, zero disables
+            uint32_t tx_deficit{ 0 };     /// Bytes left in the current round robin turn
+            uint32_t tx_burst_bytes{ 0 }; /// Rate limit token bucket size in bytes
+            uint64_t tx_max_bytes{ 0 };   /// TX queue budget in bytes, zero is unlimited
+
+            uint64_t tx_rate_bps{ 0 };       /// Rate limit in bits per second, zero is unlimited
+            double tx_tokens{ 0 };           /// Rate limit tokens in bytes
+            uint64_t tx_tokens_time_us{ 0 }; /// Time the tokens were last added
 
             DataContextId data_ctx_id{ 0 }; /// The ID of this context
             TransportConnId conn_id{ 0 };   /// The connection ID this context is under
 
             std::optional<uint64_t> current_stream_id; /// Current active stream if the value is >= 4
 
-            uint8_t priority{ 0 };
-
             uint64_t in_data_cb_skip_count{ 0 }; /// Number of times callback was skipped due to size
 
             std::unique_ptr<PriorityQueue<ConnData>> tx_data; /// Pending objects to be written to the network
 
             /// Current object that is being sent as a byte stream
             std::shared_ptr<const std::vector<uint8_t>> stream_tx_object;
-            size_t stream_tx_object_offset{ 0 }; /// Pointer offset to next byte to send
+            std::shared_ptr<const std::vector<uint8_t>> stream_tx_payload; /// Optional payload sent after the object
+            size_t stream_tx_object_offset{ 0 }; /// Pointer offset to next byte to send, spans object and payload
+
+            /// Objects popped to coalesce after the TX object that picoquic had no buffer for, sent before tx_data
+            std::vector<ConnData> tx_unsent;
 
             // The last ticks when TX callback was run
             uint64_t last_tx_tick{ 0 };
@@ -86,8 +121,10 @@ namespace quicr {
             QuicDataContextMetrics metrics;
 
             DataContext() = default;
-            DataContext(DataContext&&) = default;
 
+            // Constructed in place in the pointer stable active_data_contexts map
+            DataContext(const DataContext&) = delete;
+            DataContext(DataContext&&) = delete;
             DataContext& operator=(const DataContext&) = delete;
             DataContext& operator=(DataContext&&) = delete;
 
@@ -95,6 +132,7 @@ namespace quicr {
             {
                 // clean up
                 stream_tx_object = nullptr;
+                stream_tx_payload = nullptr;
             }
 
             /**
@@ -104,8 +142,228 @@ namespace quicr {
             {
                 // reset/clean up
                 stream_tx_object = nullptr;
+                stream_tx_payload = nullptr;
                 stream_tx_object_offset = 0;
             }
+
+            /**
+             * Check if objects fit in the TX queue budget
+             *
+             * @details An empty queue always has room so that objects larger than the budget are still sent.
+             *
+             * @param objects           Number of objects to queue
+             * @param bytes             Bytes of the objects to queue
+             * @param clear_tx_queue    Queue is cleared before the objects are queued
+             */
+            bool TxQueueHasRoom(size_t objects, size_t bytes, bool clear_tx_queue) const noexcept
+            {
+                const size_t queued_objects = clear_tx_queue ? 0 : tx_data->Size();
+                const size_t queued_bytes = clear_tx_queue ? 0 : tx_data->Bytes();
+
+                if (queued_objects == 0) {
+                    return true;
+                }
+
+                return (tx_max_objects == 0 || queued_objects + objects <= tx_max_objects) &&
+                       (tx_max_bytes == 0 || queued_bytes + bytes <= tx_max_bytes);
+            }
+
+            /**
+             * Check if the reliable objects of a batch fit in the TX queue budget, all or none
+             *
+             * @details Refused objects are counted in the queue full metric. Datagrams and empty objects
+             *      are not queued in the TX queue and are not counted.
+             *
+             * @param objects           Objects of the batch
+             */
+            bool TxQueueAdmit(std::span<const EnqueueObject> objects) noexcept
+            {
+                if (tx_max_bytes == 0 && tx_max_objects == 0) {
+                    return true;
+                }
+
+                size_t batch_objects = 0;
+                size_t batch_bytes = 0;
+                bool clear_tx_queue = false;
+
+                for (const auto& object : objects) {
+                    if (object.flags.use_reliable && object.bytes && !object.bytes->empty()) {
+                        batch_objects++;
+                        batch_bytes += object.bytes->size() + (object.payload ? object.payload->size() : 0);
+                        clear_tx_queue |= object.flags.clear_tx_queue;
+                    }
+                }
+
+                if (!TxQueueHasRoom(batch_objects, batch_bytes, clear_tx_queue)) {
+                    metrics.tx_queue_full += batch_objects;
+                    return false;
+                }
+
+                return true;
+            }
+
+            /**
+             * Check if the TX queue is below half of its budget
+             */
+            bool TxQueueDrained() const noexcept
+            {
+                return (tx_max_objects == 0 || tx_data->Size() <= tx_max_objects / 2) &&
+                       (tx_max_bytes == 0 || tx_data->Bytes() <= tx_max_bytes / 2);
+            }
+
+            /**
+             * Bytes that can be written in this stream callback by deficit round robin and the rate limit
+             *
+             * @details Starts a new turn of tx_quantum bytes when the last turn is used up
+             *
+             * @param max_len       Bytes picoquic can take in this callback
+             */
+            size_t TxAllowance(size_t max_len) noexcept
+            {
+                if (tx_quantum != 0) {
+                    if (tx_deficit == 0) {
+                        tx_deficit = tx_quantum;
+                    }
+
+                    max_len = std::min<size_t>(max_len, tx_deficit);
+                }
+
+                if (tx_rate_bps != 0) {
+                    max_len = std::min(max_len, static_cast<size_t>(tx_tokens));
+                }
+
+                return max_len;
+            }
+
+            /**
+             * Use bytes of the current round robin turn and rate limit tokens
+             *
+             * @param len           Bytes written in this stream callback
+             *
+             * @returns True if the turn is used up and the stream should yield to others of the same priority
+             */
+            bool TxConsume(size_t len) noexcept
+            {
+                if (tx_rate_bps != 0) {
+                    tx_tokens -= static_cast<double>(len);
+                }
+
+                if (tx_quantum == 0) {
+                    return false;
+                }
+
+                tx_deficit -= static_cast<uint32_t>(std::min<size_t>(len, tx_deficit));
+                return tx_deficit == 0;
+            }
+
+            /**
+             * Rate limit token bucket size in bytes
+             *
+             * @param rate_bps      Rate limit in bits per second
+             * @param burst_bytes   Bucket size in bytes, zero is 100 milliseconds of the rate
+             */
+            static uint32_t TxBurstBytes(uint64_t rate_bps, uint32_t burst_bytes) noexcept
+            {
+                if (burst_bytes != 0) {
+                    return burst_bytes;
+                }
+
+                return static_cast<uint32_t>(std::min<uint64_t>(rate_bps / 80, std::numeric_limits<uint32_t>::max()));
+            }
+
+            /**
+             * Set the rate limit, starting with a full token bucket
+             *
+             * @param rate_bps      Rate limit in bits per second, zero is unlimited
+             * @param burst_bytes   Rate limit token bucket size in bytes
+             * @param now_us        Current time in microseconds
+             */
+            void SetTxRateLimit(uint64_t rate_bps, uint32_t burst_bytes, uint64_t now_us) noexcept
+            {
+                tx_rate_bps = rate_bps;
+                tx_burst_bytes = burst_bytes;
+                tx_tokens = burst_bytes;
+                tx_tokens_time_us = now_us;
+            }
+
+            /**
+             * Add the rate limit tokens earned since they were last added, up to the bucket size
+             *
+             * @param now_us        Current time in microseconds
+             */
+            void TxRefillTokens(uint64_t now_us) noexcept
+            {
+                if (tx_rate_bps == 0 || now_us <= tx_tokens_time_us) {
+                    return;
+                }
+
+                const auto earned = static_cast<double>(now_us - tx_tokens_time_us) * tx_rate_bps / 8'000'000;
+                tx_tokens = std::min(static_cast<double>(tx_burst_bytes), tx_tokens + earned);
+                tx_tokens_time_us = now_us;
+            }
+
+            /**
+             * Make the first unsent object the TX object when there is no TX object
+             *
+             * @details Objects that were popped but not written go before the TX queue, they have no stream
+             *      action.
+             */
+            void TakeTxUnsent()
+            {
+                if (stream_tx_object != nullptr || tx_unsent.empty()) {
+                    return;
+                }
+
+                auto& object = tx_unsent.front();
+                stream_tx_object = std::move(object.data);
+                stream_tx_payload = std::move(object.payload);
+                stream_tx_object_offset = 0;
+                tx_unsent.erase(tx_unsent.begin());
+            }
+
+            /**
+             * Keep the bytes that picoquic had no buffer for, to send them in the next stream callback
+             *
+             * @param offset        Offset of the TX object bytes that were to be written
+             * @param coalesce      Objects coalesced after the TX object, moved to the front of tx_unsent
+             */
+            void RestoreTxUnsent(size_t offset, std::vector<ConnData>& coalesce)
+            {
+                stream_tx_object_offset = offset;
+                tx_unsent.insert(tx_unsent.begin(),
+                                 std::make_move_iterator(coalesce.begin()),
+                                 std::make_move_iterator(coalesce.end()));
+                coalesce.clear();
+            }
+
+            /**
+             * Size of the TX object including the payload
+             */
+            size_t TxObjectSize() const noexcept
+            {
+                return stream_tx_object->size() + (stream_tx_payload ? stream_tx_payload->size() : 0);
+            }
+
+            /**
+             * Copy bytes of the TX object and payload, gathering across both
+             *
+             * @param buf           Buffer to copy into
+             * @param offset        Offset of the first byte to copy, relative to the start of the TX object
+             * @param len           Number of bytes to copy
+             */
+            void CopyTxObject(uint8_t* buf, size_t offset, size_t len) const
+            {
+                size_t copied = 0;
+                if (offset < stream_tx_object->size()) {
+                    copied = std::min(len, stream_tx_object->size() - offset);
+                    std::memcpy(buf, stream_tx_object->data() + offset, copied);
+                }
+
+                if (copied < len) {
+                    const auto payload_offset = offset + copied - stream_tx_object->size();
+                    std::memcpy(buf + copied, stream_tx_payload->data() + payload_offset, len - copied);
+                }
+            }
         };
 
         /**
@@ -115,12 +373,16 @@ namespace quicr {
         {
             TransportConnId conn_id{ 0 };     /// This connection ID
             picoquic_cnx_t* pq_cnx = nullptr; /// Picoquic connection/path context
+            std::mutex mutex;                 /// Serializes updates to the connection and its data contexts
             uint64_t last_stream_id{ 0 };     /// last stream Id
 
             bool mark_dgram_ready{ false }; /// Instructs datagram to be marked ready/active
 
             DataContextId next_data_ctx_id{ 1 }; /// Next data context ID; zero is reserved for default context
 
+            /// Stores and expires the pending objects of the datagram and all data context queues
+            std::shared_ptr<TimingWheel<ConnData>> tx_wheel;
+
             std::shared_ptr<PriorityQueue<ConnData>>
               dgram_tx_data; /// Datagram pending objects to be written to the network
 
@@ -144,12 +406,13 @@ namespace quicr {
                 }
             };
 
-            std::map<uint64_t, RxStreamBuffer> rx_stream_buffer; /// Map of stream receive buffers, key is stream_id
+            FlatHashMap<uint64_t, RxStreamBuffer> rx_stream_buffer; /// Map of stream receive buffers, key is stream_id
 
             /**
              * Active data contexts (streams bidir/unidir and datagram)
+             *      Pointer stable since picoquic holds the data context pointer as the stream context
              */
-            std::map<quicr::DataContextId, DataContext> active_data_contexts;
+            FlatHashMap<quicr::DataContextId, DataContext, true> active_data_contexts;
 
             char peer_addr_text[45]{ 0 };
             uint16_t peer_port{ 0 };
@@ -174,11 +437,92 @@ namespace quicr {
             }
         };
 
-        /*
-         * pq event loop member vars
+        using ConnectionTable = FlatHashMap<TransportConnId, std::shared_ptr<ConnectionContext>>;
+
+        /**
+         * Packet loop shard
+         *      Each shard runs its own picoquic context and packet loop thread. Connections are pinned to the
+         *      shard that accepted them and the shard index is encoded in the upper bits of the connection ID.
          */
-        uint64_t pq_loop_prev_time = 0;
-        uint64_t pq_loop_metrics_prev_time = 0;
+        struct Shard
+        {
+            PicoQuicTransport* transport{ nullptr }; /// Transport that owns the shard
+            size_t index{ 0 };                       /// Index of the shard in the transport shards
+            picoquic_quic_t* quic_ctx{ nullptr };    /// Picoquic context used by this shard
+            std::thread thread;                      /// Thread running the picoquic packet loop
+
+            /// Threads queue functions that picoquic will call via the pq_loop_cb call, see RunOnLoop()
+            TaskQueue<> runner_queue;
+
+            /// Wakes up the packet loop when work is queued, used by loops that wait on their own sockets
+            LoopWakeup wakeup;
+            bool event_wakeup{ false }; /// Packet loop is woken up by events instead of polling
+
+            /// Buffers for data received on connections in this shard, only acquired by the packet loop thread
+            BufferPool rx_buffer_pool{ 0, 0 };
+
+            /// Objects coalesced into one stream write by the packet loop thread, reused across callbacks
+            std::vector<ConnData> tx_coalesce;
+
+            /// Data context metrics copied by EmitMetrics() before they are passed to the delegate
+            std::vector<std::pair<DataContextId, QuicDataContextMetrics>> metrics_samples;
+
+            /// Stream waiting for rate limit tokens
+            struct PacedStream
+            {
+                uint64_t resume_us{ 0 }; /// Time the stream has enough tokens to send
+                TransportConnId conn_id{ 0 };
+                DataContextId data_ctx_id{ 0 };
+            };
+
+            /// Streams waiting for rate limit tokens, marked active by the packet loop thread at their resume time
+            std::vector<PacedStream> tx_paced;
+
+            /// Connections in this shard. Lookups do not lock, updates to a connection lock the connection mutex.
+            EpochPtr<ConnectionTable> conn_table;
+
+            /// Connection IDs of the picoquic connections in this shard, only used by the packet loop thread
+            FlatHashMap<picoquic_cnx_t*, TransportConnId> conn_ids;
+            uint64_t last_conn_seq{ 0 }; /// Sequence number of the last connection ID assigned by this shard
+
+            bool shutdown_complete{ false }; /// Connections in this shard have been closed on shutdown
+
+            /*
+             * pq event loop member vars
+             */
+            uint64_t pq_loop_prev_time{ 0 };
+            uint64_t pq_loop_metrics_prev_time{ 0 };
+
+            /**
+             * Queue a function to run on the packet loop thread and wake up the loop
+             *
+             * @details The function is never dropped. When the runner queue is full it's queued to the runner
+             *      queue overflow, which keeps loop work such as marking streams active and deleting data
+             *      contexts from being lost.
+             */
+            template<typename F>
+            void RunOnLoop(F&& fn)
+            {
+                if (!runner_queue.PushOrOverflow(std::forward<F>(fn)) && runner_queue.OverflowSize() == 1) {
+                    SPDLOG_LOGGER_WARN(
+                      transport->logger, "picoquic shard {0} runner queue is full, using overflow", index);
+                }
+
+                wakeup.Signal();
+            }
+        };
+
+        /**
+         * Callback notifier worker
+         *      Application callbacks for a connection are always run by the same worker. This keeps callbacks
+         *      in order per connection while callbacks for other connections run in parallel.
+         */
+        struct NotifyWorker
+        {
+            size_t index{ 0 };  /// Index of the worker in the notify workers
+            TaskQueue<> queue;  /// Pending callbacks to run
+            std::thread thread; /// Thread that runs the callbacks
+        };
 
         /*
          * Exceptions
@@ -238,11 +582,27 @@ namespace quicr {
                                uint32_t delay_ms,
                                EnqueueFlags flags) override;
 
+        TransportError EnqueueBatch(const TransportConnId& conn_id,
+                                    const DataContextId& data_ctx_id,
+                                    std::span<EnqueueObject> objects) override;
+
         std::shared_ptr<const std::vector<uint8_t>> Dequeue(TransportConnId conn_id,
                                                             std::optional<DataContextId> data_ctx_id) override;
 
         std::shared_ptr<StreamRxContext> GetStreamRxContext(TransportConnId conn_id, uint64_t stream_id) override;
 
+        void SetDataCtxTxBudget(TransportConnId conn_id,
+                                DataContextId data_ctx_id,
+                                uint64_t max_bytes,
+                                uint32_t max_objects) override;
+
+        void SetDataCtxQuantum(TransportConnId conn_id, DataContextId data_ctx_id, uint32_t quantum) override;
+
+        void SetDataCtxRateLimit(TransportConnId conn_id,
+                                 DataContextId data_ctx_id,
+                                 uint64_t rate_bps,
+                                 uint32_t burst_bytes) override;
+
         void SetRemoteDataCtxId(TransportConnId conn_id,
                                 DataContextId data_ctx_id,
                                 DataContextId remote_data_ctx_id) override;
@@ -253,9 +613,47 @@ namespace quicr {
         /*
          * Internal public methods
          */
+
+        /**
+         * @brief Get the connection context without holding a read guard
+         *
+         * @details Only safe to use on the packet loop thread of the connection shard. Removed connections
+         *      are reclaimed by that thread, so the context remains valid until the caller returns to the loop.
+         */
         ConnectionContext* GetConnContext(const TransportConnId& conn_id);
         void SetStatus(TransportStatus status);
 
+        /**
+         * @brief Get the shard that owns the connection
+         *
+         * @param conn_id           Connection ID, which has the shard index in the upper bits
+         *
+         * @returns Shard reference; unknown connection IDs map to a shard that does not have the connection
+         */
+        Shard& GetShard(TransportConnId conn_id);
+
+        /**
+         * @brief Get the connection ID for a picoquic connection
+         *
+         * @details The first call for a connection assigns it the next sequence number of the shard. Only safe
+         *      to call on the packet loop thread of the shard, or before the loop is started.
+         *
+         * @param shard             Shard that runs the connection
+         * @param pq_cnx            Picoquic connection
+         *
+         * @returns Connection ID that is the shard sequence number with the shard index in the upper bits
+         */
+        static TransportConnId MakeConnId(Shard& shard, picoquic_cnx_t* pq_cnx);
+
+        /**
+         * @brief Get the callback notifier worker for the connection
+         *
+         * @param conn_id           Connection ID
+         *
+         * @returns Notify worker that runs all callbacks for the connection
+         */
+        NotifyWorker& GetNotifyWorker(TransportConnId conn_id);
+
         /**
          * @brief Create bidirectional data context for received new stream
          *
@@ -269,7 +667,7 @@ namespace quicr {
          */
         DataContext* CreateDataContextBiDirRecv(TransportConnId conn_id, uint64_t stream_id);
 
-        ConnectionContext& CreateConnContext(picoquic_cnx_t* pq_cnx);
+        ConnectionContext& CreateConnContext(Shard& shard, picoquic_cnx_t* pq_cnx);
 
         void SendNextDatagram(ConnectionContext* conn_ctx, uint8_t* bytes_ctx, size_t max_len);
         void SendStreamBytes(DataContext* data_ctx, uint8_t* bytes_ctx, size_t max_len);
@@ -283,9 +681,17 @@ namespace quicr {
                                uint64_t stream_id,
                                std::span<const uint8_t> bytes);
 
-        void CheckConnsForCongestion();
-        void EmitMetrics();
-        void RemoveClosedStreams();
+        void CheckConnsForCongestion(Shard& shard);
+        void EmitMetrics(Shard& shard);
+        void RemoveClosedStreams(Shard& shard);
+
+        /**
+         * @brief Mark the streams active that waited for rate limit tokens and now have them
+         *
+         * @param shard             Shard of the packet loop thread
+         * @param delta_t[in,out]   Microseconds the loop waits, lowered to the next resume time
+         */
+        void ResumePacedStreams(Shard& shard, int64_t& delta_t);
 
         bool StreamActionCheck(DataContext* data_ctx, StreamAction stream_action);
 
@@ -294,9 +700,9 @@ namespace quicr {
          *
          * @details Function runs the picoquic specific functions in the same thread that runs the
          *      the event loop. This allows picoquic to be thread safe.  All picoquic functions that
-         *      other threads want to call should queue those in `picoquic_runner_queue`.
+         *      other threads want to call should queue those in the shard `runner_queue`.
          */
-        void PqRunner();
+        void PqRunner(Shard& shard);
 
         /*
          * Internal Public Variables
@@ -310,12 +716,91 @@ namespace quicr {
         TransportConnId CreateClient();
         void Shutdown();
 
-        void Server();
+        /**
+         * @brief Create and configure the picoquic context for a shard
+         */
+        void CreateQuicContext(Shard& shard);
+
+        void Server(Shard& shard);
         void Client(TransportConnId conn_id);
-        void CbNotifier();
+        void CbNotifier(NotifyWorker& worker);
+
+        /**
+         * @brief Packet loop using a single UDP socket
+         *
+         * @details Runs the same pq_loop_cb processing as the picoquic packet loop. The loop blocks until the
+         *      next picoquic timer, a received packet or the shard wakeup is signaled when work is queued
+         *      by other threads. SO_REUSEPORT is set when running more than one shard so that the kernel
+         *      spreads flows across the shards.
+         *
+         * @param shard         Shard to run the loop for
+         * @param family        Address family of the socket, AF_INET6 sockets are dual stack
+         * @param port          Local port to bind, zero for an ephemeral port
+         *
+         * @returns picoquic return code, PICOQUIC_NO_ERROR_TERMINATE_PACKET_LOOP on normal termination
+         */
+        int SocketPacketLoop(Shard& shard, int family, uint16_t port);
+
+        /**
+         * @brief Packet loop using batched UDP I/O
+         *
+         * @details Sends and receives with recvmmsg/sendmmsg and UDP GSO/GRO when the kernel supports them,
+         *      see UdpBatchSocket. Used instead of SocketPacketLoop() when TransportConfig::use_batch_io is
+         *      set and the platform supports it. Wakes up the same way as SocketPacketLoop(). Returns an error
+         *      without running on platforms other than Linux.
+         *
+         * @param shard         Shard to run the loop for
+         * @param family        Address family of the socket, AF_INET6 sockets are dual stack
+         * @param port          Local port to bind, zero for an ephemeral port
+         *
+         * @returns picoquic return code, PICOQUIC_NO_ERROR_TERMINATE_PACKET_LOOP on normal termination
+         */
+        int BatchPacketLoop(Shard& shard, int family, uint16_t port);
+
+        /**
+         * @brief Handle a packet that failed to send
+         *
+         * @details Notifies picoquic when the error means the peer is unreachable, the same way as the
+         *      picoquic packet loop, so that the path or connection is abandoned instead of timing out.
+         *
+         * @param shard         Shard that sent the packet
+         * @param pq_cnx        Connection that prepared the packet, nullptr if unknown
+         * @param peer_addr     Address the packet was sent to
+         * @param local_addr    Address the packet was sent from
+         * @param if_index      Interface the packet was sent from
+         * @param sock_err      errno value of the failed send
+         */
+        void OnSendError(Shard& shard,
+                         picoquic_cnx_t* pq_cnx,
+                         sockaddr* peer_addr,
+                         sockaddr* local_addr,
+                         int if_index,
+                         int sock_err);
 
         void CheckCallbackDelta(DataContext* data_ctx, bool tx = true);
 
+        /**
+         * @brief Notify backpressure after Enqueue refused objects of the data context due to its budget
+         *
+         * @details Run by the packet loop, which makes all backpressure and drained notifications of the data
+         *      context in order. Drained is notified right after if the queue drained in the meantime.
+         */
+        void SetTxBackpressure(TransportConnId conn_id, DataContextId data_ctx_id);
+
+        /**
+         * @brief Notify that the TX queue has drained if backpressure was notified, run by the packet loop
+         */
+        void CheckTxDrained(DataContext& data_ctx);
+
+        /**
+         * @brief Check if a rate limited stream has to wait for tokens before it sends
+         *
+         * @details A stream that has to wait is resumed by the packet loop when it has the tokens
+         *
+         * @returns True if the stream has to wait
+         */
+        bool WaitForTxTokens(DataContext& data_ctx);
+
         /**
          * @brief Mark a stream active
          * @details This method MUST only be called within the picoquic thread. Enqueue and other
@@ -353,24 +838,19 @@ namespace quicr {
          * Variables
          */
         picoquic_quic_config_t config_;
-        picoquic_quic_t* quic_ctx_;
         picoquic_tp_t local_tp_options_;
-        SafeQueue<std::function<void()>> cbNotifyQueue_;
-
-        SafeQueue<std::function<void()>>
-          picoquic_runner_queue_; /// Threads queue functions that picoquic will call via the pq_loop_cb call
-
         std::atomic<bool> stop_;
-        std::mutex state_mutex_; /// Used for stream/context/state updates
         std::atomic<TransportStatus> transportStatus_;
-        std::thread picoQuicThread_;
-        std::thread cbNotifyThread_;
+
+        std::vector<std::unique_ptr<NotifyWorker>> notify_workers_; /// Callback notifier workers
+
+        std::vector<std::unique_ptr<Shard>> shards_; /// Packet loop shards, client mode has only one
+        std::atomic<size_t> running_shards_{ 0 };    /// Number of shard packet loops still running
 
         TransportRemote serverInfo_;
         TransportDelegate& delegate_;
         TransportConfig tconfig_;
 
-        std::map<TransportConnId, ConnectionContext> conn_context_;
         std::shared_ptr<TickService> tick_service_;
     };
 
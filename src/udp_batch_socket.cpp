@@ -0,0 +1,476 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "quicr/detail/udp_batch_socket.h"
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__)
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <unistd.h>
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+#endif
+
+namespace quicr {
+
+#if defined(__linux__)
+    namespace {
+        constexpr int kSocketBufferSize = 2'000'000;
+
+        /// Control buffer large enough for packet info, ECN and GSO/GRO control messages
+        constexpr std::size_t kControlSize = 256;
+
+        socklen_t AddrLength(const sockaddr* addr)
+        {
+            return addr->sa_family == AF_INET6 ? sizeof(sockaddr_in6) : sizeof(sockaddr_in);
+        }
+    }
+
+    struct UdpBatchSocket::MessageBatch
+    {
+        explicit MessageBatch(std::size_t buffer_size)
+          : buffer_size(buffer_size)
+          , buffers(buffer_size * kBatchSize)
+        {
+        }
+
+        uint8_t* Buffer(std::size_t index) { return buffers.data() + index * buffer_size; }
+
+        std::size_t buffer_size;
+        std::vector<uint8_t> buffers;
+        std::array<mmsghdr, kBatchSize> msgs{};
+        std::array<iovec, kBatchSize> iovs{};
+        std::array<sockaddr_storage, kBatchSize> addrs{};
+        std::array<sockaddr_storage, kBatchSize> local_addrs{};
+        alignas(cmsghdr) std::array<std::array<uint8_t, kControlSize>, kBatchSize> controls{};
+        std::array<std::size_t, kBatchSize> segment_sizes{}; /// GSO segment size of queued message, zero if none
+        std::array<int, kBatchSize> if_indexes{};
+        std::array<void*, kBatchSize> contexts{};
+        std::size_t count{ 0 };
+    };
+
+    UdpBatchSocket::UdpBatchSocket(std::size_t max_packet_size, bool use_offload)
+      : max_packet_size_(max_packet_size)
+      , use_offload_(use_offload)
+    {
+    }
+
+    UdpBatchSocket::~UdpBatchSocket()
+    {
+        Close();
+    }
+
+    bool UdpBatchSocket::Supported() noexcept
+    {
+        return true;
+    }
+
+    int UdpBatchSocket::Open(int family, uint16_t port, bool reuse_port)
+    {
+        Close();
+
+        fd_ = socket(family, SOCK_DGRAM, IPPROTO_UDP);
+        if (fd_ < 0) {
+            return errno;
+        }
+
+        family_ = family;
+
+        int opt_enable = 1;
+        int opt_disable = 0;
+        int buffer_size = kSocketBufferSize;
+
+        if (reuse_port) {
+            (void)setsockopt(fd_, SOL_SOCKET, SO_REUSEPORT, &opt_enable, sizeof(opt_enable));
+        }
+        (void)setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+        (void)setsockopt(fd_, SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size));
+
+        // Local address and ECN of received packets, IPv4 options also apply to mapped addresses
+        (void)setsockopt(fd_, IPPROTO_IP, IP_PKTINFO, &opt_enable, sizeof(opt_enable));
+        (void)setsockopt(fd_, IPPROTO_IP, IP_RECVTOS, &opt_enable, sizeof(opt_enable));
+
+        sockaddr_storage bind_addr{};
+        if (family == AF_INET6) {
+            (void)setsockopt(fd_, IPPROTO_IPV6, IPV6_V6ONLY, &opt_disable, sizeof(opt_disable));
+            (void)setsockopt(fd_, IPPROTO_IPV6, IPV6_RECVPKTINFO, &opt_enable, sizeof(opt_enable));
+            (void)setsockopt(fd_, IPPROTO_IPV6, IPV6_RECVTCLASS, &opt_enable, sizeof(opt_enable));
+
+            auto* addr = reinterpret_cast<sockaddr_in6*>(&bind_addr);
+            addr->sin6_family = AF_INET6;
+            addr->sin6_addr = in6addr_any;
+            addr->sin6_port = htons(port);
+        } else {
+            auto* addr = reinterpret_cast<sockaddr_in*>(&bind_addr);
+            addr->sin_family = AF_INET;
+            addr->sin_addr.s_addr = INADDR_ANY;
+            addr->sin_port = htons(port);
+        }
+
+        const auto* bind_sa = reinterpret_cast<const sockaddr*>(&bind_addr);
+        if (bind(fd_, bind_sa, AddrLength(bind_sa)) != 0) {
+            const int err = errno;
+            Close();
+            return err;
+        }
+
+        sockaddr_storage local_addr{};
+        socklen_t local_addr_len = sizeof(local_addr);
+        (void)getsockname(fd_, reinterpret_cast<sockaddr*>(&local_addr), &local_addr_len);
+        local_port_ = reinterpret_cast<sockaddr_in*>(&local_addr)->sin_port; // Same offset for IPv6
+
+        if (use_offload_) {
+            // Check that the kernel supports GSO, segment size is set per message
+            int segment_size = static_cast<int>(max_packet_size_);
+            gso_enabled_ = setsockopt(fd_, SOL_UDP, UDP_SEGMENT, &segment_size, sizeof(segment_size)) == 0;
+            if (gso_enabled_) {
+                segment_size = 0;
+                (void)setsockopt(fd_, SOL_UDP, UDP_SEGMENT, &segment_size, sizeof(segment_size));
+            }
+
+            gro_enabled_ = setsockopt(fd_, SOL_UDP, UDP_GRO, &opt_enable, sizeof(opt_enable)) == 0;
+        }
+
+        rx_ = std::make_unique<MessageBatch>(gro_enabled_ ? kMaxGroSize : max_packet_size_);
+        tx_ = std::make_unique<MessageBatch>(gso_enabled_ ? max_packet_size_ * kMaxGsoSegments : max_packet_size_);
+        rx_packets_.reserve(kBatchSize);
+
+        return 0;
+    }
+
+    void UdpBatchSocket::Close()
+    {
+        if (fd_ >= 0) {
+            close(fd_);
+            fd_ = -1;
+        }
+
+        gso_enabled_ = false;
+        gro_enabled_ = false;
+    }
+
+    std::span<const UdpBatchSocket::Packet> UdpBatchSocket::Receive()
+    {
+        rx_packets_.clear();
+
+        for (std::size_t i = 0; i < kBatchSize; ++i) {
+            auto& hdr = rx_->msgs[i].msg_hdr;
+
+            rx_->iovs[i].iov_base = rx_->Buffer(i);
+            rx_->iovs[i].iov_len = rx_->buffer_size;
+
+            hdr.msg_name = &rx_->addrs[i];
+            hdr.msg_namelen = sizeof(sockaddr_storage);
+            hdr.msg_iov = &rx_->iovs[i];
+            hdr.msg_iovlen = 1;
+            hdr.msg_control = rx_->controls[i].data();
+            hdr.msg_controllen = kControlSize;
+            hdr.msg_flags = 0;
+        }
+
+        const int count = recvmmsg(fd_, rx_->msgs.data(), kBatchSize, MSG_DONTWAIT, nullptr);
+        stats_.rx_syscalls++;
+
+        if (count <= 0) {
+            return {};
+        }
+
+        for (std::size_t i = 0; i < static_cast<std::size_t>(count); ++i) {
+            auto& hdr = rx_->msgs[i].msg_hdr;
+            auto& local_addr = rx_->local_addrs[i];
+            int if_index = 0;
+            uint8_t ecn = 0;
+            std::size_t segment_size = 0;
+
+            local_addr.ss_family = AF_UNSPEC;
+
+            for (auto* cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+                if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO) {
+                    in_pktinfo info;
+                    std::memcpy(&info, CMSG_DATA(cmsg), sizeof(info));
+
+                    auto* addr = reinterpret_cast<sockaddr_in*>(&local_addr);
+                    addr->sin_family = AF_INET;
+                    addr->sin_addr = info.ipi_addr;
+                    addr->sin_port = local_port_;
+                    if_index = info.ipi_ifindex;
+
+                } else if (cmsg->cmsg_level == IPPROTO_IPV6 && cmsg->cmsg_type == IPV6_PKTINFO) {
+                    in6_pktinfo info;
+                    std::memcpy(&info, CMSG_DATA(cmsg), sizeof(info));
+
+                    auto* addr = reinterpret_cast<sockaddr_in6*>(&local_addr);
+                    *addr = {};
+                    addr->sin6_family = AF_INET6;
+                    addr->sin6_addr = info.ipi6_addr;
+                    addr->sin6_port = local_port_;
+                    if_index = static_cast<int>(info.ipi6_ifindex);
+
+                } else if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_TOS) {
+                    ecn = *CMSG_DATA(cmsg) & 0x03;
+
+                } else if (cmsg->cmsg_level == IPPROTO_IPV6 && cmsg->cmsg_type == IPV6_TCLASS) {
+                    int tclass;
+                    std::memcpy(&tclass, CMSG_DATA(cmsg), sizeof(tclass));
+                    ecn = static_cast<uint8_t>(tclass & 0x03);
+
+                } else if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+                    int gro_size;
+                    std::memcpy(&gro_size, CMSG_DATA(cmsg), sizeof(gro_size));
+                    segment_size = static_cast<std::size_t>(gro_size);
+                }
+            }
+
+            const std::size_t length = rx_->msgs[i].msg_len;
+            if (segment_size == 0) {
+                segment_size = length;
+            }
+
+            auto* data = rx_->Buffer(i);
+            for (std::size_t offset = 0; offset < length; offset += segment_size) {
+                rx_packets_.push_back({ { data + offset, std::min(segment_size, length - offset) },
+                                        &rx_->addrs[i],
+                                        &local_addr,
+                                        if_index,
+                                        ecn });
+            }
+        }
+
+        stats_.rx_packets += rx_packets_.size();
+
+        return rx_packets_;
+    }
+
+    std::span<uint8_t> UdpBatchSocket::SendBuffer()
+    {
+        if (tx_->count == kBatchSize) {
+            Flush();
+        }
+
+        // GSO can be turned off after the buffers were sized for it
+        return { tx_->Buffer(tx_->count), gso_enabled_ ? tx_->buffer_size : max_packet_size_ };
+    }
+
+    void UdpBatchSocket::QueueSend(std::size_t length,
+                                   std::size_t segment_size,
+                                   const sockaddr* peer_addr,
+                                   const sockaddr* local_addr,
+                                   int if_index,
+                                   void* context)
+    {
+        const auto i = tx_->count;
+        auto& hdr = tx_->msgs[i].msg_hdr;
+
+        tx_->if_indexes[i] = if_index;
+        tx_->contexts[i] = context;
+        tx_->local_addrs[i].ss_family = AF_UNSPEC;
+        if (local_addr != nullptr && local_addr->sa_family != AF_UNSPEC) {
+            std::memcpy(&tx_->local_addrs[i], local_addr, AddrLength(local_addr));
+        }
+
+        tx_->iovs[i].iov_base = tx_->Buffer(i);
+        tx_->iovs[i].iov_len = length;
+
+        std::memcpy(&tx_->addrs[i], peer_addr, AddrLength(peer_addr));
+
+        hdr = {};
+        hdr.msg_name = &tx_->addrs[i];
+        hdr.msg_namelen = AddrLength(peer_addr);
+        hdr.msg_iov = &tx_->iovs[i];
+        hdr.msg_iovlen = 1;
+        hdr.msg_control = tx_->controls[i].data();
+        hdr.msg_controllen = kControlSize;
+        tx_->controls[i].fill(0); // CMSG_NXTHDR reads the length of the next header
+
+        std::size_t control_len = 0;
+        auto* cmsg = CMSG_FIRSTHDR(&hdr);
+
+        // Send from the address the peer sent to
+        if (local_addr != nullptr && local_addr->sa_family == AF_INET) {
+            in_pktinfo info{};
+            info.ipi_spec_dst = reinterpret_cast<const sockaddr_in*>(local_addr)->sin_addr;
+            info.ipi_ifindex = if_index;
+
+            cmsg->cmsg_level = IPPROTO_IP;
+            cmsg->cmsg_type = IP_PKTINFO;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(info));
+            std::memcpy(CMSG_DATA(cmsg), &info, sizeof(info));
+            control_len += CMSG_SPACE(sizeof(info));
+            cmsg = CMSG_NXTHDR(&hdr, cmsg);
+
+        } else if (local_addr != nullptr && local_addr->sa_family == AF_INET6 && family_ == AF_INET6) {
+            in6_pktinfo info{};
+            info.ipi6_addr = reinterpret_cast<const sockaddr_in6*>(local_addr)->sin6_addr;
+            info.ipi6_ifindex = static_cast<unsigned int>(if_index);
+
+            cmsg->cmsg_level = IPPROTO_IPV6;
+            cmsg->cmsg_type = IPV6_PKTINFO;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(info));
+            std::memcpy(CMSG_DATA(cmsg), &info, sizeof(info));
+            control_len += CMSG_SPACE(sizeof(info));
+            cmsg = CMSG_NXTHDR(&hdr, cmsg);
+        }
+
+        // Segment size is the last control message so it can be dropped when resending without GSO
+        tx_->segment_sizes[i] = 0;
+        if (gso_enabled_ && segment_size > 0 && length > segment_size) {
+            const auto gso_size = static_cast<uint16_t>(segment_size);
+
+            cmsg->cmsg_level = SOL_UDP;
+            cmsg->cmsg_type = UDP_SEGMENT;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(gso_size));
+            std::memcpy(CMSG_DATA(cmsg), &gso_size, sizeof(gso_size));
+            control_len += CMSG_SPACE(sizeof(gso_size));
+            tx_->segment_sizes[i] = segment_size;
+        }
+
+        hdr.msg_controllen = control_len;
+        if (control_len == 0) {
+            hdr.msg_control = nullptr;
+        }
+
+        tx_->count++;
+    }
+
+    std::size_t UdpBatchSocket::Flush()
+    {
+        std::size_t packets = 0;
+        std::size_t i = 0;
+
+        while (i < tx_->count) {
+            const int sent = sendmmsg(fd_, &tx_->msgs[i], static_cast<unsigned int>(tx_->count - i), 0);
+            stats_.tx_syscalls++;
+
+            if (sent > 0) {
+                for (const auto end = i + static_cast<std::size_t>(sent); i < end; ++i) {
+                    const auto segment_size = tx_->segment_sizes[i];
+                    packets += segment_size ? (tx_->iovs[i].iov_len + segment_size - 1) / segment_size : 1;
+                }
+                continue;
+            }
+
+            const int err = errno;
+            if (err == EINTR) {
+                continue;
+            }
+
+            // Message i failed. EIO is returned when the device does not support segmentation offload
+            if (err == EIO && tx_->segment_sizes[i] > 0) {
+                gso_enabled_ = false;
+                packets += SendSegmented(i);
+            } else {
+                stats_.tx_errors++;
+                NotifySendError(i, err);
+            }
+            ++i;
+        }
+
+        tx_->count = 0;
+        stats_.tx_packets += packets;
+
+        return packets;
+    }
+
+    std::size_t UdpBatchSocket::SendSegmented(std::size_t index)
+    {
+        auto hdr = tx_->msgs[index].msg_hdr;
+        const auto segment_size = tx_->segment_sizes[index];
+        const auto* data = static_cast<const uint8_t*>(tx_->iovs[index].iov_base);
+        const auto length = tx_->iovs[index].iov_len;
+
+        // Drop the segment size control message, which is last
+        hdr.msg_controllen -= CMSG_SPACE(sizeof(uint16_t));
+        if (hdr.msg_controllen == 0) {
+            hdr.msg_control = nullptr;
+        }
+
+        std::size_t packets = 0;
+        for (std::size_t offset = 0; offset < length; offset += segment_size) {
+            iovec iov{ const_cast<uint8_t*>(data + offset), std::min(segment_size, length - offset) };
+            hdr.msg_iov = &iov;
+
+            stats_.tx_syscalls++;
+            if (sendmsg(fd_, &hdr, 0) >= 0) {
+                packets++;
+            } else {
+                stats_.tx_errors++;
+                NotifySendError(index, errno);
+            }
+        }
+
+        return packets;
+    }
+
+    void UdpBatchSocket::NotifySendError(std::size_t index, int error)
+    {
+        if (!send_error_handler_) {
+            return;
+        }
+
+        auto& local_addr = tx_->local_addrs[index];
+        send_error_handler_({ reinterpret_cast<sockaddr*>(&tx_->addrs[index]),
+                              local_addr.ss_family == AF_UNSPEC ? nullptr : reinterpret_cast<sockaddr*>(&local_addr),
+                              tx_->if_indexes[index],
+                              error,
+                              tx_->contexts[index] });
+    }
+
+#else
+    struct UdpBatchSocket::MessageBatch
+    {};
+
+    UdpBatchSocket::UdpBatchSocket(std::size_t max_packet_size, bool use_offload)
+      : max_packet_size_(max_packet_size)
+      , use_offload_(use_offload)
+    {
+    }
+
+    UdpBatchSocket::~UdpBatchSocket() = default;
+
+    bool UdpBatchSocket::Supported() noexcept
+    {
+        return false;
+    }
+
+    int UdpBatchSocket::Open(int, uint16_t, bool)
+    {
+        return ENOTSUP;
+    }
+
+    void UdpBatchSocket::Close() {}
+
+    std::span<const UdpBatchSocket::Packet> UdpBatchSocket::Receive()
+    {
+        return {};
+    }
+
+    std::span<uint8_t> UdpBatchSocket::SendBuffer()
+    {
+        return {};
+    }
+
+    void UdpBatchSocket::QueueSend(std::size_t, std::size_t, const sockaddr*, const sockaddr*, int, void*) {}
+
+    std::size_t UdpBatchSocket::Flush()
+    {
+        return 0;
+    }
+
+    std::size_t UdpBatchSocket::SendSegmented(std::size_t)
+    {
+        return 0;
+    }
+
+    void UdpBatchSocket::NotifySendError(std::size_t, int) {}
+#endif
+
+} // namespace quicr
@@ -0,0 +1,517 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "quicr/detail/uintvar_batch.h"
+#include "quicr/detail/uintvar.h"
+
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define QUICR_UINTVAR_X86
+#include <immintrin.h>
+#define QUICR_TARGET(isa) __attribute__((target(isa)))
+#elif defined(__aarch64__) && defined(__ARM_NEON) && defined(QUICR_UINTVAR_ENABLE_NEON)
+// Opt in with the QUICR_UINTVAR_NEON CMake option until the kernel has run on AArch64
+#define QUICR_UINTVAR_NEON
+#include <arm_neon.h>
+#endif
+
+namespace quicr {
+    namespace {
+        constexpr uint64_t kUintVarMax = (uint64_t{ 1 } << 62) - 1;
+
+        /**
+         * @brief Decode one uintvar
+         *
+         * @details Reads 8 bytes at once when available, so that decoding does not branch on the length.
+         *
+         * @returns Length of the uintvar, zero if the bytes end before it
+         */
+        inline std::size_t DecodeOne(const uint8_t* data, std::size_t remaining, uint64_t& value) noexcept
+        {
+            const std::size_t len = std::size_t{ 1 } << (data[0] >> 6);
+            if (remaining < len) {
+                return 0;
+            }
+
+            uint64_t be_value = 0;
+            if (remaining >= sizeof(uint64_t)) {
+                std::memcpy(&be_value, data, sizeof(uint64_t));
+                be_value = SwapBytes(be_value) >> (64 - 8 * len);
+            } else {
+                for (std::size_t i = 0; i < len; ++i) {
+                    be_value = (be_value << 8) | data[i];
+                }
+            }
+
+            value = be_value & (~uint64_t{ 0 } >> (66 - 8 * len)); // Clear the length bits
+            return len;
+        }
+
+        /**
+         * @brief Length code of the shortest encoding of the value, the length is 1 << code
+         */
+        inline unsigned LengthCode(uint64_t value) noexcept
+        {
+            return (value > 0x3F) + (value > 0x3FFF) + (value > 0x3FFF'FFFF);
+        }
+
+        /**
+         * @brief Encode one uintvar
+         *
+         * @details Writes 8 bytes at once when there is room, so that encoding does not branch on the length.
+         *
+         * @returns Length of the uintvar
+         */
+        inline std::size_t EncodeOne(uint64_t value, uint8_t* data, std::size_t remaining)
+        {
+            if (value > kUintVarMax) {
+                throw std::invalid_argument("Value greater than uintvar maximum");
+            }
+
+            const unsigned code = LengthCode(value);
+            const std::size_t len = std::size_t{ 1 } << code;
+            if (remaining < len) {
+                throw std::invalid_argument("Buffer too small for uintvars");
+            }
+
+            const uint64_t be_value = SwapBytes((value | (uint64_t{ code } << (8 * len - 2))) << (64 - 8 * len));
+            std::memcpy(data, &be_value, remaining >= sizeof(uint64_t) ? sizeof(uint64_t) : len);
+            return len;
+        }
+
+        std::optional<std::size_t> DecodeTail(std::span<const uint8_t> bytes,
+                                              std::span<uint64_t> values,
+                                              std::size_t pos,
+                                              std::size_t i) noexcept
+        {
+            for (; i < values.size(); ++i) {
+                if (pos >= bytes.size()) {
+                    return std::nullopt;
+                }
+
+                const auto len = DecodeOne(bytes.data() + pos, bytes.size() - pos, values[i]);
+                if (len == 0) {
+                    return std::nullopt;
+                }
+                pos += len;
+            }
+
+            return pos;
+        }
+
+        std::size_t EncodeTail(std::span<const uint64_t> values,
+                               std::span<uint8_t> bytes,
+                               std::size_t pos,
+                               std::size_t i)
+        {
+            for (; i < values.size(); ++i) {
+                pos += EncodeOne(values[i], bytes.data() + pos, bytes.size() - pos);
+            }
+
+            return pos;
+        }
+
+#if defined(QUICR_UINTVAR_X86) || defined(QUICR_UINTVAR_NEON)
+        /**
+         * @brief Byte shuffles and mask to decode or encode two consecutive uintvars from or to two 64 bit lanes
+         *
+         * @details Indexed by the length codes of the two uintvars, (code0 << 2) | code1. The decode shuffle
+         *      reverses the big endian bytes of each uintvar into its lane and the encode shuffle does the
+         *      opposite, out of range indices zero the byte. The mask clears the length bits when decoding.
+         */
+        struct PairShuffle
+        {
+            alignas(16) std::array<uint8_t, 16> decode;
+            alignas(16) std::array<uint8_t, 16> encode;
+            alignas(16) std::array<uint64_t, 2> mask;
+        };
+
+        constexpr std::array<PairShuffle, 16> MakePairShuffles()
+        {
+            std::array<PairShuffle, 16> shuffles{};
+            for (std::size_t index = 0; index < shuffles.size(); ++index) {
+                const std::size_t len0 = std::size_t{ 1 } << (index >> 2);
+                const std::size_t len1 = std::size_t{ 1 } << (index & 0x3);
+
+                shuffles[index].encode.fill(0x80);
+                for (std::size_t k = 0; k < 8; ++k) {
+                    shuffles[index].decode[k] = k < len0 ? static_cast<uint8_t>(len0 - 1 - k) : 0x80;
+                    shuffles[index].decode[8 + k] = k < len1 ? static_cast<uint8_t>(len0 + len1 - 1 - k) : 0x80;
+                }
+                for (std::size_t k = 0; k < len0; ++k) {
+                    shuffles[index].encode[k] = static_cast<uint8_t>(len0 - 1 - k);
+                }
+                for (std::size_t k = 0; k < len1; ++k) {
+                    shuffles[index].encode[len0 + k] = static_cast<uint8_t>(8 + len1 - 1 - k);
+                }
+                shuffles[index].mask = { ~uint64_t{ 0 } >> (66 - 8 * len0), ~uint64_t{ 0 } >> (66 - 8 * len1) };
+            }
+            return shuffles;
+        }
+
+        constexpr auto kPairShuffles = MakePairShuffles();
+
+        /**
+         * @brief Lengths and table entry of the two uintvars at the front of data, which has at least 16 bytes
+         */
+        inline const PairShuffle& PairAt(const uint8_t* data, std::size_t& len) noexcept
+        {
+            const unsigned code0 = data[0] >> 6;
+            const std::size_t len0 = std::size_t{ 1 } << code0;
+            const unsigned code1 = data[len0] >> 6;
+
+            len = len0 + (std::size_t{ 1 } << code1);
+            return kPairShuffles[(code0 << 2) | code1];
+        }
+
+        /**
+         * @brief Lengths, table entry and values with the length bits set of the two values to encode
+         */
+        inline const PairShuffle& PairOf(const uint64_t* values, uint64_t (&with_code)[2], std::size_t& len)
+        {
+            if ((values[0] | values[1]) > kUintVarMax) {
+                throw std::invalid_argument("Value greater than uintvar maximum");
+            }
+
+            const unsigned code0 = LengthCode(values[0]);
+            const unsigned code1 = LengthCode(values[1]);
+            const std::size_t len0 = std::size_t{ 1 } << code0;
+            const std::size_t len1 = std::size_t{ 1 } << code1;
+
+            with_code[0] = values[0] | (uint64_t{ code0 } << (8 * len0 - 2));
+            with_code[1] = values[1] | (uint64_t{ code1 } << (8 * len1 - 2));
+            len = len0 + len1;
+            return kPairShuffles[(code0 << 2) | code1];
+        }
+#endif
+
+#if defined(QUICR_UINTVAR_X86)
+        /**
+         * @brief Decode the two uintvars at the front of the 16 bytes
+         *
+         * @returns Length of the two uintvars
+         */
+        QUICR_TARGET("sse4.1")
+        inline std::size_t DecodePairSse(const uint8_t* data, __m128i bytes, uint64_t* out) noexcept
+        {
+            std::size_t len = 0;
+            const auto& pair = PairAt(data, len);
+
+            __m128i value =
+              _mm_shuffle_epi8(bytes, _mm_load_si128(reinterpret_cast<const __m128i*>(pair.decode.data())));
+            value = _mm_and_si128(value, _mm_load_si128(reinterpret_cast<const __m128i*>(pair.mask.data())));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), value);
+            return len;
+        }
+
+        /**
+         * @brief Encode two values into the front of the 16 bytes
+         *
+         * @returns Length of the two uintvars
+         */
+        QUICR_TARGET("sse4.1")
+        inline std::size_t EncodePairSse(const uint64_t* values, uint8_t* out)
+        {
+            uint64_t with_code[2];
+            std::size_t len = 0;
+            const auto& pair = PairOf(values, with_code, len);
+
+            const __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(with_code));
+            _mm_storeu_si128(
+              reinterpret_cast<__m128i*>(out),
+              _mm_shuffle_epi8(value, _mm_load_si128(reinterpret_cast<const __m128i*>(pair.encode.data()))));
+            return len;
+        }
+
+        /**
+         * @brief Bytes of the 16 bytes with any of the two length bits set, one bit per byte
+         */
+        QUICR_TARGET("sse4.1")
+        inline int LongBytesSse(__m128i bytes) noexcept
+        {
+            // Shifting 16 bit lanes by one moves bit 6 of each byte into bit 7 of the same byte
+            return _mm_movemask_epi8(_mm_or_si128(bytes, _mm_slli_epi16(bytes, 1)));
+        }
+
+        /**
+         * @brief Pack 16 values less than 64, two per register, into one byte each
+         */
+        QUICR_TARGET("sse4.1")
+        inline __m128i PackSmallSse(const __m128i (&values)[8]) noexcept
+        {
+            // Upper halves are zero, so each pack keeps the value and a zero until the last pack
+            const __m128i words0 = _mm_packus_epi16(_mm_packus_epi32(values[0], values[1]),
+                                                    _mm_packus_epi32(values[2], values[3]));
+            const __m128i words1 = _mm_packus_epi16(_mm_packus_epi32(values[4], values[5]),
+                                                    _mm_packus_epi32(values[6], values[7]));
+            return _mm_packus_epi16(words0, words1);
+        }
+
+        QUICR_TARGET("sse4.1")
+        std::optional<std::size_t> DecodeSse4(std::span<const uint8_t> bytes, std::span<uint64_t> values) noexcept
+        {
+            const uint8_t* data = bytes.data();
+            uint64_t* out = values.data();
+            std::size_t pos = 0;
+            std::size_t i = 0;
+
+            while (values.size() - i >= 2 && bytes.size() - pos >= 16) {
+                const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+
+                if (values.size() - i >= 16 && LongBytesSse(in) == 0) {
+                    // All 16 bytes are single byte uintvars
+                    __m128i run = in;
+                    for (std::size_t k = 0; k < 16; k += 2) {
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + k), _mm_cvtepu8_epi64(run));
+                        run = _mm_srli_si128(run, 2);
+                    }
+                    pos += 16;
+                    i += 16;
+                    continue;
+                }
+
+                pos += DecodePairSse(data + pos, in, out + i);
+                i += 2;
+            }
+
+            return DecodeTail(bytes, values, pos, i);
+        }
+
+        QUICR_TARGET("avx2")
+        std::optional<std::size_t> DecodeAvx2(std::span<const uint8_t> bytes, std::span<uint64_t> values) noexcept
+        {
+            const uint8_t* data = bytes.data();
+            uint64_t* out = values.data();
+            std::size_t pos = 0;
+            std::size_t i = 0;
+
+            while (values.size() - i >= 2 && bytes.size() - pos >= 16) {
+                const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+
+                if (values.size() - i >= 16 && LongBytesSse(in) == 0) {
+                    // All 16 bytes are single byte uintvars, widen the next 16 as well if they are too
+                    __m128i run = in;
+                    std::size_t run_len = 16;
+                    if (values.size() - i >= 32 && bytes.size() - pos >= 32) {
+                        const __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos + 16));
+                        if (LongBytesSse(next) == 0) {
+                            __m128i next_run = next;
+                            for (std::size_t k = 16; k < 32; k += 4) {
+                                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + k),
+                                                    _mm256_cvtepu8_epi64(next_run));
+                                next_run = _mm_srli_si128(next_run, 4);
+                            }
+                            run_len = 32;
+                        }
+                    }
+
+                    for (std::size_t k = 0; k < 16; k += 4) {
+                        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + k), _mm256_cvtepu8_epi64(run));
+                        run = _mm_srli_si128(run, 4);
+                    }
+                    pos += run_len;
+                    i += run_len;
+                    continue;
+                }
+
+                pos += DecodePairSse(data + pos, in, out + i);
+                i += 2;
+            }
+
+            return DecodeTail(bytes, values, pos, i);
+        }
+
+        QUICR_TARGET("sse4.1")
+        std::size_t EncodeSse4(std::span<const uint64_t> values, std::span<uint8_t> bytes)
+        {
+            const __m128i long_mask = _mm_set1_epi64x(~int64_t{ 0x3F });
+            std::size_t pos = 0;
+            std::size_t i = 0;
+
+            while (values.size() - i >= 16 && bytes.size() - pos >= 16) {
+                __m128i in[8];
+                __m128i any = _mm_setzero_si128();
+                for (std::size_t k = 0; k < 8; ++k) {
+                    in[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values.data() + i + 2 * k));
+                    any = _mm_or_si128(any, in[k]);
+                }
+
+                if (!_mm_testz_si128(any, long_mask)) {
+                    // Mixed lengths, encode two values at a time
+                    for (const auto end = i + 16; i < end && bytes.size() - pos >= 16; i += 2) {
+                        pos += EncodePairSse(values.data() + i, bytes.data() + pos);
+                    }
+                    continue;
+                }
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes.data() + pos), PackSmallSse(in));
+                pos += 16;
+                i += 16;
+            }
+
+            return EncodeTail(values, bytes, pos, i);
+        }
+#endif
+
+#if defined(QUICR_UINTVAR_NEON)
+        std::optional<std::size_t> DecodeNeon(std::span<const uint8_t> bytes, std::span<uint64_t> values) noexcept
+        {
+            const uint8_t* data = bytes.data();
+            uint64_t* out = values.data();
+            std::size_t pos = 0;
+            std::size_t i = 0;
+
+            while (values.size() - i >= 2 && bytes.size() - pos >= 16) {
+                const uint8x16_t in = vld1q_u8(data + pos);
+
+                if (values.size() - i >= 16 && vmaxvq_u8(in) <= 0x3F) {
+                    // All 16 bytes are single byte uintvars
+                    const uint16x8_t halves[2] = { vmovl_u8(vget_low_u8(in)), vmovl_high_u8(in) };
+                    for (std::size_t k = 0; k < 2; ++k) {
+                        const uint32x4_t low = vmovl_u16(vget_low_u16(halves[k]));
+                        const uint32x4_t high = vmovl_high_u16(halves[k]);
+                        vst1q_u64(out + i + 8 * k, vmovl_u32(vget_low_u32(low)));
+                        vst1q_u64(out + i + 8 * k + 2, vmovl_high_u32(low));
+                        vst1q_u64(out + i + 8 * k + 4, vmovl_u32(vget_low_u32(high)));
+                        vst1q_u64(out + i + 8 * k + 6, vmovl_high_u32(high));
+                    }
+                    pos += 16;
+                    i += 16;
+                    continue;
+                }
+
+                std::size_t len = 0;
+                const auto& pair = PairAt(data + pos, len);
+                const uint8x16_t value = vqtbl1q_u8(in, vld1q_u8(pair.decode.data()));
+                vst1q_u64(out + i, vandq_u64(vreinterpretq_u64_u8(value), vld1q_u64(pair.mask.data())));
+                pos += len;
+                i += 2;
+            }
+
+            return DecodeTail(bytes, values, pos, i);
+        }
+
+        std::size_t EncodeNeon(std::span<const uint64_t> values, std::span<uint8_t> bytes)
+        {
+            std::size_t pos = 0;
+            std::size_t i = 0;
+
+            while (values.size() - i >= 16 && bytes.size() - pos >= 16) {
+                uint64x2_t in[8];
+                uint64x2_t any = vdupq_n_u64(0);
+                for (std::size_t k = 0; k < 8; ++k) {
+                    in[k] = vld1q_u64(values.data() + i + 2 * k);
+                    any = vorrq_u64(any, in[k]);
+                }
+
+                if ((vgetq_lane_u64(any, 0) | vgetq_lane_u64(any, 1)) > 0x3F) {
+                    // Mixed lengths, encode two values at a time
+                    for (const auto end = i + 16; i < end && bytes.size() - pos >= 16; i += 2) {
+                        uint64_t with_code[2];
+                        std::size_t len = 0;
+                        const auto& pair = PairOf(values.data() + i, with_code, len);
+                        vst1q_u8(bytes.data() + pos,
+                                 vqtbl1q_u8(vreinterpretq_u8_u64(vld1q_u64(with_code)), vld1q_u8(pair.encode.data())));
+                        pos += len;
+                    }
+                    continue;
+                }
+
+                const uint16x8_t low = vcombine_u16(vmovn_u32(vcombine_u32(vmovn_u64(in[0]), vmovn_u64(in[1]))),
+                                                    vmovn_u32(vcombine_u32(vmovn_u64(in[2]), vmovn_u64(in[3]))));
+                const uint16x8_t high = vcombine_u16(vmovn_u32(vcombine_u32(vmovn_u64(in[4]), vmovn_u64(in[5]))),
+                                                     vmovn_u32(vcombine_u32(vmovn_u64(in[6]), vmovn_u64(in[7]))));
+                vst1q_u8(bytes.data() + pos, vcombine_u8(vmovn_u16(low), vmovn_u16(high)));
+                pos += 16;
+                i += 16;
+            }
+
+            return EncodeTail(values, bytes, pos, i);
+        }
+#endif
+
+        UintVarKernel SupportedOrScalar(UintVarKernel kernel) noexcept
+        {
+            if (kernel == SelectedUintVarKernel() || UintVarKernelSupported(kernel)) {
+                return kernel;
+            }
+            return UintVarKernel::kScalar;
+        }
+    }
+
+    bool UintVarKernelSupported(UintVarKernel kernel) noexcept
+    {
+        switch (kernel) {
+            case UintVarKernel::kScalar:
+                return true;
+#if defined(QUICR_UINTVAR_X86)
+            case UintVarKernel::kSse4:
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("sse4.1");
+            case UintVarKernel::kAvx2:
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx2");
+#endif
+#if defined(QUICR_UINTVAR_NEON)
+            case UintVarKernel::kNeon:
+                return true;
+#endif
+            default:
+                return false;
+        }
+    }
+
+    UintVarKernel SelectedUintVarKernel() noexcept
+    {
+        static const UintVarKernel selected = [] {
+            for (const auto kernel : { UintVarKernel::kAvx2, UintVarKernel::kSse4, UintVarKernel::kNeon }) {
+                if (UintVarKernelSupported(kernel)) {
+                    return kernel;
+                }
+            }
+            return UintVarKernel::kScalar;
+        }();
+
+        return selected;
+    }
+
+    std::optional<std::size_t> DecodeUintVars(UintVarKernel kernel,
+                                              std::span<const uint8_t> bytes,
+                                              std::span<uint64_t> values) noexcept
+    {
+        switch (SupportedOrScalar(kernel)) {
+#if defined(QUICR_UINTVAR_X86)
+            case UintVarKernel::kSse4:
+                return DecodeSse4(bytes, values);
+            case UintVarKernel::kAvx2:
+                return DecodeAvx2(bytes, values);
+#endif
+#if defined(QUICR_UINTVAR_NEON)
+            case UintVarKernel::kNeon:
+                return DecodeNeon(bytes, values);
+#endif
+            default:
+                return DecodeTail(bytes, values, 0, 0);
+        }
+    }
+
+    std::size_t EncodeUintVars(UintVarKernel kernel, std::span<const uint64_t> values, std::span<uint8_t> bytes)
+    {
+        switch (SupportedOrScalar(kernel)) {
+#if defined(QUICR_UINTVAR_X86)
+            case UintVarKernel::kSse4:
+            case UintVarKernel::kAvx2: // Wider registers do not help narrowing values to bytes
+                return EncodeSse4(values, bytes);
+#endif
+#if defined(QUICR_UINTVAR_NEON)
+            case UintVarKernel::kNeon:
+                return EncodeNeon(values, bytes);
+#endif
+            default:
+                return EncodeTail(values, bytes, 0, 0);
+        }
+    }
+}
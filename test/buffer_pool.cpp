@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <doctest/doctest.h>
+
+#include "quicr/detail/buffer_pool.h"
+
+#include <thread>
+#include <vector>
+
+TEST_CASE("BufferPool copies bytes")
+{
+    quicr::BufferPool pool(4, 16);
+    const std::vector<uint8_t> bytes{ 1, 2, 3, 4, 5 };
+
+    auto [buffer, pooled] = pool.Acquire(bytes);
+
+    // First use of a slot allocates its buffer
+    CHECK_FALSE(pooled);
+    CHECK_EQ(*buffer, bytes);
+    CHECK_GE(buffer->capacity(), 16);
+}
+
+TEST_CASE("BufferPool reuses released buffers")
+{
+    quicr::BufferPool pool(2, 16);
+    const std::vector<uint8_t> bytes{ 1, 2, 3 };
+
+    const auto* first = pool.Acquire(bytes).first.get();
+    const auto* second = pool.Acquire(bytes).first.get();
+    CHECK_NE(first, second);
+
+    // Both buffers were released when the callers dropped them, round-robin gives the first one back
+    auto [buffer, pooled] = pool.Acquire(std::vector<uint8_t>{ 7, 8 });
+    CHECK(pooled);
+    CHECK_EQ(buffer.get(), first);
+
+    const std::vector<uint8_t> expected{ 7, 8 };
+    CHECK_EQ(*buffer, expected);
+}
+
+TEST_CASE("BufferPool skips buffers that are in use")
+{
+    quicr::BufferPool pool(2, 16);
+    const std::vector<uint8_t> bytes{ 1, 2, 3 };
+
+    auto held = pool.Acquire(bytes).first;
+    const auto* second = pool.Acquire(bytes).first.get();
+
+    auto [buffer, pooled] = pool.Acquire(bytes);
+    CHECK(pooled);
+    CHECK_EQ(buffer.get(), second);
+    CHECK_NE(buffer.get(), held.get());
+}
+
+TEST_CASE("BufferPool allocates when exhausted")
+{
+    quicr::BufferPool pool(4, 16);
+    const std::vector<uint8_t> bytes{ 1, 2, 3 };
+
+    std::vector<quicr::BufferPool::BufferType> held;
+    for (std::size_t i = 0; i < pool.Size(); ++i) {
+        held.push_back(pool.Acquire(bytes).first);
+    }
+
+    auto [buffer, pooled] = pool.Acquire(bytes);
+    CHECK_FALSE(pooled);
+    CHECK_EQ(*buffer, bytes);
+    for (const auto& h : held) {
+        CHECK_NE(buffer.get(), h.get());
+    }
+
+    // Releasing one pooled buffer makes it available again
+    const auto* released = held.back().get();
+    held.pop_back();
+
+    auto [reused, reused_pooled] = pool.Acquire(bytes);
+    CHECK(reused_pooled);
+    CHECK_EQ(reused.get(), released);
+}
+
+TEST_CASE("BufferPool does not pool large or disabled buffers")
+{
+    quicr::BufferPool pool(2, 4);
+    const std::vector<uint8_t> large(5, 1);
+
+    auto [buffer, pooled] = pool.Acquire(large);
+    CHECK_FALSE(pooled);
+    CHECK_EQ(*buffer, large);
+
+    quicr::BufferPool disabled(0, 16);
+    CHECK_EQ(disabled.Size(), 0);
+
+    auto [unpooled, disabled_pooled] = disabled.Acquire(large);
+    CHECK_FALSE(disabled_pooled);
+    CHECK_EQ(*unpooled, large);
+}
+
+TEST_CASE("BufferPool buffers released by other threads")
+{
+    quicr::BufferPool pool(8, 64);
+
+    for (int round = 0; round < 1000; ++round) {
+        std::vector<quicr::BufferPool::BufferType> buffers;
+        for (int i = 0; i < 4; ++i) {
+            buffers.push_back(pool.Acquire(std::vector<uint8_t>(32, static_cast<uint8_t>(round))).first);
+        }
+
+        // Consumer checks and drops the buffers while the pool hands out others
+        std::thread consumer([buffers = std::move(buffers), round]() mutable {
+            for (auto& buffer : buffers) {
+                CHECK_EQ(buffer->front(), static_cast<uint8_t>(round));
+                buffer.reset();
+            }
+        });
+
+        pool.Acquire(std::vector<uint8_t>(32, 0xff));
+        consumer.join();
+    }
+}
@@ -5,27 +5,20 @@
 
 #include <quicr/cache.h>
 
-using namespace quicr;
-
-struct MockTickService : TickService
-{
-    void SetCurrentDuration(const DurationType duration) { milliseconds_ = duration; }
-    TickType Milliseconds() const override { return milliseconds_.count(); }
-    TickType Microseconds() const override { return milliseconds_.count() * 1000; }
+#include "manual_tick_service.h"
 
-  private:
-    DurationType milliseconds_ = DurationType(0);
-};
+using namespace quicr;
+using test::ManualTickService;
 
 TEST_SUITE("Cache")
 {
     TEST_CASE("Cache Retrieval")
     {
         // Should be able to find objects that have been inserted.
-        auto time = std::make_shared<MockTickService>();
+        auto time = std::make_shared<ManualTickService>();
         typedef std::uint64_t Key;
         typedef std::vector<std::uint64_t> Value;
-        auto cache = Cache<Key, Value>(1000, 100, std::make_shared<MockTickService>());
+        auto cache = Cache<Key, Value>(1000, 100, std::make_shared<ManualTickService>());
         constexpr Key target_key = 0;
         Value expected = { 0, 1 };
         cache.Insert(target_key, expected, 1000);
@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <doctest/doctest.h>
+
+#include "quicr/detail/epoch_ptr.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <thread>
+#include <vector>
+
+TEST_CASE("EpochPtr Update")
+{
+    quicr::EpochPtr<std::map<int, int>> table;
+
+    CHECK(table.Read()->empty());
+
+    table.Update([](auto& map) { map[1] = 10; });
+    table.Update([](auto& map) { map[2] = 20; });
+
+    const auto map = table.Read();
+    CHECK_EQ(map->size(), 2);
+    CHECK_EQ(map->at(1), 10);
+    CHECK_EQ(map->at(2), 20);
+}
+
+TEST_CASE("EpochPtr Reclaim")
+{
+    quicr::EpochPtr<std::map<int, int>> table;
+
+    table.Update([](auto& map) { map[1] = 10; });
+    CHECK_EQ(table.RetiredSize(), 1);
+
+    // Retired value is freed on the second reclaim after it was retired
+    CHECK_EQ(table.Reclaim(), 0);
+    CHECK_EQ(table.Reclaim(), 1);
+    CHECK_EQ(table.RetiredSize(), 0);
+}
+
+TEST_CASE("EpochPtr Reader holds back reclaim")
+{
+    quicr::EpochPtr<std::map<int, int>> table;
+
+    {
+        const auto map = table.Read();
+        table.Update([](auto& m) { m[1] = 10; });
+
+        // Reader still sees the value from before the update
+        CHECK(map->empty());
+
+        table.Reclaim();
+        table.Reclaim();
+        CHECK_EQ(table.RetiredSize(), 1);
+    }
+
+    table.Reclaim();
+    CHECK_EQ(table.RetiredSize(), 0);
+}
+
+TEST_CASE("EpochPtr Concurrent readers")
+{
+    quicr::EpochPtr<std::vector<int>> values(std::make_unique<std::vector<int>>(100, 0));
+    std::atomic<bool> stop{ false };
+    std::atomic<int> bad_reads{ 0 };
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            while (!stop) {
+                const auto v = values.Read();
+
+                // All elements are the same value when the update is published
+                for (const auto value : *v) {
+                    if (value != v->front()) {
+                        bad_reads++;
+                    }
+                }
+            }
+        });
+    }
+
+    for (int i = 1; i <= 1000; ++i) {
+        values.Update([i](auto& v) { std::fill(v.begin(), v.end(), i); });
+        values.Reclaim();
+    }
+
+    stop = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    CHECK_EQ(bad_reads, 0);
+    CHECK_EQ(values.Read()->front(), 1000);
+}
@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <doctest/doctest.h>
+
+#include "quicr/detail/flat_hash_map.h"
+
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+
+TEST_CASE("FlatHashMap insert, find and erase")
+{
+    quicr::FlatHashMap<uint64_t, std::string> map;
+
+    CHECK(map.empty());
+    CHECK(map.find(1) == map.end());
+
+    auto [it, is_new] = map.try_emplace(1, "one");
+    CHECK(is_new);
+    CHECK_EQ(it->first, 1);
+    CHECK_EQ(it->second, "one");
+
+    auto [it2, is_new2] = map.emplace(1, "uno");
+    CHECK_FALSE(is_new2);
+    CHECK_EQ(it2->second, "one");
+
+    map[2] = "two";
+    CHECK_EQ(map.size(), 2);
+    CHECK_EQ(map.at(2), "two");
+    CHECK(map.contains(2));
+
+    CHECK_EQ(map.erase(1), 1);
+    CHECK_EQ(map.erase(1), 0);
+    CHECK(map.find(1) == map.end());
+    CHECK_EQ(map.size(), 1);
+
+    map.clear();
+    CHECK(map.empty());
+    CHECK(map.find(2) == map.end());
+}
+
+TEST_CASE("FlatHashMap matches std::map")
+{
+    quicr::FlatHashMap<uint64_t, uint64_t> map;
+    std::map<uint64_t, uint64_t> expected;
+    std::mt19937_64 rng(1);
+
+    // Small key range so that keys are erased and reinserted over tombstones
+    for (int i = 0; i < 100'000; ++i) {
+        const auto key = rng() % 512;
+        if (rng() % 3 == 0) {
+            CHECK_EQ(map.erase(key), expected.erase(key));
+        } else {
+            map[key] = i;
+            expected[key] = i;
+        }
+    }
+
+    CHECK_EQ(map.size(), expected.size());
+
+    std::size_t count = 0;
+    for (const auto& [key, value] : map) {
+        CHECK_EQ(expected.at(key), value);
+        ++count;
+    }
+    CHECK_EQ(count, expected.size());
+}
+
+TEST_CASE("FlatHashMap erase while iterating")
+{
+    quicr::FlatHashMap<uint64_t, int> map;
+    for (int i = 0; i < 100; ++i) {
+        map[static_cast<uint64_t>(i) << 56] = i;
+    }
+
+    for (auto it = map.begin(); it != map.end();) {
+        if (it->second % 2 == 0) {
+            it = map.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    CHECK_EQ(map.size(), 50);
+    for (const auto& [key, value] : map) {
+        CHECK(value % 2 == 1);
+    }
+}
+
+TEST_CASE("FlatHashMap pointer stable")
+{
+    quicr::FlatHashMap<uint64_t, std::unique_ptr<int>, true> map;
+
+    auto& first = map[0];
+    first = std::make_unique<int>(10);
+
+    for (uint64_t i = 1; i < 1000; ++i) {
+        map.try_emplace(i, std::make_unique<int>(static_cast<int>(i)));
+    }
+
+    CHECK_EQ(&first, &map[0]);
+    CHECK_EQ(*first, 10);
+}
+
+TEST_CASE("FlatHashMap copy")
+{
+    quicr::FlatHashMap<uint64_t, std::shared_ptr<int>> map;
+    map[1] = std::make_shared<int>(1);
+
+    auto copy = map;
+    copy[2] = std::make_shared<int>(2);
+
+    CHECK_EQ(map.size(), 1);
+    CHECK_EQ(copy.size(), 2);
+    CHECK_EQ(map.at(1), copy.at(1));
+
+    map = copy;
+    CHECK_EQ(map.size(), 2);
+}
@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <doctest/doctest.h>
+
+#include "quicr/detail/loop_wakeup.h"
+
+#include <poll.h>
+#include <thread>
+
+namespace {
+    /// True if the wakeup is signaled within the timeout
+    bool IsSignaled(const quicr::LoopWakeup& wakeup, int timeout_ms = 0)
+    {
+        pollfd pfd{ wakeup.Fd(), POLLIN, 0 };
+        return poll(&pfd, 1, timeout_ms) > 0 && (pfd.revents & POLLIN);
+    }
+}
+
+TEST_CASE("LoopWakeup signals only when armed")
+{
+    quicr::LoopWakeup wakeup;
+    REQUIRE_GE(wakeup.Fd(), 0);
+
+    wakeup.Signal();
+    CHECK_FALSE(IsSignaled(wakeup));
+
+    wakeup.Arm();
+    wakeup.Signal();
+    CHECK(IsSignaled(wakeup));
+}
+
+TEST_CASE("LoopWakeup disarm clears the signal")
+{
+    quicr::LoopWakeup wakeup;
+    REQUIRE_GE(wakeup.Fd(), 0);
+
+    wakeup.Arm();
+    wakeup.Signal();
+    wakeup.Disarm();
+    CHECK_FALSE(IsSignaled(wakeup));
+
+    // Disarmed until the loop arms it again
+    wakeup.Signal();
+    CHECK_FALSE(IsSignaled(wakeup));
+}
+
+TEST_CASE("LoopWakeup writes once per arm")
+{
+    quicr::LoopWakeup wakeup;
+    REQUIRE_GE(wakeup.Fd(), 0);
+
+    wakeup.Arm();
+    for (int i = 0; i < 10; ++i) {
+        wakeup.Signal();
+    }
+    CHECK(IsSignaled(wakeup));
+
+    // One disarm clears all of it
+    wakeup.Disarm();
+    CHECK_FALSE(IsSignaled(wakeup));
+
+    wakeup.Arm();
+    wakeup.Signal();
+    CHECK(IsSignaled(wakeup));
+    wakeup.Disarm();
+}
+
+TEST_CASE("LoopWakeup wakes a blocked loop")
+{
+    quicr::LoopWakeup wakeup;
+    REQUIRE_GE(wakeup.Fd(), 0);
+
+    for (int i = 0; i < 100; ++i) {
+        wakeup.Arm();
+
+        std::thread signaler([&wakeup] { wakeup.Signal(); });
+        CHECK(IsSignaled(wakeup, 1000));
+        signaler.join();
+
+        wakeup.Disarm();
+    }
+}
@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <quicr/detail/tick_service.h>
+
+namespace quicr::test {
+
+    /**
+     * @brief Tick service whose time only changes when set, for deterministic tests and benchmarks
+     */
+    struct ManualTickService : TickService
+    {
+        TickType Milliseconds() const override { return ms; }
+        TickType Microseconds() const override { return ms * 1000; }
+
+        TickType ms{ 1 }; /// Current time in milliseconds
+    };
+
+} // namespace quicr::test
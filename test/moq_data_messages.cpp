@@ -346,3 +346,106 @@ TEST_CASE("Fetch Stream Message encode/decode")
     FetchStreamEncodeDecode(true, true);
     FetchStreamEncodeDecode(true, false);
 }
+
+TEST_CASE("Header only Object serialize matches full serialize")
+{
+    const Bytes payload = { 0x1, 0x2, 0x3, 0x4, 0x5 };
+
+    messages::StreamSubGroupObject obj;
+    obj.object_id = 0x1234;
+    obj.serialize_extensions = true;
+    obj.extensions = kOptionalExtensions;
+    obj.payload = payload;
+
+    Bytes full;
+    full << obj;
+
+    // Header and payload written as separate segments
+    obj.payload.clear();
+    obj.payload_len = payload.size();
+
+    Bytes segmented;
+    segmented << obj;
+    segmented.insert(segmented.end(), payload.begin(), payload.end());
+    CHECK_EQ(segmented, full);
+
+    messages::FetchObject fetch_obj{};
+    fetch_obj.group_id = 0x1234;
+    fetch_obj.subgroup_id = 0x5678;
+    fetch_obj.object_id = 0x9012;
+    fetch_obj.publisher_priority = 127;
+    fetch_obj.payload = payload;
+
+    full.clear();
+    full << fetch_obj;
+
+    fetch_obj.payload.clear();
+    fetch_obj.payload_len = payload.size();
+
+    segmented.clear();
+    segmented << fetch_obj;
+    segmented.insert(segmented.end(), payload.begin(), payload.end());
+    CHECK_EQ(segmented, full);
+}
+
+TEST_CASE("StreamPerSubGroup Object decode across chunk boundaries")
+{
+    messages::StreamSubGroupObject obj{};
+    obj.object_id = 0x3FFF'FFFF'FFFF'FFFF;
+    obj.serialize_extensions = true;
+    obj.extensions = kOptionalExtensions;
+    obj.payload = { 0x1, 0x2, 0x3, 0x4, 0x5 };
+
+    Bytes encoded;
+    encoded << obj;
+
+    // Split at every position, the header is decoded from the stream buffer instead of contiguous bytes
+    for (std::size_t split = 0; split < encoded.size(); ++split) {
+        CAPTURE(split);
+
+        StreamBuffer<uint8_t> in_buffer;
+        messages::StreamSubGroupObject obj_out{};
+        obj_out.serialize_extensions = true;
+
+        in_buffer.Push(std::make_shared<const Bytes>(encoded.begin(), encoded.begin() + split));
+        CHECK_FALSE(in_buffer >> obj_out);
+
+        in_buffer.Push(std::make_shared<const Bytes>(encoded.begin() + split, encoded.end()));
+        REQUIRE(in_buffer >> obj_out);
+
+        CHECK_EQ(obj_out.object_id, obj.object_id);
+        CHECK_EQ(obj_out.extensions, obj.extensions);
+        CHECK_EQ(obj_out.payload, obj.payload);
+        CHECK(in_buffer.Empty());
+    }
+}
+
+TEST_CASE("ObjectDatagram decode with large fields")
+{
+    auto object_datagram = messages::ObjectDatagram{};
+    object_datagram.track_alias = 0x3FFF'FFFF'FFFF'FFFF;
+    object_datagram.group_id = 0x3FFF'FFFF;
+    object_datagram.object_id = 0x3FFF;
+    object_datagram.priority = 0xA;
+    object_datagram.extensions = kOptionalExtensions;
+    object_datagram.payload = { 0x1, 0x2, 0x3 };
+
+    Bytes buffer;
+    buffer << object_datagram;
+
+    StreamBuffer<uint8_t> sbuf;
+    sbuf.Push(std::make_shared<const Bytes>(buffer));
+    sbuf.Pop(); // Remove type
+
+    messages::ObjectDatagram object_datagram_out;
+    object_datagram_out.view_payload = true;
+    REQUIRE(sbuf >> object_datagram_out);
+
+    CHECK_EQ(object_datagram_out.track_alias, object_datagram.track_alias);
+    CHECK_EQ(object_datagram_out.group_id, object_datagram.group_id);
+    CHECK_EQ(object_datagram_out.object_id, object_datagram.object_id);
+    CHECK_EQ(object_datagram_out.priority, object_datagram.priority);
+    CHECK_EQ(object_datagram_out.extensions, object_datagram.extensions);
+    CHECK_EQ(Bytes(object_datagram_out.payload_view.begin(), object_datagram_out.payload_view.end()),
+             object_datagram.payload);
+}
@@ -0,0 +1,162 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <doctest/doctest.h>
+
+#include <quicr/detail/priority_queue.h>
+
+#include "manual_tick_service.h"
+
+#include <memory>
+
+using quicr::test::ManualTickService;
+
+TEST_CASE("PriorityQueue pops lowest priority value first")
+{
+    auto ticks = std::make_shared<ManualTickService>();
+    quicr::PriorityQueue<int> pq(1000, 1, ticks, 16);
+
+    pq.Push(50, 100, 5);
+    pq.Push(10, 100, 1);
+    pq.Push(30, 100, 3);
+    pq.Push(11, 100, 1);
+    CHECK_EQ(pq.Size(), 4);
+
+    quicr::TimeQueueElement<int> elem;
+    for (const int expected : { 10, 11, 30, 50 }) {
+        pq.PopFront(elem);
+        CHECK(elem.has_value);
+        CHECK_EQ(elem.value, expected);
+    }
+
+    CHECK(pq.Empty());
+    pq.PopFront(elem);
+    CHECK_FALSE(elem.has_value);
+}
+
+TEST_CASE("PriorityQueue pop removes the front object")
+{
+    auto ticks = std::make_shared<ManualTickService>();
+    quicr::PriorityQueue<int> pq(1000, 1, ticks, 16);
+
+    pq.Push(30, 100, 3);
+
+    quicr::TimeQueueElement<int> elem;
+    pq.Front(elem);
+    CHECK_EQ(elem.value, 30);
+
+    // Higher priority object pushed between front and pop is not popped
+    pq.Push(10, 100, 1);
+    pq.Pop();
+
+    CHECK_EQ(pq.Size(), 1);
+    pq.PopFront(elem);
+    CHECK_EQ(elem.value, 10);
+}
+
+TEST_CASE("PriorityQueue skips delayed and expired objects")
+{
+    auto ticks = std::make_shared<ManualTickService>();
+    quicr::PriorityQueue<int> pq(1000, 1, ticks, 16);
+
+    pq.Push(10, 100, 1, 50);
+    pq.Push(20, 10, 2);
+    pq.Push(30, 100, 3);
+
+    ticks->ms += 20;
+
+    quicr::TimeQueueElement<int> elem;
+    pq.PopFront(elem);
+    CHECK_EQ(elem.value, 30);
+    CHECK_EQ(elem.expired_count, 1);
+    CHECK_EQ(pq.Size(), 1);
+
+    ticks->ms += 40;
+    pq.PopFront(elem);
+    CHECK_EQ(elem.value, 10);
+    CHECK(pq.Empty());
+
+    pq.Push(40, 100, 4);
+    pq.Clear();
+    CHECK(pq.Empty());
+}
+
+TEST_CASE("PriorityQueue emplace, peek and move out")
+{
+    auto ticks = std::make_shared<ManualTickService>();
+    quicr::PriorityQueue<std::shared_ptr<int>> pq(1000, 1, ticks, 16);
+
+    auto value = std::make_shared<int>(10);
+    pq.Emplace(100, 1, 0, value);
+    pq.Emplace(100, 2, 0, std::make_shared<int>(20));
+    CHECK_EQ(value.use_count(), 2);
+
+    // Peek does not copy the shared pointer
+    uint32_t expired_count = 0;
+    auto* front = pq.PeekRef(expired_count);
+    REQUIRE(front != nullptr);
+    CHECK_EQ(front->get(), value.get());
+    CHECK_EQ(value.use_count(), 2);
+
+    // Peeked object is pinned, so it does not expire until the queue is accessed again
+    ticks->ms += 200;
+    CHECK_EQ(**front, 10);
+
+    pq.Pop();
+    CHECK_EQ(value.use_count(), 1);
+
+    pq.Emplace(100, 1, 0, value);
+    std::shared_ptr<int> out;
+    CHECK(pq.TryPopInto(out, expired_count));
+    CHECK_EQ(expired_count, 1);
+    CHECK_EQ(out, value);
+    CHECK_EQ(value.use_count(), 2);
+
+    CHECK_FALSE(pq.TryPopInto(out, expired_count));
+    CHECK(pq.Empty());
+}
+
+TEST_CASE("PriorityQueue erase if")
+{
+    auto ticks = std::make_shared<ManualTickService>();
+    quicr::PriorityQueue<int> pq(1000, 1, ticks, 16);
+
+    for (int i = 0; i < 10; ++i) {
+        pq.Push(i, 100, static_cast<uint8_t>(i % 3));
+    }
+
+    // Front object is kept even when it matches
+    quicr::TimeQueueElement<int> elem;
+    pq.Front(elem);
+    CHECK_EQ(elem.value, 0);
+
+    CHECK_EQ(pq.EraseIf([](int value) { return value % 2 == 0; }), 4);
+    CHECK_EQ(pq.Size(), 6);
+
+    pq.Pop();
+    for (const int expected : { 3, 9, 1, 7, 5 }) {
+        pq.PopFront(elem);
+        CHECK_EQ(elem.value, expected);
+    }
+    CHECK(pq.Empty());
+}
+
+TEST_CASE("PriorityQueue pops front only if it matches")
+{
+    auto ticks = std::make_shared<ManualTickService>();
+    quicr::PriorityQueue<int> pq(1000, 1, ticks, 16);
+
+    pq.Push(1, 100);
+    pq.Push(2, 100);
+
+    const auto is_odd = [](int value) { return value % 2 == 1; };
+
+    int value = 0;
+    uint32_t expired_count = 0;
+    CHECK(pq.TryPopInto(value, expired_count, is_odd));
+    CHECK_EQ(value, 1);
+
+    CHECK_FALSE(pq.TryPopInto(value, expired_count, is_odd));
+    CHECK_EQ(value, 1);
+    CHECK_EQ(pq.Size(), 1);
+}
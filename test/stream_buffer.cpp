@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <doctest/doctest.h>
+
+#include "quicr/detail/stream_buffer.h"
+
+#include <numeric>
+
+using Chunk = std::vector<uint8_t>;
+
+static std::shared_ptr<const Chunk>
+MakeChunk(std::size_t size, uint8_t first)
+{
+    auto chunk = std::make_shared<Chunk>(size);
+    std::iota(chunk->begin(), chunk->end(), first);
+    return chunk;
+}
+
+TEST_CASE("StreamBuffer Push and Pop across chunks")
+{
+    quicr::StreamBuffer<uint8_t> buffer;
+
+    buffer.Push(MakeChunk(4, 0));
+    buffer.Push(MakeChunk(4, 4));
+    buffer.Push(Chunk{ 8, 9 });
+    buffer.Push(uint8_t{ 10 });
+
+    CHECK_EQ(buffer.Size(), 11);
+    CHECK_EQ(buffer.Front(), 0);
+    CHECK_EQ(buffer.Front(6), (Chunk{ 0, 1, 2, 3, 4, 5 }));
+
+    buffer.Pop(3);
+    CHECK_EQ(buffer.Size(), 8);
+    CHECK_EQ(buffer.Front(), 3);
+    CHECK_EQ(buffer.Front(8), (Chunk{ 3, 4, 5, 6, 7, 8, 9, 10 }));
+    CHECK(buffer.Front(9).empty());
+
+    buffer.Pop(5);
+    CHECK_EQ(buffer.Front(3), (Chunk{ 8, 9, 10 }));
+
+    buffer.Pop(10);
+    CHECK(buffer.Empty());
+    CHECK_FALSE(buffer.Front().has_value());
+}
+
+TEST_CASE("StreamBuffer decode across chunks")
+{
+    quicr::StreamBuffer<uint8_t> buffer;
+
+    Chunk encoded;
+    for (const auto value : { quicr::UintVar(0x3FFF'FFFF), quicr::UintVar(3) }) {
+        const auto bytes = std::span<const uint8_t>{ value };
+        encoded.insert(encoded.end(), bytes.begin(), bytes.end());
+    }
+    encoded.insert(encoded.end(), { 0xA, 0xB, 0xC });
+
+    // Split inside the first uintV and inside the bytes
+    buffer.Push(std::make_shared<const Chunk>(encoded.begin(), encoded.begin() + 2));
+    CHECK_FALSE(buffer.DecodeUintV().has_value());
+    buffer.Push(std::make_shared<const Chunk>(encoded.begin() + 2, encoded.end() - 1));
+
+    CHECK_EQ(buffer.DecodeUintV(), 0x3FFF'FFFF);
+    CHECK_FALSE(buffer.DecodeBytes().has_value());
+    CHECK_EQ(buffer.Size(), 3);
+
+    buffer.Push(encoded.back());
+    CHECK_EQ(buffer.DecodeBytes(), (Chunk{ 0xA, 0xB, 0xC }));
+    CHECK(buffer.Empty());
+}
+
+TEST_CASE("StreamBuffer FrontView")
+{
+    quicr::StreamBuffer<uint8_t> buffer;
+
+    const auto first = MakeChunk(100, 0);
+    buffer.Push(first);
+    buffer.Push(MakeChunk(100, 100));
+    buffer.Pop(10);
+
+    CHECK_FALSE(buffer.FrontView(191).has_value());
+
+    // Contiguous in the received chunk, aliases it
+    auto view = buffer.FrontView(50);
+    REQUIRE(view.has_value());
+    CHECK_EQ(view->Chunk(), first);
+    CHECK_EQ(view->data(), first->data() + 10);
+    CHECK_EQ(view->size(), 50);
+
+    // Spans chunks, copied
+    auto spanning = buffer.FrontView(150);
+    REQUIRE(spanning.has_value());
+    CHECK_NE(spanning->Chunk(), first);
+    CHECK(std::equal(spanning->begin(), spanning->end(), MakeChunk(150, 10)->begin()));
+
+    // Views stay valid after the buffer moved past the bytes
+    buffer.Clear();
+    CHECK_EQ(view->Span()[0], 10);
+    CHECK_EQ(spanning->Span()[149], 159);
+}
+
+TEST_CASE("StreamBuffer pushed bytes do not change views")
+{
+    quicr::StreamBuffer<uint8_t> buffer;
+
+    buffer.Push(Chunk{ 1, 2, 3 });
+    auto view = buffer.FrontView(3);
+    REQUIRE(view.has_value());
+
+    for (uint8_t i = 0; i < 100; ++i) {
+        buffer.Push(i);
+    }
+
+    CHECK_EQ(buffer.Size(), 103);
+    CHECK_EQ(Chunk(view->begin(), view->end()), (Chunk{ 1, 2, 3 }));
+    CHECK_EQ(buffer.Front(4), (Chunk{ 1, 2, 3, 0 }));
+}
+
+TEST_CASE("SharedSpan Compact")
+{
+    const auto chunk = MakeChunk(100, 0);
+
+    // A view of a few bytes is copied to a chunk of its own
+    const quicr::SharedSpan<uint8_t> view(chunk, 10, 5);
+    const auto compact = view.Compact();
+    CHECK_NE(compact.Chunk(), chunk);
+    CHECK_EQ(compact.Chunk()->size(), 5);
+    CHECK_EQ(Chunk(compact.begin(), compact.end()), (Chunk{ 10, 11, 12, 13, 14 }));
+
+    // A view of the whole chunk is kept as is
+    const quicr::SharedSpan<uint8_t> whole(chunk, 0, chunk->size());
+    CHECK_EQ(whole.Compact().Chunk(), chunk);
+
+    CHECK(quicr::SharedSpan<uint8_t>().Compact().empty());
+}
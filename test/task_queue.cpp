@@ -0,0 +1,171 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <doctest/doctest.h>
+
+#include "quicr/detail/task_queue.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST_CASE("TaskQueue runs tasks in order")
+{
+    quicr::TaskQueue<> queue(8);
+    std::vector<int> ran;
+
+    for (int i = 0; i < 5; ++i) {
+        CHECK(queue.Push([&ran, i] { ran.push_back(i); }));
+    }
+
+    CHECK_EQ(queue.Size(), 5);
+    CHECK(queue.RunOne());
+    CHECK_EQ(ran, std::vector<int>{ 0 });
+
+    CHECK_EQ(queue.RunAll(), 4);
+    const std::vector<int> expected{ 0, 1, 2, 3, 4 };
+    CHECK_EQ(ran, expected);
+    CHECK(queue.Empty());
+    CHECK_FALSE(queue.RunOne());
+}
+
+TEST_CASE("TaskQueue rejects tasks when full")
+{
+    quicr::TaskQueue<> queue(3);
+    CHECK_EQ(queue.Capacity(), 4);
+
+    int ran = 0;
+    for (std::size_t i = 0; i < queue.Capacity(); ++i) {
+        CHECK(queue.Push([&ran] { ran++; }));
+    }
+
+    CHECK_FALSE(queue.Push([&ran] { ran++; }));
+    CHECK_EQ(queue.Size(), 4);
+
+    // Room is released once a task has run
+    CHECK(queue.RunOne());
+    CHECK(queue.Push([&ran] { ran++; }));
+
+    CHECK_EQ(queue.RunAll(), 4);
+    CHECK_EQ(ran, 5);
+}
+
+TEST_CASE("TaskQueue overflow keeps tasks in order")
+{
+    quicr::TaskQueue<> queue(2);
+    std::vector<int> ran;
+
+    for (int i = 0; i < 5; ++i) {
+        CHECK_EQ(queue.PushOrOverflow([&ran, i] { ran.push_back(i); }), i < 2);
+    }
+
+    CHECK_EQ(queue.OverflowSize(), 3);
+    CHECK_EQ(queue.Size(), 5);
+
+    // Ring has room again, but new tasks wait behind the overflow
+    CHECK(queue.RunOne());
+    CHECK_FALSE(queue.Push([&ran] { ran.push_back(5); }));
+    CHECK_FALSE(queue.PushOrOverflow([&ran] { ran.push_back(5); }));
+
+    CHECK_EQ(queue.RunAll(), 5);
+    const std::vector<int> expected{ 0, 1, 2, 3, 4, 5 };
+    CHECK_EQ(ran, expected);
+    CHECK_EQ(queue.OverflowSize(), 0);
+
+    CHECK(queue.Push([&ran] { ran.push_back(6); }));
+    CHECK_EQ(queue.RunAll(), 1);
+}
+
+TEST_CASE("TaskQueue removes a task that throws")
+{
+    quicr::TaskQueue<> queue(4);
+    int ran = 0;
+
+    queue.Push([] { throw std::runtime_error("task failed"); });
+    queue.Push([&ran] { ran++; });
+
+    CHECK_THROWS(queue.RunAll());
+    CHECK_EQ(queue.RunAll(), 1);
+    CHECK_EQ(ran, 1);
+
+    // Records of the failed task are reused
+    for (std::size_t i = 0; i < queue.Capacity(); ++i) {
+        CHECK(queue.Push([&ran] { ran++; }));
+    }
+    CHECK_EQ(queue.RunAll(), queue.Capacity());
+}
+
+TEST_CASE("TaskQueue destroys tasks that are not run")
+{
+    auto value = std::make_shared<int>(1);
+
+    {
+        quicr::TaskQueue<> queue(2);
+        queue.PushOrOverflow([value] {});
+        queue.PushOrOverflow([value] {});
+        queue.PushOrOverflow([value] {});
+        CHECK_EQ(value.use_count(), 4);
+
+        queue.Clear();
+        CHECK_EQ(value.use_count(), 1);
+
+        queue.PushOrOverflow([value] {});
+    }
+
+    CHECK_EQ(value.use_count(), 1);
+}
+
+TEST_CASE("TaskQueue multiple producers")
+{
+    constexpr int kProducers = 4;
+    constexpr int kTasksPerProducer = 10'000;
+
+    quicr::TaskQueue<> queue(64);
+    std::vector<int> last_seen(kProducers, -1);
+    std::atomic<int> out_of_order{ 0 };
+    int ran = 0;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p) {
+        producers.emplace_back([&, p] {
+            for (int i = 0; i < kTasksPerProducer; ++i) {
+                queue.PushOrOverflow([&, p, i] {
+                    if (last_seen[p] + 1 != i) {
+                        out_of_order++;
+                    }
+                    last_seen[p] = i;
+                    ran++;
+                });
+            }
+        });
+    }
+
+    std::thread consumer([&] {
+        while (ran < kProducers * kTasksPerProducer) {
+            queue.BlockRun();
+        }
+    });
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    consumer.join();
+
+    CHECK_EQ(ran, kProducers * kTasksPerProducer);
+    CHECK_EQ(out_of_order, 0);
+    CHECK(queue.Empty());
+}
+
+TEST_CASE("TaskQueue StopWaiting unblocks the consumer")
+{
+    quicr::TaskQueue<> queue(4);
+
+    std::thread consumer([&] { CHECK_FALSE(queue.BlockRun()); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    queue.StopWaiting();
+    consumer.join();
+}
@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <doctest/doctest.h>
+
+#include <quicr/detail/time_queue.h>
+
+#include "manual_tick_service.h"
+
+#include <memory>
+
+using quicr::test::ManualTickService;
+
+TEST_CASE("TimeQueue push and pop order")
+{
+    auto ticks = std::make_shared<ManualTickService>();
+    quicr::TimeQueue<int, std::chrono::milliseconds> tq(1000, 1, ticks);
+
+    // Push past the initial ring capacity with pops in between so that the ring wraps and grows
+    int next_pop = 0;
+    for (int i = 0; i < 100; ++i) {
+        tq.Push(i, 500);
+        if (i % 3 == 0) {
+            CHECK_EQ(tq.PopFront().value, next_pop++);
+        }
+    }
+
+    CHECK_EQ(tq.Size(), static_cast<size_t>(100 - next_pop));
+
+    quicr::TimeQueueElement<int> elem;
+    for (tq.PopFront(elem); elem.has_value; tq.PopFront(elem)) {
+        CHECK_EQ(elem.value, next_pop++);
+    }
+
+    CHECK_EQ(next_pop, 100);
+    CHECK(tq.Empty());
+}
+
+TEST_CASE("TimeQueue expire and delay")
+{
+    auto ticks = std::make_shared<ManualTickService>();
+    quicr::TimeQueue<std::shared_ptr<int>, std::chrono::milliseconds> tq(1000, 1, ticks);
+
+    auto value = std::make_shared<int>(1);
+    tq.Push(value, 10);
+    tq.Push(std::make_shared<int>(2), 100);
+    tq.Push(std::make_shared<int>(3), 100, 50);
+    CHECK_EQ(value.use_count(), 2);
+
+    ticks->ms += 20;
+
+    auto elem = tq.PopFront();
+    CHECK(elem.has_value);
+    CHECK_EQ(elem.expired_count, 1);
+    CHECK_EQ(*elem.value, 2);
+    CHECK_EQ(value.use_count(), 1);
+
+    // Third value waits for its pop delay
+    CHECK_FALSE(tq.PopFront().has_value);
+    ticks->ms += 40;
+    CHECK_EQ(*tq.PopFront().value, 3);
+
+    // Values expired before a push are dropped and reported on the next front access
+    tq.Push(std::make_shared<int>(4), 10);
+    ticks->ms += 20;
+    tq.Push(std::make_shared<int>(5), 10);
+    CHECK_EQ(tq.Size(), 1);
+
+    elem = tq.PopFront();
+    CHECK_EQ(elem.expired_count, 1);
+    CHECK_EQ(*elem.value, 5);
+}
+
+TEST_CASE("TimeQueue clear")
+{
+    auto ticks = std::make_shared<ManualTickService>();
+    quicr::TimeQueue<std::shared_ptr<int>, std::chrono::milliseconds> tq(2000, 1, ticks, 4);
+
+    auto value = std::make_shared<int>(1);
+    for (int i = 0; i < 10; ++i) {
+        tq.Push(value, 100);
+    }
+    CHECK_EQ(value.use_count(), 11);
+
+    tq.Clear();
+    CHECK(tq.Empty());
+    CHECK_EQ(value.use_count(), 1);
+
+    tq.Push(value, 100);
+    CHECK_EQ(tq.Size(), 1);
+    CHECK_EQ(tq.PopFront().value, value);
+}
+
+TEST_CASE("TimeQueue emplace, peek and move out")
+{
+    auto ticks = std::make_shared<ManualTickService>();
+    quicr::TimeQueue<std::shared_ptr<int>, std::chrono::milliseconds> tq(1000, 1, ticks);
+
+    auto value = std::make_shared<int>(1);
+    tq.Emplace(100, 0, value);
+    CHECK_EQ(value.use_count(), 2);
+
+    uint32_t expired_count = 0;
+    auto* front = tq.PeekRef(expired_count);
+    REQUIRE(front != nullptr);
+    CHECK_EQ(*front, value);
+    CHECK_EQ(value.use_count(), 2);
+
+    std::shared_ptr<int> out;
+    CHECK(tq.TryPopInto(out, expired_count));
+    CHECK_EQ(out, value);
+    CHECK_EQ(value.use_count(), 2);
+    CHECK(tq.Empty());
+
+    CHECK_FALSE(tq.TryPopInto(out, expired_count));
+    CHECK(tq.PeekRef(expired_count) == nullptr);
+}
+
+TEST_CASE("TimeQueue invalid args")
+{
+    auto ticks = std::make_shared<ManualTickService>();
+    using TimeQueue = quicr::TimeQueue<int, std::chrono::milliseconds>;
+
+    CHECK_THROWS_AS(TimeQueue(0, 1, ticks), std::invalid_argument);
+    CHECK_THROWS_AS(TimeQueue(100, 0, ticks), std::invalid_argument);
+    CHECK_THROWS_AS(TimeQueue(100, 100, ticks), std::invalid_argument);
+    CHECK_THROWS_AS(TimeQueue(100, 1, nullptr), std::invalid_argument);
+
+    TimeQueue tq(100, 1, ticks);
+    CHECK_THROWS_AS(tq.Push(1, 200), std::invalid_argument);
+}
@@ -0,0 +1,135 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <doctest/doctest.h>
+
+#include <quicr/detail/priority_queue.h>
+#include <quicr/detail/quic_transport.h>
+
+#include "manual_tick_service.h"
+
+#include <deque>
+#include <memory>
+#include <random>
+#include <vector>
+
+using quicr::test::ManualTickService;
+
+TEST_CASE("TimingWheel expires objects across levels")
+{
+    auto ticks = std::make_shared<ManualTickService>();
+    ticks->ms = 65'000; // Close to where all levels wrap
+    auto wheel = std::make_shared<quicr::TimingWheel<int>>(60'000, 1, ticks);
+
+    quicr::PriorityQueue<int> pq(wheel);
+    pq.Push(1, 50'000, 1);
+    pq.Push(2, 300, 0);
+
+    quicr::TimeQueueElement<int> elem;
+
+    ticks->ms += 300;
+    pq.Front(elem);
+    CHECK_EQ(elem.value, 2);
+    CHECK_EQ(elem.expired_count, 0);
+
+    ticks->ms += 1;
+    pq.Front(elem);
+    CHECK_EQ(elem.value, 1);
+    CHECK_EQ(elem.expired_count, 1);
+
+    ticks->ms += 50'000 - 301;
+    pq.Front(elem);
+    CHECK(elem.has_value);
+
+    ticks->ms += 1;
+    pq.Front(elem);
+    CHECK_FALSE(elem.has_value);
+    CHECK_EQ(elem.expired_count, 1);
+    CHECK(pq.Empty());
+}
+
+TEST_CASE("TimingWheel shared by queues")
+{
+    auto ticks = std::make_shared<ManualTickService>();
+    auto wheel = std::make_shared<quicr::TimingWheel<int>>(2000, 1, ticks);
+
+    struct Model
+    {
+        int value;
+        std::size_t expiry;
+    };
+
+    constexpr std::size_t kQueues = 50;
+    std::vector<std::unique_ptr<quicr::PriorityQueue<int>>> queues;
+    std::vector<std::deque<Model>> models(kQueues);
+    for (std::size_t i = 0; i < kQueues; ++i) {
+        queues.push_back(std::make_unique<quicr::PriorityQueue<int>>(wheel));
+    }
+
+    std::mt19937 rng(1);
+    quicr::TimeQueueElement<int> elem;
+
+    for (int i = 0; i < 50'000; ++i) {
+        const auto q = rng() % kQueues;
+
+        switch (rng() % 4) {
+            case 0:
+            case 1: {
+                // One priority so that pop order is push order
+                const auto ttl = 100 + rng() % 1000;
+                queues[q]->Push(i, ttl, 3);
+                models[q].push_back({ i, ticks->ms + ttl });
+                break;
+            }
+            case 2: {
+                // Objects expire from anywhere in the queue
+                std::erase_if(models[q], [&](const auto& obj) { return ticks->ms > obj.expiry; });
+
+                queues[q]->PopFront(elem);
+                CHECK_EQ(elem.has_value, !models[q].empty());
+                if (elem.has_value) {
+                    CHECK_EQ(elem.value, models[q].front().value);
+                    models[q].pop_front();
+                }
+                CHECK_EQ(queues[q]->Size(), models[q].size());
+                break;
+            }
+            case 3:
+                ticks->ms += rng() % 20;
+                break;
+        }
+    }
+
+    std::size_t total = 0;
+    for (auto& queue : queues) {
+        queue->Clear();
+        total += queue->Size();
+    }
+    CHECK_EQ(total, 0);
+    CHECK_EQ(wheel->Size(), 0);
+}
+
+TEST_CASE("TimingWheel counts queued bytes")
+{
+    auto ticks = std::make_shared<ManualTickService>();
+    auto wheel = std::make_shared<quicr::TimingWheel<quicr::ConnData>>(1000, 1, ticks);
+    quicr::PriorityQueue<quicr::ConnData> pq(wheel);
+
+    const auto data = std::make_shared<const std::vector<uint8_t>>(100);
+    const auto payload = std::make_shared<const std::vector<uint8_t>>(1000);
+
+    pq.Emplace(100, 1, 0, 1, 1, 1, quicr::StreamAction::kNoAction, data, 0, payload);
+    pq.Emplace(10, 2, 0, 1, 1, 2, quicr::StreamAction::kNoAction, data, 0, nullptr);
+    CHECK_EQ(pq.Bytes(), 1200);
+
+    quicr::ConnData out;
+    uint32_t expired_count = 0;
+    CHECK(pq.TryPopInto(out, expired_count));
+    CHECK_EQ(pq.Bytes(), 100);
+
+    // Expired objects are no longer counted
+    ticks->ms += 20;
+    CHECK_FALSE(pq.TryPopInto(out, expired_count));
+    CHECK_EQ(expired_count, 1);
+    CHECK_EQ(pq.Bytes(), 0);
+}
@@ -9,6 +9,31 @@
 #include <quicr/server.h>
 #include <quicr/subscribe_track_handler.h>
 
+class TestSubscribeTrackHandler : public quicr::SubscribeTrackHandler
+{
+  public:
+    TestSubscribeTrackHandler()
+      : SubscribeTrackHandler({ {}, {}, std::nullopt },
+                              0,
+                              quicr::messages::GroupOrder::kAscending,
+                              quicr::messages::FilterType::kLatestObject)
+    {
+    }
+
+    void ObjectsReceived(std::span<const ReceivedObject> objects) override
+    {
+        batches.push_back(objects.size());
+        for (const auto& object : objects) {
+            object_ids.push_back(object.headers.object_id);
+            payloads.push_back(object.data);
+        }
+    }
+
+    std::vector<std::size_t> batches;
+    std::vector<uint64_t> object_ids;
+    std::vector<quicr::SharedSpan<uint8_t>> payloads;
+};
+
 class TestPublishTrackHandler : public quicr::PublishTrackHandler
 {
     TestPublishTrackHandler()
@@ -28,3 +53,47 @@ TEST_CASE("Create Track Handler")
     CHECK_NOTHROW(quicr::PublishTrackHandler::Create({ {}, {}, std::nullopt }, quicr::TrackMode::kDatagram, 0, 0));
     CHECK_NOTHROW(TestPublishTrackHandler::Create());
 }
+
+TEST_CASE("Subscribe Track Handler receives all objects in a slice")
+{
+    using namespace quicr::messages;
+
+    StreamHeaderSubGroup hdr{};
+    hdr.type = StreamHeaderType::kSubgroupZeroNoExtensions;
+    hdr.track_alias = 1;
+    hdr.group_id = 10;
+    hdr.priority = 2;
+
+    quicr::Bytes stream;
+    stream << hdr;
+
+    StreamSubGroupObject obj{};
+    obj.serialize_extensions = false;
+    for (uint64_t object_id = 0; object_id < 5; ++object_id) {
+        obj.object_id = object_id;
+        obj.payload.assign(object_id + 1, static_cast<uint8_t>(object_id));
+        stream << obj;
+    }
+
+    // Header and three objects in the first slice, the fourth object of 6 bytes is split across the slices
+    const auto split = stream.end() - 7 - 3;
+    const auto first = std::make_shared<const quicr::Bytes>(stream.begin(), split);
+    const auto second = std::make_shared<const quicr::Bytes>(split, stream.end());
+
+    auto handler = std::make_shared<TestSubscribeTrackHandler>();
+    handler->StreamDataRecv(true, 0, first);
+    handler->StreamDataRecv(false, 0, second);
+
+    CHECK_EQ(handler->batches, (std::vector<std::size_t>{ 3, 2 }));
+    CHECK_EQ(handler->object_ids, (std::vector<uint64_t>{ 0, 1, 2, 3, 4 }));
+    CHECK_EQ(handler->subscribe_track_metrics_.objects_received, 5);
+
+    // Payloads alias the received data unless they are split across slices
+    REQUIRE_EQ(handler->payloads.size(), 5);
+    CHECK_EQ(handler->payloads[0].Chunk(), first);
+    CHECK_EQ(handler->payloads[2].Chunk(), first);
+    CHECK_NE(handler->payloads[3].Chunk(), first);
+    CHECK_EQ(handler->payloads[4].Chunk(), second);
+    CHECK_EQ(quicr::Bytes(handler->payloads[3].begin(), handler->payloads[3].end()), quicr::Bytes(4, 3));
+    CHECK_EQ(quicr::Bytes(handler->payloads[4].begin(), handler->payloads[4].end()), quicr::Bytes(5, 4));
+}
@@ -0,0 +1,290 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <doctest/doctest.h>
+
+#include "transport_picoquic.h"
+
+#include "manual_tick_service.h"
+
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using DataContext = quicr::PicoQuicTransport::DataContext;
+using EnqueueObject = quicr::ITransport::EnqueueObject;
+
+namespace {
+    /// Object bytes of the given size
+    std::shared_ptr<const std::vector<uint8_t>> MakeBytes(std::size_t size)
+    {
+        return std::make_shared<const std::vector<uint8_t>>(size);
+    }
+
+    /// Data context with a TX queue on a manual tick service
+    struct TxContext
+    {
+        TxContext() { data_ctx.tx_data = std::make_unique<quicr::PriorityQueue<quicr::ConnData>>(ticks); }
+
+        /// Queue objects of the given size to be sent
+        void Queue(std::size_t objects, std::size_t size)
+        {
+            for (std::size_t i = 0; i < objects; ++i) {
+                quicr::ConnData object{ 1, 1, 0, quicr::StreamAction::kNoAction, MakeBytes(size), 0, {} };
+                data_ctx.tx_data->Push(std::move(object), 1000);
+            }
+        }
+
+        std::shared_ptr<quicr::test::ManualTickService> ticks = std::make_shared<quicr::test::ManualTickService>();
+        DataContext data_ctx;
+    };
+
+    /// Object to enqueue, reliable unless set otherwise
+    EnqueueObject Object(std::size_t size, bool clear_tx_queue = false)
+    {
+        EnqueueObject object;
+        object.bytes = MakeBytes(size);
+        object.flags.clear_tx_queue = clear_tx_queue;
+        return object;
+    }
+}
+
+TEST_CASE("DataContext TX queue without a budget has room")
+{
+    TxContext tx;
+    tx.Queue(1000, 100);
+
+    CHECK(tx.data_ctx.TxQueueHasRoom(1000, 100'000, false));
+    CHECK(tx.data_ctx.TxQueueDrained());
+}
+
+TEST_CASE("DataContext empty TX queue has room for objects over the budget")
+{
+    TxContext tx;
+    tx.data_ctx.tx_max_objects = 2;
+    tx.data_ctx.tx_max_bytes = 100;
+
+    CHECK(tx.data_ctx.TxQueueHasRoom(5, 1000, false));
+
+    tx.Queue(1, 10);
+    CHECK_FALSE(tx.data_ctx.TxQueueHasRoom(5, 1000, false));
+
+    // Cleared before the objects are queued
+    CHECK(tx.data_ctx.TxQueueHasRoom(5, 1000, true));
+}
+
+TEST_CASE("DataContext TX queue budget in objects and bytes")
+{
+    TxContext tx;
+    tx.data_ctx.tx_max_objects = 4;
+    tx.Queue(2, 10);
+
+    CHECK(tx.data_ctx.TxQueueHasRoom(2, 20, false));
+    CHECK_FALSE(tx.data_ctx.TxQueueHasRoom(3, 30, false));
+
+    tx.data_ctx.tx_max_objects = 0;
+    tx.data_ctx.tx_max_bytes = 50;
+
+    CHECK(tx.data_ctx.TxQueueHasRoom(3, 30, false));
+    CHECK_FALSE(tx.data_ctx.TxQueueHasRoom(1, 31, false));
+}
+
+TEST_CASE("DataContext TX queue batch is admitted all or none")
+{
+    TxContext tx;
+    tx.data_ctx.tx_max_objects = 4;
+    tx.Queue(2, 10);
+
+    // Only two of the three reliable objects fit, none are admitted
+    std::vector<EnqueueObject> batch{ Object(10), Object(10), Object(10) };
+    CHECK_FALSE(tx.data_ctx.TxQueueAdmit(batch));
+    CHECK_EQ(tx.data_ctx.metrics.tx_queue_full, 3);
+
+    batch.pop_back();
+    CHECK(tx.data_ctx.TxQueueAdmit(batch));
+    CHECK_EQ(tx.data_ctx.metrics.tx_queue_full, 3);
+
+    // Datagrams and empty objects are not counted against the budget
+    auto datagram = Object(10);
+    datagram.flags.use_reliable = false;
+    batch.push_back(datagram);
+    batch.push_back(Object(0));
+    CHECK(tx.data_ctx.TxQueueAdmit(batch));
+
+    // Clearing the queue makes room for the batch
+    batch.push_back(Object(10, true));
+    batch.push_back(Object(10));
+    CHECK(tx.data_ctx.TxQueueAdmit(batch));
+}
+
+TEST_CASE("DataContext TX queue batch bytes include the payload")
+{
+    TxContext tx;
+    tx.data_ctx.tx_max_bytes = 100;
+    tx.Queue(1, 40);
+
+    auto object = Object(10);
+    object.payload = MakeBytes(51);
+
+    std::vector<EnqueueObject> batch{ object };
+    CHECK_FALSE(tx.data_ctx.TxQueueAdmit(batch));
+    CHECK_EQ(tx.data_ctx.metrics.tx_queue_full, 1);
+
+    batch[0].payload = MakeBytes(50);
+    CHECK(tx.data_ctx.TxQueueAdmit(batch));
+}
+
+TEST_CASE("DataContext TX queue is drained at half of the budget")
+{
+    TxContext tx;
+    tx.data_ctx.tx_max_objects = 4;
+    tx.data_ctx.tx_max_bytes = 1000;
+    tx.Queue(3, 10);
+
+    CHECK_FALSE(tx.data_ctx.TxQueueDrained());
+
+    quicr::TimeQueueElement<quicr::ConnData> elem;
+    tx.data_ctx.tx_data->PopFront(elem);
+    CHECK(tx.data_ctx.TxQueueDrained());
+
+    // Both budgets are to be at half
+    tx.data_ctx.tx_max_bytes = 39;
+    CHECK_FALSE(tx.data_ctx.TxQueueDrained());
+
+    tx.data_ctx.tx_max_bytes = 40;
+    CHECK(tx.data_ctx.TxQueueDrained());
+}
+
+TEST_CASE("DataContext TX round robin turn")
+{
+    DataContext data_ctx;
+    data_ctx.tx_quantum = 1000;
+
+    // A new turn starts with the quantum
+    CHECK_EQ(data_ctx.TxAllowance(1200), 1000);
+    CHECK_EQ(data_ctx.tx_deficit, 1000);
+
+    // The rest of the turn carries over to the next callback
+    CHECK_FALSE(data_ctx.TxConsume(600));
+    CHECK_EQ(data_ctx.tx_deficit, 400);
+    CHECK_EQ(data_ctx.TxAllowance(1200), 400);
+    CHECK_EQ(data_ctx.TxAllowance(300), 300);
+
+    // Using up the turn yields, the next callback starts a new turn
+    CHECK(data_ctx.TxConsume(400));
+    CHECK_EQ(data_ctx.tx_deficit, 0);
+    CHECK_EQ(data_ctx.TxAllowance(1200), 1000);
+
+    // Writing more than the turn does not wrap the deficit
+    CHECK(data_ctx.TxConsume(1200));
+    CHECK_EQ(data_ctx.tx_deficit, 0);
+}
+
+TEST_CASE("DataContext TX round robin disabled without a quantum")
+{
+    DataContext data_ctx;
+
+    CHECK_EQ(data_ctx.TxAllowance(1200), 1200);
+    CHECK_FALSE(data_ctx.TxConsume(1200));
+    CHECK_EQ(data_ctx.tx_deficit, 0);
+}
+
+TEST_CASE("DataContext TX allowance is limited by the rate limit tokens")
+{
+    DataContext data_ctx;
+    data_ctx.tx_quantum = 1000;
+    data_ctx.tx_rate_bps = 8'000'000;
+    data_ctx.tx_tokens = 500.5;
+
+    CHECK_EQ(data_ctx.TxAllowance(1200), 500);
+
+    CHECK_FALSE(data_ctx.TxConsume(500));
+    CHECK_EQ(data_ctx.tx_tokens, 0.5);
+    CHECK_EQ(data_ctx.tx_deficit, 500);
+    CHECK_EQ(data_ctx.TxAllowance(1200), 0);
+}
+
+TEST_CASE("DataContext TX rate limit default burst")
+{
+    // 100 milliseconds of the rate
+    CHECK_EQ(DataContext::TxBurstBytes(8'000'000, 0), 100'000);
+    CHECK_EQ(DataContext::TxBurstBytes(8'000'000, 1500), 1500);
+    CHECK_EQ(DataContext::TxBurstBytes(std::numeric_limits<uint64_t>::max(), 0), std::numeric_limits<uint32_t>::max());
+}
+
+TEST_CASE("DataContext TX rate limit tokens are clamped at the burst")
+{
+    DataContext data_ctx;
+    data_ctx.SetTxRateLimit(8'000'000, 10'000, 1000);
+    CHECK_EQ(data_ctx.tx_tokens, 10'000);
+
+    data_ctx.TxConsume(9'000);
+    CHECK_EQ(data_ctx.TxAllowance(1200), 1000);
+
+    // 1 millisecond at 1 byte per microsecond
+    data_ctx.TxRefillTokens(2000);
+    CHECK_EQ(data_ctx.tx_tokens, 2000);
+    CHECK_EQ(data_ctx.tx_tokens_time_us, 2000);
+
+    // Time going backwards earns nothing
+    data_ctx.TxRefillTokens(1500);
+    CHECK_EQ(data_ctx.tx_tokens, 2000);
+    CHECK_EQ(data_ctx.tx_tokens_time_us, 2000);
+
+    data_ctx.TxRefillTokens(1'000'000);
+    CHECK_EQ(data_ctx.tx_tokens, 10'000);
+}
+
+TEST_CASE("DataContext TX rate limit disabled with a zero rate")
+{
+    DataContext data_ctx;
+    data_ctx.SetTxRateLimit(8'000'000, 10'000, 1000);
+    data_ctx.TxConsume(10'000);
+    CHECK_EQ(data_ctx.TxAllowance(1200), 0);
+
+    data_ctx.SetTxRateLimit(0, 0, 2000);
+    CHECK_EQ(data_ctx.TxAllowance(1200), 1200);
+
+    data_ctx.TxConsume(1200);
+    data_ctx.TxRefillTokens(1'000'000);
+    CHECK_EQ(data_ctx.tx_tokens, 0);
+    CHECK_EQ(data_ctx.tx_tokens_time_us, 2000);
+}
+
+TEST_CASE("DataContext TX objects are kept when picoquic has no buffer")
+{
+    DataContext data_ctx;
+    const auto tx_object = MakeBytes(100);
+    data_ctx.stream_tx_object = tx_object;
+    data_ctx.stream_tx_object_offset = 100;
+
+    // An object is left unsent after the coalesced objects that were taken from tx_unsent
+    const std::vector<std::shared_ptr<const std::vector<uint8_t>>> bytes{ MakeBytes(10), MakeBytes(20), MakeBytes(30) };
+    data_ctx.tx_unsent.push_back({ 1, 1, 0, quicr::StreamAction::kNoAction, bytes[2], 0, {} });
+
+    std::vector<quicr::ConnData> coalesce;
+    coalesce.push_back({ 1, 1, 0, quicr::StreamAction::kNoAction, bytes[0], 0, {} });
+    coalesce.push_back({ 1, 1, 0, quicr::StreamAction::kNoAction, bytes[1], 0, MakeBytes(5) });
+
+    data_ctx.RestoreTxUnsent(40, coalesce);
+
+    CHECK(coalesce.empty());
+    CHECK_EQ(data_ctx.stream_tx_object, tx_object);
+    CHECK_EQ(data_ctx.stream_tx_object_offset, 40);
+
+    // The TX object is sent first, then the unsent objects in order
+    data_ctx.TakeTxUnsent();
+    CHECK_EQ(data_ctx.stream_tx_object, tx_object);
+    REQUIRE_EQ(data_ctx.tx_unsent.size(), 3);
+
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        data_ctx.ResetTxObject();
+        data_ctx.TakeTxUnsent();
+        CHECK_EQ(data_ctx.stream_tx_object, bytes[i]);
+        CHECK_EQ(data_ctx.stream_tx_object_offset, 0);
+        CHECK_EQ(data_ctx.TxObjectSize(), bytes[i]->size() + (i == 1 ? 5 : 0));
+    }
+
+    CHECK(data_ctx.tx_unsent.empty());
+}
@@ -0,0 +1,166 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <doctest/doctest.h>
+
+#include "quicr/detail/udp_batch_socket.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cstring>
+#include <netinet/in.h>
+#include <poll.h>
+#include <vector>
+
+namespace {
+    constexpr std::size_t kMaxPacketSize = 1200;
+
+    /// Loopback address of the port the socket is bound to
+    sockaddr_in LoopbackAddr(const quicr::UdpBatchSocket& socket)
+    {
+        sockaddr_in addr{};
+        socklen_t addr_len = sizeof(addr);
+        getsockname(socket.Fd(), reinterpret_cast<sockaddr*>(&addr), &addr_len);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        return addr;
+    }
+
+    /// Receive until the expected number of packets arrive or no more arrive, returns the payloads
+    std::vector<std::vector<uint8_t>> ReceivePackets(quicr::UdpBatchSocket& socket, std::size_t expected)
+    {
+        std::vector<std::vector<uint8_t>> packets;
+
+        while (packets.size() < expected) {
+            pollfd pfd{ socket.Fd(), POLLIN, 0 };
+            if (poll(&pfd, 1, 1000) <= 0) {
+                break;
+            }
+
+            for (const auto& packet : socket.Receive()) {
+                CHECK_EQ(packet.peer_addr->ss_family, AF_INET);
+                CHECK_EQ(packet.local_addr->ss_family, AF_INET);
+                packets.emplace_back(packet.data.begin(), packet.data.end());
+            }
+        }
+
+        return packets;
+    }
+
+    void SendPackets(quicr::UdpBatchSocket& socket, const sockaddr_in& peer, std::size_t count, std::size_t size)
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            auto buffer = socket.SendBuffer();
+            REQUIRE_GE(buffer.size(), size);
+
+            std::memset(buffer.data(), static_cast<int>(i), size);
+            socket.QueueSend(size, 0, reinterpret_cast<const sockaddr*>(&peer), nullptr, 0);
+        }
+    }
+}
+
+TEST_CASE("UdpBatchSocket loopback round trip")
+{
+    if (!quicr::UdpBatchSocket::Supported()) {
+        return;
+    }
+
+    quicr::UdpBatchSocket sender(kMaxPacketSize, false);
+    quicr::UdpBatchSocket receiver(kMaxPacketSize, false);
+
+    REQUIRE_EQ(sender.Open(AF_INET, 0, false), 0);
+    REQUIRE_EQ(receiver.Open(AF_INET, 0, false), 0);
+    CHECK_FALSE(sender.GsoEnabled());
+    CHECK_FALSE(receiver.GroEnabled());
+
+    // More than one batch, SendBuffer() flushes the full batch
+    constexpr std::size_t kCount = quicr::UdpBatchSocket::kBatchSize + 8;
+    SendPackets(sender, LoopbackAddr(receiver), kCount, 100);
+    sender.Flush();
+
+    CHECK_EQ(sender.GetStats().tx_packets, kCount);
+    CHECK_EQ(sender.GetStats().tx_errors, 0);
+    CHECK_LT(sender.GetStats().tx_syscalls, kCount);
+
+    const auto packets = ReceivePackets(receiver, kCount);
+    REQUIRE_EQ(packets.size(), kCount);
+
+    for (std::size_t i = 0; i < kCount; ++i) {
+        CHECK_EQ(packets[i].size(), 100);
+        CHECK_EQ(packets[i].front(), static_cast<uint8_t>(i));
+    }
+
+    CHECK_EQ(receiver.GetStats().rx_packets, kCount);
+    CHECK_LT(receiver.GetStats().rx_syscalls, kCount);
+}
+
+TEST_CASE("UdpBatchSocket segmented send is received as separate packets")
+{
+    if (!quicr::UdpBatchSocket::Supported()) {
+        return;
+    }
+
+    quicr::UdpBatchSocket sender(kMaxPacketSize, true);
+    quicr::UdpBatchSocket receiver(kMaxPacketSize, true);
+
+    REQUIRE_EQ(sender.Open(AF_INET, 0, false), 0);
+    REQUIRE_EQ(receiver.Open(AF_INET, 0, false), 0);
+
+    const auto peer = LoopbackAddr(receiver);
+
+    // Without GSO the send buffer only has room for one packet
+    const std::size_t segments = sender.GsoEnabled() ? 4 : 1;
+    constexpr std::size_t kSegmentSize = 500;
+    const std::size_t length = (segments - 1) * kSegmentSize + 200; // Last segment is shorter
+
+    auto buffer = sender.SendBuffer();
+    REQUIRE_GE(buffer.size(), length);
+    for (std::size_t i = 0; i < segments; ++i) {
+        const auto offset = i * kSegmentSize;
+        std::memset(buffer.data() + offset, static_cast<int>(i), std::min(kSegmentSize, length - offset));
+    }
+
+    sender.QueueSend(length, kSegmentSize, reinterpret_cast<const sockaddr*>(&peer), nullptr, 0);
+    CHECK_EQ(sender.Flush(), segments);
+
+    const auto packets = ReceivePackets(receiver, segments);
+    REQUIRE_EQ(packets.size(), segments);
+
+    for (std::size_t i = 0; i < segments; ++i) {
+        CHECK_EQ(packets[i].size(), i + 1 < segments ? kSegmentSize : 200);
+        CHECK_EQ(packets[i].front(), static_cast<uint8_t>(i));
+        CHECK_EQ(packets[i].back(), static_cast<uint8_t>(i));
+    }
+}
+
+TEST_CASE("UdpBatchSocket reports messages that fail to send")
+{
+    if (!quicr::UdpBatchSocket::Supported()) {
+        return;
+    }
+
+    quicr::UdpBatchSocket sender(kMaxPacketSize, false);
+    REQUIRE_EQ(sender.Open(AF_INET, 0, false), 0);
+
+    std::vector<quicr::UdpBatchSocket::SendError> errors;
+    sender.SetSendErrorHandler([&errors](const auto& error) { errors.push_back(error); });
+
+    // IPv4 socket cannot send to an IPv6 address
+    sockaddr_in6 peer{};
+    peer.sin6_family = AF_INET6;
+    peer.sin6_addr = in6addr_loopback;
+    peer.sin6_port = htons(9);
+
+    int context = 0;
+    auto buffer = sender.SendBuffer();
+    REQUIRE_GE(buffer.size(), 100);
+    sender.QueueSend(100, 0, reinterpret_cast<const sockaddr*>(&peer), nullptr, 3, &context);
+    CHECK_EQ(sender.Flush(), 0);
+
+    CHECK_EQ(sender.GetStats().tx_errors, 1);
+    REQUIRE_EQ(errors.size(), 1);
+    CHECK_NE(errors[0].error, 0);
+    CHECK_EQ(errors[0].context, &context);
+    CHECK_EQ(errors[0].if_index, 3);
+    CHECK_EQ(errors[0].local_addr, nullptr);
+    CHECK_EQ(errors[0].peer_addr->sa_family, AF_INET6);
+}
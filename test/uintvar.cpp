@@ -4,6 +4,7 @@
 #include <doctest/doctest.h>
 
 #include "quicr/detail/uintvar.h"
+#include "quicr/detail/uintvar_batch.h"
 
 #include <limits>
 
@@ -84,3 +85,77 @@ TEST_CASE("UintVar Invalid Construction")
     CHECK_THROWS(quicr::UintVar(std::vector<uint8_t>{}));
     CHECK_THROWS(quicr::UintVar(std::vector<uint8_t>{ 0xFF, 0xFF }));
 }
+
+namespace var {
+    /// Values of all lengths with runs of single byte values, to exercise the SIMD paths of the batch kernels
+    static std::vector<uint64_t> BatchValues()
+    {
+        std::vector<uint64_t> values;
+        for (uint64_t i = 0; i < 200; ++i) {
+            values.push_back(i % 64);
+            if (i % 40 >= 32) {
+                values.push_back(kValue2Byte + i);
+                values.push_back(kValue4Byte + i);
+                values.push_back(kValue8Byte + i);
+                values.push_back(0x3FFF'FFFF'FFFF'FFFF - i);
+            }
+        }
+        return values;
+    }
+
+    constexpr quicr::UintVarKernel kKernels[] = { quicr::UintVarKernel::kScalar,
+                                                  quicr::UintVarKernel::kSse4,
+                                                  quicr::UintVarKernel::kAvx2,
+                                                  quicr::UintVarKernel::kNeon };
+}
+
+TEST_CASE("Batch Encode/Decode UintVars")
+{
+    const auto values = var::BatchValues();
+
+    std::vector<uint8_t> expected;
+    for (const auto value : values) {
+        const auto var_int = quicr::UintVar(value);
+        expected.insert(expected.end(), var_int.begin(), var_int.end());
+    }
+
+    for (const auto kernel : var::kKernels) {
+        if (!quicr::UintVarKernelSupported(kernel)) {
+            continue;
+        }
+        CAPTURE(static_cast<int>(kernel));
+
+        std::vector<uint8_t> encoded(values.size() * sizeof(uint64_t));
+        const auto written = quicr::EncodeUintVars(kernel, values, encoded);
+        encoded.resize(written);
+        CHECK_EQ(encoded, expected);
+
+        std::vector<uint64_t> decoded(values.size());
+        CHECK_EQ(quicr::DecodeUintVars(kernel, expected, decoded), expected.size());
+        CHECK_EQ(decoded, values);
+    }
+}
+
+TEST_CASE("Batch Decode UintVars truncated")
+{
+    const auto values = var::BatchValues();
+    std::vector<uint8_t> encoded(values.size() * sizeof(uint64_t));
+    encoded.resize(quicr::EncodeUintVars(values, encoded));
+
+    for (const auto kernel : var::kKernels) {
+        if (!quicr::UintVarKernelSupported(kernel)) {
+            continue;
+        }
+        CAPTURE(static_cast<int>(kernel));
+
+        std::vector<uint64_t> decoded(values.size());
+        CHECK_FALSE(quicr::DecodeUintVars(kernel, std::span{ encoded }.first(encoded.size() - 1), decoded));
+    }
+}
+
+TEST_CASE("Batch Encode UintVars Invalid")
+{
+    std::vector<uint8_t> encoded(32);
+    CHECK_THROWS(quicr::EncodeUintVars(std::vector<uint64_t>{ 1, std::numeric_limits<uint64_t>::max() }, encoded));
+    CHECK_THROWS(quicr::EncodeUintVars(std::vector<uint64_t>{ var::kValue8Byte }, std::span{ encoded }.first(7)));
+}